@@ -37,10 +37,13 @@ void CBackgroundInfoLoader::Run()
     {
       OnLoaderStart();
 
-      // Stage 1: All "fast" stuff we have already cached
-      for (std::vector<CFileItemPtr>::const_iterator iter = m_vecItems.begin(); iter != m_vecItems.end(); ++iter)
+      // All "fast" stuff we have already cached first, then all "slow" stuff that we need to
+      // lookup. Priority items go through both stages before any others.
+      size_t index;
+      bool lookup;
+      while (GetNextItem(index, lookup))
       {
-        const CFileItemPtr& pItem = *iter;
+        const CFileItemPtr& pItem = m_vecItems[index];
 
         // Ask the callback if we should abort
         if ((m_pProgressCallback && m_pProgressCallback->Abort()) || m_bStop)
@@ -48,35 +51,14 @@ void CBackgroundInfoLoader::Run()
 
         try
         {
-          if (LoadItemCached(pItem.get()) && m_pObserver)
+          const bool loaded = lookup ? LoadItemLookup(pItem.get()) : LoadItemCached(pItem.get());
+          if (loaded && m_pObserver)
             m_pObserver->OnItemLoaded(pItem.get());
         }
         catch (...)
         {
-          CLog::Log(LOGERROR,
-                    "CBackgroundInfoLoader::LoadItemCached - Unhandled exception for item {}",
-                    CURL::GetRedacted(pItem->GetPath()));
-        }
-      }
-
-      // Stage 2: All "slow" stuff that we need to lookup
-      for (std::vector<CFileItemPtr>::const_iterator iter = m_vecItems.begin(); iter != m_vecItems.end(); ++iter)
-      {
-        const CFileItemPtr& pItem = *iter;
-
-        // Ask the callback if we should abort
-        if ((m_pProgressCallback && m_pProgressCallback->Abort()) || m_bStop)
-          break;
-
-        try
-        {
-          if (LoadItemLookup(pItem.get()) && m_pObserver)
-            m_pObserver->OnItemLoaded(pItem.get());
-        }
-        catch (...)
-        {
-          CLog::Log(LOGERROR,
-                    "CBackgroundInfoLoader::LoadItemLookup - Unhandled exception for item {}",
+          CLog::Log(LOGERROR, "CBackgroundInfoLoader::{} - Unhandled exception for item {}",
+                    lookup ? "LoadItemLookup" : "LoadItemCached",
                     CURL::GetRedacted(pItem->GetPath()));
         }
       }
@@ -102,7 +84,14 @@ void CBackgroundInfoLoader::Load(CFileItemList& items)
   std::unique_lock<CCriticalSection> lock(m_lock);
 
   for (int nItem=0; nItem < items.Size(); nItem++)
+  {
     m_vecItems.push_back(items[nItem]);
+    m_itemIndex.emplace(items[nItem].get(), nItem);
+  }
+  m_loadedStages.assign(m_vecItems.size(), 0);
+  m_nextCached = 0;
+  m_nextLookup = 0;
+  UpdatePriorityItems();
 
   m_pVecItems = &items;
   m_bStop = false;
@@ -129,7 +118,12 @@ void CBackgroundInfoLoader::StopThread()
     delete m_thread;
     m_thread = NULL;
   }
+
+  std::unique_lock<CCriticalSection> lock(m_lock);
   m_vecItems.clear();
+  m_itemIndex.clear();
+  m_loadedStages.clear();
+  m_priorityItems.clear();
   m_pVecItems = NULL;
   m_bIsLoading = false;
 }
@@ -149,3 +143,80 @@ void CBackgroundInfoLoader::SetProgressCallback(IProgressCallback* pCallback)
   m_pProgressCallback = pCallback;
 }
 
+void CBackgroundInfoLoader::SetPriorityItems(const std::vector<CFileItemPtr>& items)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+
+  m_priorityHint.clear();
+  for (const auto& item : items)
+    m_priorityHint.push_back(item.get());
+
+  UpdatePriorityItems();
+}
+
+void CBackgroundInfoLoader::UpdatePriorityItems()
+{
+  m_priorityItems.clear();
+  m_nextPriorityCached = 0;
+  m_nextPriority = 0;
+
+  for (const CFileItem* item : m_priorityHint)
+  {
+    const auto it = m_itemIndex.find(item);
+    if (it != m_itemIndex.end() && m_loadedStages[it->second] < 2)
+      m_priorityItems.push_back(it->second);
+  }
+}
+
+bool CBackgroundInfoLoader::GetNextItem(size_t& index, bool& lookup)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+
+  // the cached stage of all priority items before their lookups, so that loaders can start the
+  // lookups of all the items shown at once
+  for (; m_nextPriorityCached < m_priorityItems.size(); m_nextPriorityCached++)
+  {
+    index = m_priorityItems[m_nextPriorityCached];
+    if (m_loadedStages[index] == 0)
+    {
+      m_loadedStages[index] = 1;
+      lookup = false;
+      return true;
+    }
+  }
+
+  for (; m_nextPriority < m_priorityItems.size(); m_nextPriority++)
+  {
+    index = m_priorityItems[m_nextPriority];
+    if (m_loadedStages[index] == 1)
+    {
+      m_loadedStages[index] = 2;
+      lookup = true;
+      return true;
+    }
+  }
+
+  for (; m_nextCached < m_loadedStages.size(); m_nextCached++)
+  {
+    if (m_loadedStages[m_nextCached] == 0)
+    {
+      index = m_nextCached;
+      m_loadedStages[index] = 1;
+      lookup = false;
+      return true;
+    }
+  }
+
+  for (; m_nextLookup < m_loadedStages.size(); m_nextLookup++)
+  {
+    if (m_loadedStages[m_nextLookup] == 1)
+    {
+      index = m_nextLookup;
+      m_loadedStages[index] = 2;
+      lookup = true;
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -13,6 +13,8 @@
 #include "threads/IRunnable.h"
 
 #include <memory>
+#include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 class CFileItem; typedef std::shared_ptr<CFileItem> CFileItemPtr;
@@ -44,6 +46,16 @@ public:
   void StopThread(); // will actually stop the loader thread.
   void StopAsync();  // will ask loader to stop as soon as possible, but not block
 
+  /*! \brief Load the given items before all others
+   Used to load the items shown in the GUI and the ones about to be shown first, instead of
+   working through the whole list in order. Replaces the items given before, those not loaded
+   yet go back to their place in the list. Also applies to lists loaded later on. The items go
+   through LoadItemCached() all together before LoadItemLookup(), so that lookups can be started
+   in parallel.
+   \param items the items to load first, in the order to load them
+   */
+  void SetPriorityItems(const std::vector<CFileItemPtr>& items);
+
 protected:
   virtual void OnLoaderStart() {}
   virtual void OnLoaderFinish() {}
@@ -58,5 +70,18 @@ protected:
 
   IBackgroundLoaderObserver* m_pObserver;
   IProgressCallback* m_pProgressCallback;
+
+private:
+  bool GetNextItem(size_t& index, bool& lookup);
+  void UpdatePriorityItems();
+
+  std::unordered_map<const CFileItem*, size_t> m_itemIndex;
+  std::vector<uint8_t> m_loadedStages; // number of stages handed out per item
+  size_t m_nextCached = 0;
+  size_t m_nextLookup = 0;
+  std::vector<const CFileItem*> m_priorityHint;
+  std::vector<size_t> m_priorityItems;
+  size_t m_nextPriorityCached = 0;
+  size_t m_nextPriority = 0;
 };
 
@@ -11,10 +11,12 @@
 #include "ServiceBroker.h"
 #include "TextureCache.h"
 #include "commons/ilog.h"
+#include "filesystem/File.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/Texture.h"
 #include "utils/JobManager.h"
 #include "utils/TimeUtils.h"
+#include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -42,7 +44,7 @@ bool CImageLoader::DoWork()
     return false;
 
   if (m_use_cache)
-    loadPath = CServiceBroker::GetTextureCache()->CheckCachedImage(texturePath, needsChecking);
+    loadPath = CServiceBroker::GetTextureCache()->CheckCachedImage(texturePath, needsChecking, true);
   else
     loadPath = texturePath;
 
@@ -54,6 +56,18 @@ bool CImageLoader::DoWork()
         CTexture::LoadFromFile(loadPath, CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth(),
                                CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight());
 
+    if (!m_texture && URIUtils::HasExtension(loadPath, ".dds"))
+    {
+      // broken .dds version, drop it and use the cached image it was created from
+      CLog::Log(LOGWARNING, "{} - failed loading {}, removing it", __FUNCTION__, loadPath);
+      XFILE::CFile::Delete(loadPath);
+      loadPath = CServiceBroker::GetTextureCache()->CheckCachedImage(texturePath, needsChecking);
+      if (!loadPath.empty())
+        m_texture = CTexture::LoadFromFile(loadPath,
+                                           CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth(),
+                                           CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight());
+    }
+
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
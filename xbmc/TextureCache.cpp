@@ -16,17 +16,21 @@
 #include "filesystem/IFileTypes.h"
 #include "guilib/Texture.h"
 #include "profiles/ProfileManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/Crc32.h"
 #include "utils/Job.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <mutex>
 #include <string.h>
+#include <unordered_set>
 
 using namespace XFILE;
 using namespace std::chrono_literals;
@@ -39,9 +43,18 @@ CTextureCache::~CTextureCache() = default;
 
 void CTextureCache::Initialize()
 {
-  std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  if (!m_database.IsOpen())
-    m_database.Open();
+  {
+    std::unique_lock<CCriticalSection> lock(m_databaseSection);
+    if (!m_database.IsOpen())
+      m_database.Open();
+  }
+
+  // until the index is loaded lookups go to the database
+  CServiceBroker::GetJobManager()->Submit([this]() { LoadIndex(); });
+
+  // work out the size of the cache, and reduce it if needed
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_thumbnailCacheSize > 0)
+    AddJob(new CTextureCacheMaintenanceJob());
 }
 
 void CTextureCache::Deinitialize()
@@ -50,6 +63,136 @@ void CTextureCache::Deinitialize()
 
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
   m_database.Close();
+  m_index.clear();
+  m_indexUrls.clear();
+  m_indexLoaded = false;
+  m_indexLoading = false;
+  m_indexChangedUrls.clear();
+  m_indexRemovedIds.clear();
+}
+
+void CTextureCache::LoadIndex(unsigned int pageSize /* = 1000 */)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_databaseSection);
+    if (m_indexLoaded || m_indexLoading || !m_database.IsOpen())
+      return;
+    m_indexLoading = true;
+  }
+
+  // read page by page so that lookups going to the database meanwhile aren't held up
+  std::unordered_map<std::string, CCachedTexture> index;
+  int lastId = 0;
+  while (true)
+  {
+    std::unique_lock<CCriticalSection> lock(m_databaseSection);
+    if (!m_indexLoading)
+      return; // deinitialized
+
+    const int id = m_database.GetCachedTextures(lastId, pageSize, index);
+    if (id < 0)
+    {
+      CLog::Log(LOGERROR, "CTextureCache::{} - failed to load the cached textures", __FUNCTION__);
+      m_indexLoading = false;
+      m_indexChangedUrls.clear();
+      m_indexRemovedIds.clear();
+      return;
+    }
+    if (id != lastId)
+    {
+      lastId = id;
+      continue;
+    }
+
+    m_index = std::move(index);
+    m_indexUrls.clear();
+    for (const auto& texture : m_index)
+      m_indexUrls[texture.second.details.id] = texture.first;
+    m_indexLoading = false;
+    m_indexLoaded = true;
+
+    // catch up with the changes made while the pages were read
+    RemoveFromIndex(m_indexRemovedIds);
+    UpdateIndex(m_indexChangedUrls);
+    m_indexRemovedIds.clear();
+    m_indexChangedUrls.clear();
+    break;
+  }
+
+  CLog::Log(LOGDEBUG, "CTextureCache::{} - loaded {} cached textures in {} ms", __FUNCTION__,
+            m_index.size(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+}
+
+void CTextureCache::UpdateIndex(const std::vector<std::string>& urls)
+{
+  if (m_indexLoading)
+  {
+    m_indexChangedUrls.insert(m_indexChangedUrls.end(), urls.begin(), urls.end());
+    return;
+  }
+
+  // an index that isn't loaded yet will pick up the change when it is
+  if (!m_indexLoaded || urls.empty())
+    return;
+
+  std::unordered_map<std::string, CCachedTexture> textures;
+  m_database.GetCachedTextures(urls, textures);
+
+  for (const std::string& url : urls)
+  {
+    auto texture = textures.find(url);
+    if (texture == textures.end())
+    {
+      RemoveFromIndex(url);
+      continue;
+    }
+
+    CCachedTexture& entry = m_index[url];
+    if (entry.details.id != texture->second.details.id)
+      m_indexUrls.erase(entry.details.id);
+    entry = std::move(texture->second);
+    m_indexUrls[entry.details.id] = url;
+  }
+}
+
+void CTextureCache::RemoveFromIndex(const std::string& url)
+{
+  if (m_indexLoading)
+  {
+    m_indexChangedUrls.emplace_back(url);
+    return;
+  }
+
+  const auto texture = m_index.find(url);
+  if (texture == m_index.end())
+    return;
+
+  m_indexUrls.erase(texture->second.details.id);
+  m_index.erase(texture);
+}
+
+void CTextureCache::RemoveFromIndex(const std::vector<int>& ids)
+{
+  if (m_indexLoading)
+  {
+    m_indexRemovedIds.insert(m_indexRemovedIds.end(), ids.begin(), ids.end());
+    return;
+  }
+
+  for (int id : ids)
+  {
+    const auto url = m_indexUrls.find(id);
+    if (url == m_indexUrls.end())
+      continue;
+
+    m_index.erase(url->second);
+    m_indexUrls.erase(url);
+  }
 }
 
 bool CTextureCache::IsCachedImage(const std::string &url) const
@@ -102,13 +245,29 @@ bool CTextureCache::CanCacheImageURL(const CURL &url)
          StringUtils::StartsWith(url.GetUserName(), "epg");
 }
 
-std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsRecaching)
+std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsRecaching, bool returnDDS /* = false */)
 {
   CTextureDetails details;
   std::string path(GetCachedImage(url, details, true));
   needsRecaching = !details.hash.empty();
+  if (path.empty())
+    m_misses++;
+  else if (details.id >= 0)
+    m_hits++;
+
   if (!path.empty())
+  {
+    // only images in our cache get a .dds version, others (eg skin images) may not be writable
+    if (returnDDS && !needsRecaching && details.id >= 0 &&
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_useDDSThumbnails)
+    {
+      std::string ddsPath = URIUtils::ReplaceExtension(path, ".dds");
+      if (CFile::Exists(ddsPath))
+        return ddsPath;
+      AddJob(new CTextureDDSJob(details.file));
+    }
     return path;
+  }
   return "";
 }
 
@@ -194,10 +353,20 @@ std::string CTextureCache::CacheImage(const std::string& image,
   return cachedpath;
 }
 
-bool CTextureCache::CacheImage(const std::string &image, CTextureDetails &details)
+bool CTextureCache::CacheImage(const std::string& image,
+                               CTextureDetails& details,
+                               const std::string& imageHash /* = "" */)
 {
   std::string path = GetCachedImage(image, details);
-  if (path.empty()) // not cached
+  if (!path.empty() && !imageHash.empty() && details.id >= 0 &&
+      GetCachedImageHash(CTextureUtils::UnwrapImageURL(image)) != imageHash)
+  {
+    CLog::Log(LOGDEBUG, "CTextureCache::{} - image '{}' changed, recaching", __FUNCTION__,
+              CURL::GetRedacted(image));
+    path.clear();
+  }
+
+  if (path.empty()) // not cached or out of date
     path = CacheImage(image, NULL, &details);
 
   return !path.empty();
@@ -206,10 +375,17 @@ bool CTextureCache::CacheImage(const std::string &image, CTextureDetails &detail
 void CTextureCache::ClearCachedImage(const std::string &url, bool deleteSource /*= false */)
 {
   //! @todo This can be removed when the texture cache covers everything.
-  std::string path = deleteSource ? url : "";
   std::string cachedFile;
   if (ClearCachedTexture(url, cachedFile))
-    path = GetCachedPath(cachedFile);
+  {
+    DeleteCachedFiles(cachedFile);
+    return;
+  }
+
+  if (!deleteSource)
+    return;
+
+  std::string path = url;
   if (CFile::Exists(path))
     CFile::Delete(path);
   path = URIUtils::ReplaceExtension(path, ".dds");
@@ -222,27 +398,185 @@ bool CTextureCache::ClearCachedImage(int id)
   std::string cachedFile;
   if (ClearCachedTexture(id, cachedFile))
   {
-    cachedFile = GetCachedPath(cachedFile);
-    if (CFile::Exists(cachedFile))
-      CFile::Delete(cachedFile);
-    cachedFile = URIUtils::ReplaceExtension(cachedFile, ".dds");
-    if (CFile::Exists(cachedFile))
-      CFile::Delete(cachedFile);
+    DeleteCachedFiles(cachedFile);
     return true;
   }
   return false;
 }
 
+void CTextureCache::DeleteCachedFiles(const std::string& file, int64_t size /* = -1 */)
+{
+  m_cacheSize -= size >= 0 ? size : static_cast<int64_t>(GetCachedImageSize(file));
+
+  std::string path = GetCachedPath(file);
+  if (CFile::Exists(path))
+    CFile::Delete(path);
+  path = URIUtils::ReplaceExtension(path, ".dds");
+  if (CFile::Exists(path))
+    CFile::Delete(path);
+}
+
+void CTextureCache::EvictCachedImages(const std::vector<CTextureUsage> &textures)
+{
+  if (textures.empty())
+    return;
+
+  std::unordered_set<int> ids;
+  for (const CTextureUsage& texture : textures)
+    ids.insert(texture.id);
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_databaseSection);
+    const std::vector<int> evicted(ids.begin(), ids.end());
+    if (!m_database.ClearCachedTextures(evicted))
+      return;
+
+    RemoveFromIndex(evicted);
+  }
+
+  for (const CTextureUsage& texture : textures)
+    DeleteCachedFiles(texture.file, texture.size);
+
+  m_evicted += textures.size();
+}
+
+bool CTextureCache::GetTextureUsage(std::vector<CTextureUsage> &textures)
+{
+  std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  return m_database.GetTextureUsage(textures);
+}
+
+void CTextureCache::SetCachedImageSizes(const std::vector<CTextureUsage>& textures)
+{
+  std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  m_database.SetCachedTextureSizes(textures);
+}
+
+void CTextureCache::CheckCacheSize()
+{
+  const uint64_t maxSize =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_thumbnailCacheSize;
+  // no need to check for a job being queued already, AddJob ignores duplicates
+  if (maxSize > 0 && m_cacheSize > static_cast<int64_t>(maxSize * 1024 * 1024))
+    AddJob(new CTextureCacheMaintenanceJob());
+}
+
+CTextureCache::Statistics CTextureCache::GetStatistics()
+{
+  Statistics statistics;
+  statistics.size = std::max<int64_t>(m_cacheSize, 0);
+  statistics.maxSize = static_cast<uint64_t>(CServiceBroker::GetSettingsComponent()
+                                                 ->GetAdvancedSettings()
+                                                 ->m_thumbnailCacheSize) *
+                       1024 * 1024;
+  statistics.hits = m_hits;
+  statistics.misses = m_misses;
+  statistics.evicted = m_evicted;
+
+  std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  statistics.textures = m_index.size();
+  // without a limit the maintenance job doesn't work the size out
+  if (statistics.maxSize == 0)
+    statistics.size = std::max<int64_t>(m_database.GetCachedTexturesSize(), 0);
+  return statistics;
+}
+
+uint64_t CTextureCache::GetCachedImageSize(const std::string &file)
+{
+  return GetCachedFileSize(file) + GetCachedFileSize(URIUtils::ReplaceExtension(file, ".dds"));
+}
+
+uint64_t CTextureCache::GetCachedFileSize(const std::string& file)
+{
+  struct __stat64 st;
+  if (CFile::Stat(GetCachedPath(file), &st) == 0)
+    return st.st_size;
+
+  return 0;
+}
+
 bool CTextureCache::GetCachedTexture(const std::string &url, CTextureDetails &details)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.GetCachedTexture(url, details);
+  if (!m_indexLoaded)
+    return m_database.GetCachedTexture(url, details);
+
+  auto texture = m_index.find(url);
+  if (texture == m_index.end())
+    return false;
+
+  details = texture->second.GetDetails();
+  return true;
+}
+
+std::string CTextureCache::GetCachedImageHash(const std::string& url)
+{
+  std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  if (m_indexLoaded)
+  {
+    const auto texture = m_index.find(url);
+    return texture != m_index.end() ? texture->second.imageHash : "";
+  }
+
+  std::unordered_map<std::string, CCachedTexture> textures;
+  m_database.GetCachedTextures({url}, textures);
+  const auto texture = textures.find(url);
+  return texture != textures.end() ? texture->second.imageHash : "";
+}
+
+bool CTextureCache::AddCachedTexture(const std::string& url,
+                                     const CTextureDetails& details,
+                                     uint64_t replacedSize /* = 0 */)
+{
+  // a .dds version of a previously cached image is out of date now
+  std::string ddsPath = URIUtils::ReplaceExtension(GetCachedPath(details.file), ".dds");
+  struct __stat64 st;
+  if (CFile::Stat(ddsPath, &st) == 0)
+  {
+    m_cacheSize -= st.st_size;
+    CFile::Delete(ddsPath);
+  }
+
+  const uint64_t size = GetCachedFileSize(details.file);
+  bool result;
+  {
+    std::unique_lock<CCriticalSection> lock(m_databaseSection);
+    result = m_database.AddCachedTexture(url, details, size);
+    UpdateIndex({url});
+  }
+
+  if (result)
+  {
+    m_cacheSize += static_cast<int64_t>(size) - static_cast<int64_t>(replacedSize);
+    CheckCacheSize();
+  }
+  return result;
+}
+
+void CTextureCache::InvalidateCachedImage(const std::string& image)
+{
+  InvalidateCachedImages({image});
 }
 
-bool CTextureCache::AddCachedTexture(const std::string &url, const CTextureDetails &details)
+void CTextureCache::InvalidateCachedImages(const std::vector<std::string>& images)
 {
+  std::vector<std::string> urls;
+  urls.reserve(images.size());
+  for (const std::string& image : images)
+  {
+    std::string url = CTextureUtils::UnwrapImageURL(image);
+    if (!url.empty())
+      urls.emplace_back(std::move(url));
+  }
+  if (urls.empty())
+    return;
+
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.AddCachedTexture(url, details);
+  m_database.BeginMultipleExecute();
+  for (const std::string& url : urls)
+    m_database.InvalidateCachedTexture(url);
+  m_database.CommitMultipleExecute();
+  UpdateIndex(urls);
 }
 
 void CTextureCache::IncrementUseCount(const CTextureDetails &details)
@@ -261,18 +595,22 @@ void CTextureCache::IncrementUseCount(const CTextureDetails &details)
 bool CTextureCache::SetCachedTextureValid(const std::string &url, bool updateable)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
-  return m_database.SetCachedTextureValid(url, updateable);
+  bool result = m_database.SetCachedTextureValid(url, updateable);
+  UpdateIndex({url});
+  return result;
 }
 
 bool CTextureCache::ClearCachedTexture(const std::string &url, std::string &cachedURL)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  RemoveFromIndex(url);
   return m_database.ClearCachedTexture(url, cachedURL);
 }
 
 bool CTextureCache::ClearCachedTexture(int id, std::string &cachedURL)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  RemoveFromIndex(std::vector<int>{id});
   return m_database.ClearCachedTexture(id, cachedURL);
 }
 
@@ -298,7 +636,7 @@ void CTextureCache::OnCachingComplete(bool success, CTextureCacheJob *job)
     if (job->m_oldHash == job->m_details.hash)
       SetCachedTextureValid(job->m_url, job->m_details.updateable);
     else
-      AddCachedTexture(job->m_url, job->m_details);
+      AddCachedTexture(job->m_url, job->m_details, job->m_replacedSize);
   }
 
   { // remove from our processing list
@@ -315,6 +653,18 @@ void CTextureCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
 {
   if (strcmp(job->GetType(), kJobTypeCacheImage) == 0)
     OnCachingComplete(success, static_cast<CTextureCacheJob*>(job));
+  else if (strcmp(job->GetType(), kJobTypeDDSCompress) == 0 && success)
+  {
+    const CTextureDDSJob* ddsJob = static_cast<CTextureDDSJob*>(job);
+    struct __stat64 st;
+    if (CFile::Stat(URIUtils::ReplaceExtension(ddsJob->m_original, ".dds"), &st) == 0)
+    {
+      m_cacheSize += st.st_size;
+      std::unique_lock<CCriticalSection> lock(m_databaseSection);
+      m_database.AddCachedTextureSize(ddsJob->m_file, st.st_size);
+    }
+    CheckCacheSize();
+  }
   return CJobQueue::OnJobComplete(jobID, success, job);
 }
 
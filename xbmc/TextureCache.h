@@ -14,9 +14,11 @@
 #include "threads/Event.h"
 #include "utils/JobManager.h"
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class CJob;
@@ -35,7 +37,22 @@ class CTexture;
  */
 class CTextureCache : public CJobQueue
 {
+  friend class CTextureCacheMaintenanceJob;
+  friend class TestTextureCacheHelper;
+
 public:
+  /*! \brief Statistics of the texture cache
+   */
+  struct Statistics
+  {
+    uint64_t size = 0; ///< bytes used by the cached images
+    uint64_t maxSize = 0; ///< configured limit of size, 0 if unlimited
+    uint64_t textures = 0; ///< number of cached images
+    uint64_t hits = 0; ///< loads of images that were cached
+    uint64_t misses = 0; ///< loads of images that weren't cached yet
+    uint64_t evicted = 0; ///< cached images removed to stay within maxSize
+  };
+
   CTextureCache();
   ~CTextureCache() override;
 
@@ -54,10 +71,12 @@ public:
 
    \param image url of the image to check
    \param needsRecaching [out] whether the image needs recaching.
+   \param returnDDS whether to return the .dds version of the image if there is one. If enabled in
+   advancedsettings, a missing .dds version is created in the background.
    \return cached url of this image
    \sa GetCachedImage
    */
-  std::string CheckCachedImage(const std::string &image, bool &needsRecaching);
+  std::string CheckCachedImage(const std::string &image, bool &needsRecaching, bool returnDDS = false);
 
   /*! \brief Cache image (if required) using a background job
 
@@ -98,10 +117,27 @@ public:
   /*! \brief Cache an image to image cache if not already cached, returning the image details.
    \param image url of the image to cache.
    \param details [out] the image details.
+   \param imageHash the current hash of the original image, see CTextureCacheJob::GetImageHash.
+   If given, a cached image with a different hash is recached.
    \return true if the image is in the cache, false otherwise.
    \sa CTextureCacheJob::CacheTexture
    */
-  bool CacheImage(const std::string &image, CTextureDetails &details);
+  bool CacheImage(const std::string& image,
+                  CTextureDetails& details,
+                  const std::string& imageHash = "");
+
+  /*! \brief Invalidate a cached image so that it is checked for updates the next time it is loaded
+   Thread-safe wrapper of CTextureDatabase::InvalidateCachedTexture
+   \param image url of the original image
+   */
+  void InvalidateCachedImage(const std::string& image);
+
+  /*! \brief Invalidate several cached images at once
+   Updates the database in a single transaction and the in-memory index in a single lookup.
+   \param images urls of the original images
+   \sa InvalidateCachedImage
+   */
+  void InvalidateCachedImages(const std::vector<std::string>& images);
 
   /*! \brief Check whether an image is in the cache
    Note: If the image url won't normally be cached (eg a skin image) this function will return false.
@@ -146,9 +182,13 @@ public:
    Thread-safe wrapper of CTextureDatabase::AddCachedTexture
    \param image url of the original image
    \param details the texture details to add
+   \param replacedSize size of the cached file that was overwritten by this one, see
+   GetCachedFileSize
    \return true if we successfully added to the database, false otherwise.
    */
-  bool AddCachedTexture(const std::string &image, const CTextureDetails &details);
+  bool AddCachedTexture(const std::string& image,
+                        const CTextureDetails& details,
+                        uint64_t replacedSize = 0);
 
   /*! \brief Export a (possibly) cached image to a file
    \param image url of the original image
@@ -158,6 +198,27 @@ public:
    */
   bool Export(const std::string &image, const std::string &destination, bool overwrite);
   bool Export(const std::string &image, const std::string &destination); //! @todo BACKWARD COMPATIBILITY FOR MUSIC THUMBS
+
+  /*! \brief Get the statistics of the texture cache
+   With a size limit the size is worked out by CTextureCacheMaintenanceJob on startup and kept up
+   to date afterwards. Without one it is looked up in the database, leaving out images cached
+   before the sizes were stored.
+   \return the current statistics
+   */
+  Statistics GetStatistics();
+
+  /*! \brief Get the size of a cached image on disk, including its .dds version
+   \param file the cached file, relative to the cache path
+   \return the size in bytes, 0 if the file doesn't exist
+   */
+  static uint64_t GetCachedImageSize(const std::string &file);
+
+  /*! \brief Get the size of a cached file on disk, without its .dds version
+   \param file the cached file, relative to the cache path
+   \return the size in bytes, 0 if the file doesn't exist
+   */
+  static uint64_t GetCachedFileSize(const std::string& file);
+
 private:
   // private construction, and no assignments; use the provided singleton methods
   CTextureCache(const CTextureCache&) = delete;
@@ -186,6 +247,12 @@ private:
    */
   bool GetCachedTexture(const std::string &url, CTextureDetails &details);
 
+  /*! \brief Get the hash the original image had when it was cached
+   \param url url of the original image
+   \return the hash of the image, empty if it isn't cached
+   */
+  std::string GetCachedImageHash(const std::string& url);
+
   /*! \brief Clear an image from the database
    Thread-safe wrapper of CTextureDatabase::ClearCachedTexture
    \param image url of the original image
@@ -219,12 +286,68 @@ private:
    */
   void OnCachingComplete(bool success, CTextureCacheJob *job);
 
+  /*! \brief Load all cached textures from the database into the in-memory index
+   Afterwards lookups of cached images no longer touch the database. The database is only locked
+   while a page of textures is read, changes made in between are applied once all are read.
+   \param pageSize number of textures to read at once
+   */
+  void LoadIndex(unsigned int pageSize = 1000);
+
+  /*! \brief Update the in-memory index entries of the given images from the database
+   Must be called with m_databaseSection held.
+   \param urls urls of the original images
+   */
+  void UpdateIndex(const std::vector<std::string>& urls);
+
+  /*! \brief Remove images from the in-memory index
+   Must be called with m_databaseSection held.
+   \param url url of the original image
+   */
+  void RemoveFromIndex(const std::string& url);
+  void RemoveFromIndex(const std::vector<int>& textureIDs);
+
+  /*! \brief Delete a cached file and its .dds version, keeping track of the cache size
+   \param file the cached file, relative to the cache path
+   \param size bytes used by the files, worked out from the files if negative
+   */
+  void DeleteCachedFiles(const std::string& file, int64_t size = -1);
+
+  /*! \brief Get the usage of all cached images
+   Thread-safe wrapper of CTextureDatabase::GetTextureUsage
+   */
+  bool GetTextureUsage(std::vector<CTextureUsage> &textures);
+
+  /*! \brief Store the sizes of cached images worked out from their files
+   Thread-safe wrapper of CTextureDatabase::SetCachedTextureSizes
+   */
+  void SetCachedImageSizes(const std::vector<CTextureUsage>& textures);
+
+  /*! \brief Remove the given images from the cache to free up space
+   \param textures the cached images to remove
+   */
+  void EvictCachedImages(const std::vector<CTextureUsage> &textures);
+
+  /*! \brief Queue a CTextureCacheMaintenanceJob if the cache exceeds its size limit
+   */
+  void CheckCacheSize();
+
   CCriticalSection m_databaseSection;
   CTextureDatabase m_database;
+  std::unordered_map<std::string, CCachedTexture> m_index; ///< cached textures by url, guarded by m_databaseSection
+  std::unordered_map<int, std::string> m_indexUrls; ///< urls of the textures in m_index by id
+  bool m_indexLoaded = false; ///< whether m_index contains all cached textures
+  bool m_indexLoading = false; ///< whether LoadIndex is reading the textures
+  std::vector<std::string> m_indexChangedUrls; ///< images changed while loading the index
+  std::vector<int> m_indexRemovedIds; ///< textures removed while loading the index
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
   CCriticalSection     m_processingSection;
   CEvent               m_completeEvent; ///< Set whenever a job has finished
   std::vector<CTextureDetails> m_useCounts; ///< Use count tracking
   CCriticalSection             m_useCountSection;
+
+  std::atomic<int64_t> m_cacheSize{0}; ///< bytes used by the cached images
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_evicted{0};
 };
 
@@ -16,6 +16,7 @@
 #include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/audiodecoder.h"
 #include "commons/ilog.h"
 #include "filesystem/File.h"
+#include "guilib/DDSImage.h"
 #include "guilib/Texture.h"
 #include "imagefiles/SpecialImageLoaderFactory.h"
 #include "pictures/Picture.h"
@@ -25,9 +26,12 @@
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <exception>
+#include <limits>
 #include <utility>
 
 #include "PlatformDefs.h"
@@ -85,7 +89,17 @@ bool CTextureCacheJob::CacheTexture(std::unique_ptr<CTexture>* out_texture)
   else if (m_details.hash == m_oldHash)
     return true;
 
-  std::unique_ptr<CTexture> texture = LoadImage(image, width, height, additional_info, true);
+  // cached images are never larger than the image or fanart resolution, so there's no need to
+  // load them any larger. This allows decoders to scale large images down while decoding.
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const unsigned int maxHeight = std::max(advancedSettings->m_imageRes, advancedSettings->m_fanartRes);
+  const unsigned int maxWidth = maxHeight * 16 / 9;
+  const unsigned int loadWidth = width ? std::min(width, maxWidth) : maxWidth;
+  const unsigned int loadHeight = height ? std::min(height, maxHeight) : maxHeight;
+
+  std::unique_ptr<CTexture> texture =
+      LoadImage(image, loadWidth, loadHeight, additional_info, true);
   if (texture)
   {
     if (texture->HasAlpha())
@@ -96,6 +110,8 @@ bool CTextureCacheJob::CacheTexture(std::unique_ptr<CTexture>* out_texture)
     CLog::Log(LOGDEBUG, "{} image '{}' to '{}':", m_oldHash.empty() ? "Caching" : "Recaching",
               CURL::GetRedacted(image), m_details.file);
 
+    m_replacedSize = CTextureCache::GetCachedFileSize(m_details.file);
+
     if (CPicture::CacheTexture(texture.get(), width, height,
                                CTextureCache::GetCachedPath(m_details.file), scalingAlgorithm))
     {
@@ -230,30 +246,197 @@ bool CTextureCacheJob::UpdateableURL(const std::string &url) const
 
 std::string CTextureCacheJob::GetImageHash(const std::string &url)
 {
-  // silently ignore - we cannot stat these
-  // in the case of upnp thumbs are/should be provided when filling the directory list, there's no reason to stat all object ids
-  if (URIUtils::IsProtocol(url, "addons") || URIUtils::IsProtocol(url, "plugin") ||
-      URIUtils::IsProtocol(url, "upnp"))
+  if (!CanHashImage(url))
     return "";
 
   struct __stat64 st;
   if (XFILE::CFile::Stat(url, &st) == 0)
-  {
-    int64_t time = st.st_mtime;
-    if (!time)
-      time = st.st_ctime;
-    if (time || st.st_size)
-      return StringUtils::Format("d{}s{}", time, st.st_size);
-
-    // the image exists but we couldn't determine the mtime/ctime and/or size
-    // so set an obviously bad hash
-    return "BADHASH";
-  }
+    return GetImageHash(url, st);
 
   CLog::Log(LOGDEBUG, "{} - unable to stat url {}", __FUNCTION__, CURL::GetRedacted(url));
   return "";
 }
 
+std::string CTextureCacheJob::GetImageHash(const std::string& url, const struct __stat64& st)
+{
+  if (!CanHashImage(url))
+    return "";
+
+  int64_t time = st.st_mtime;
+  if (!time)
+    time = st.st_ctime;
+  if (time || st.st_size)
+    return StringUtils::Format("d{}s{}", time, st.st_size);
+
+  // the image exists but we couldn't determine the mtime/ctime and/or size
+  // so set an obviously bad hash
+  return "BADHASH";
+}
+
+bool CTextureCacheJob::CanHashImage(const std::string& url)
+{
+  // silently ignore - we cannot stat these
+  // in the case of upnp thumbs are/should be provided when filling the directory list, there's no reason to stat all object ids
+  return !URIUtils::IsProtocol(url, "addons") && !URIUtils::IsProtocol(url, "plugin") &&
+         !URIUtils::IsProtocol(url, "upnp");
+}
+
+CTextureDDSJob::CTextureDDSJob(const std::string& file)
+  : m_file(file), m_original(CTextureCache::GetCachedPath(file))
+{
+}
+
+bool CTextureDDSJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(),GetType()) == 0)
+  {
+    const CTextureDDSJob* ddsJob = dynamic_cast<const CTextureDDSJob*>(job);
+    if (ddsJob && ddsJob->m_original == m_original)
+      return true;
+  }
+  return false;
+}
+
+bool CTextureDDSJob::DoWork()
+{
+  if (URIUtils::HasExtension(m_original, ".dds"))
+    return false;
+
+  std::unique_ptr<CTexture> texture = CTexture::LoadFromFile(m_original, 0, 0, true);
+  if (!texture || !texture->GetPixels())
+    return false;
+
+  // the .dds version has no room for the orientation
+  if (texture->GetOrientation())
+    return false;
+
+  // write to a temporary file first so that loaders never see a partial image
+  const std::string ddsFile = URIUtils::ReplaceExtension(m_original, ".dds");
+  const std::string tempFile = ddsFile + ".tmp";
+  CDDSImage dds;
+  if (!dds.Create(tempFile, texture->GetWidth(), texture->GetHeight(), texture->GetPitch(),
+                  texture->GetPixels(), texture->HasAlpha()))
+  {
+    CLog::Log(LOGERROR, "{} - failed to create {}", __FUNCTION__, ddsFile);
+    XFILE::CFile::Delete(tempFile);
+    return false;
+  }
+
+  return XFILE::CFile::Rename(tempFile, ddsFile);
+}
+
+bool CTextureCacheMaintenanceJob::operator==(const CJob* job) const
+{
+  return strcmp(job->GetType(), GetType()) == 0;
+}
+
+bool CTextureCacheMaintenanceJob::DoWork()
+{
+  // remove images in batches, so that the cache is never locked for long
+  constexpr size_t BATCH_SIZE = 100;
+
+  CTextureCache& textureCache = *CServiceBroker::GetTextureCache();
+  const uint64_t maxSize = static_cast<uint64_t>(CServiceBroker::GetSettingsComponent()
+                                                     ->GetAdvancedSettings()
+                                                     ->m_thumbnailCacheSize) *
+                           1024 * 1024;
+
+  std::vector<CTextureUsage> textures;
+  if (!textureCache.GetTextureUsage(textures))
+    return false;
+
+  std::vector<uint64_t> sizes(textures.size());
+  std::vector<CTextureUsage> measured;
+  int64_t total = 0;
+  for (size_t i = 0; i < textures.size(); ++i)
+  {
+    CTextureUsage& texture = textures[i];
+    if (texture.size < 0)
+    {
+      // cached before the sizes were stored
+      if (measured.size() % BATCH_SIZE == 0 && ShouldCancel(i, textures.size()))
+        return false;
+      texture.size = CTextureCache::GetCachedImageSize(texture.file);
+      measured.push_back(texture);
+    }
+    sizes[i] = texture.size;
+    total += texture.size;
+  }
+  textureCache.SetCachedImageSizes(measured);
+  textureCache.m_cacheSize = total;
+
+  CLog::Log(LOGDEBUG, "{} - {} cached images use {} MiB", __FUNCTION__, textures.size(),
+            total / (1024 * 1024));
+
+  if (maxSize == 0 || total <= static_cast<int64_t>(maxSize))
+    return true;
+
+  const int64_t start = total;
+  size_t evicted = 0;
+  std::vector<CTextureUsage> batch;
+  for (size_t index : SelectEvictions(textures, sizes, maxSize, CDateTime::GetUTCDateTime()))
+  {
+    batch.push_back(textures[index]);
+    total -= sizes[index];
+    if (batch.size() == BATCH_SIZE)
+    {
+      if (ShouldCancel(evicted, textures.size()))
+        return false;
+      textureCache.EvictCachedImages(batch);
+      evicted += batch.size();
+      batch.clear();
+    }
+  }
+  textureCache.EvictCachedImages(batch);
+  evicted += batch.size();
+
+  CLog::Log(LOGINFO, "{} - removed {} cached images ({} MiB) to stay within {} MiB", __FUNCTION__,
+            evicted, (start - total) / (1024 * 1024), maxSize / (1024 * 1024));
+  return true;
+}
+
+std::vector<size_t> CTextureCacheMaintenanceJob::SelectEvictions(
+    const std::vector<CTextureUsage>& textures,
+    const std::vector<uint64_t>& sizes,
+    uint64_t maxSize,
+    const CDateTime& now)
+{
+  uint64_t total = 0;
+  for (uint64_t size : sizes)
+    total += size;
+
+  std::vector<size_t> result;
+  if (maxSize == 0 || total <= maxSize)
+    return result;
+
+  // score the images by the seconds since their last use, weighted down by the use count
+  std::vector<std::pair<double, size_t>> scores;
+  scores.reserve(textures.size());
+  for (size_t i = 0; i < textures.size(); ++i)
+  {
+    const CTextureUsage& texture = textures[i];
+    double age = std::numeric_limits<double>::max();
+    if (texture.lastUsed.IsValid())
+      age = std::max((now - texture.lastUsed).GetSecondsTotal(), 0);
+    scores.emplace_back(age / std::log2(2.0 + texture.useCount), i);
+  }
+  std::stable_sort(scores.begin(), scores.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  // go somewhat below the limit so that this doesn't run again right after
+  const uint64_t target = maxSize / 10 * 9;
+  for (const auto& score : scores)
+  {
+    if (total <= target)
+      break;
+
+    result.push_back(score.second);
+    total -= sizes[score.second];
+  }
+
+  return result;
+}
+
 CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
 {
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "PlatformDefs.h" // for __stat64
 #include "pictures/PictureScalingAlgorithm.h"
 #include "utils/Job.h"
 
@@ -17,7 +18,11 @@
 #include <string>
 #include <vector>
 
+#include <sys/stat.h>
+
+class CDateTime;
 class CTexture;
+class CTextureUsage;
 
 /*!
  \ingroup textures
@@ -71,10 +76,6 @@ public:
 
   static bool ResizeTexture(const std::string &url, uint8_t* &result, size_t &result_size);
 
-  std::string m_url;
-  std::string m_oldHash;
-  CTextureDetails m_details;
-private:
   /*! \brief retrieve a hash for the given image
    Combines the size, ctime and mtime of the image file into a "unique" hash
    \param url location of the image
@@ -82,6 +83,19 @@ private:
    */
   static std::string GetImageHash(const std::string &url);
 
+  /*! \brief retrieve the hash of an image that has already been stat'ed
+   \param url location of the image
+   \param st the stat result of the image
+   \return a hash string for this image
+   \sa GetImageHash(const std::string&)
+   */
+  static std::string GetImageHash(const std::string& url, const struct __stat64& st);
+
+  std::string m_url;
+  std::string m_oldHash;
+  CTextureDetails m_details;
+  uint64_t m_replacedSize = 0; ///< size of the previously cached file overwritten by this job
+private:
   /*! \brief Check whether a given URL represents an image that can be updated
    We currently don't check http:// and https:// URLs for updates, under the assumption that
    a image URL is much more likely to be static and the actual image at the URL is unlikely
@@ -91,6 +105,12 @@ private:
    */
   bool UpdateableURL(const std::string &url) const;
 
+  /*! \brief Check whether the hash of an image can be determined from a stat of its URL
+   \param url the url to check
+   \return false for URLs that can't be stat'ed, true otherwise
+   */
+  static bool CanHashImage(const std::string& url);
+
   /*! \brief Decode an image URL to the underlying image, width, height and orientation
    \param url wrapped URL of the image
    \param width width derived from URL
@@ -121,6 +141,53 @@ private:
   std::string    m_cachePath;
 };
 
+/* \brief Job class for creating .dds versions of cached textures
+
+ The .dds version holds the decoded pixels of the cached image, so it can be
+ loaded without decoding the JPEG or PNG again.
+ */
+class CTextureDDSJob : public CJob
+{
+public:
+  /*! \param file the cached file, relative to the thumbnails folder */
+  explicit CTextureDDSJob(const std::string& file);
+
+  const char* GetType() const override { return kJobTypeDDSCompress; }
+  bool operator==(const CJob *job) const override;
+  bool DoWork() override;
+
+  std::string m_file;
+  std::string m_original; ///< full path of m_file
+};
+
+/* \brief Job class for keeping the texture cache within its size limit
+
+ Works out the size of the cache from the sizes stored in the texture database, statting only
+ the files of textures cached before the sizes were stored. If it exceeds the limit set in
+ advancedsettings, removes
+ cached images until it's somewhat below again. Images that haven't been used for the longest
+ time go first, with the time weighted by how often they have been used.
+ */
+class CTextureCacheMaintenanceJob : public CJob
+{
+public:
+  const char* GetType() const override { return "texturecachemaintenance"; }
+  bool operator==(const CJob *job) const override;
+  bool DoWork() override;
+
+  /*! \brief Select the cached images to remove to get the cache below 90% of its size limit
+   \param textures the usage of the cached images
+   \param sizes the size of each of the cached images
+   \param maxSize the size limit of the cache in bytes
+   \param now the current time in UTC
+   \return indexes of the images to remove, in the order they should be removed
+   */
+  static std::vector<size_t> SelectEvictions(const std::vector<CTextureUsage>& textures,
+                                             const std::vector<uint64_t>& sizes,
+                                             uint64_t maxSize,
+                                             const CDateTime& now);
+};
+
 /* \brief Job class for storing the use count of textures
  */
 class CTextureUseCountJob : public CJob
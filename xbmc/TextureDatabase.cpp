@@ -16,6 +16,9 @@
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <inttypes.h>
+
 enum TextureField
 {
   TF_None = 0,
@@ -151,7 +154,7 @@ bool CTextureDatabase::Open()
 void CTextureDatabase::CreateTables()
 {
   CLog::Log(LOGINFO, "create texture table");
-  m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
+  m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text, filesize integer)");
 
   CLog::Log(LOGINFO, "create sizes table, index,  and trigger");
   m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
@@ -226,6 +229,10 @@ void CTextureDatabase::UpdateTables(int version)
     m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
     m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
   }
+  if (version < 14)
+  { // size of the cached files, worked out by the cache maintenance for existing textures
+    m_pDS->exec("ALTER TABLE texture ADD filesize integer");
+  }
 }
 
 bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
@@ -234,8 +241,32 @@ bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
   return ExecuteQuery(sql);
 }
 
+CTextureDetails CCachedTexture::GetDetails() const
+{
+  CTextureDetails result = details;
+  if (lastHashCheck.IsValid() &&
+      lastHashCheck + CDateTimeSpan(1, 0, 0, 0) < CDateTime::GetCurrentDateTime())
+    result.hash = imageHash;
+
+  return result;
+}
+
 bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails &details)
 {
+  std::unordered_map<std::string, CCachedTexture> textures;
+  if (!GetCachedTextures({url}, textures) || textures.empty())
+    return false;
+
+  details = textures.begin()->second.GetDetails();
+  return true;
+}
+
+bool CTextureDatabase::GetCachedTextures(const std::vector<std::string>& urls,
+                                         std::unordered_map<std::string, CCachedTexture>& textures)
+{
+  // look up the urls in chunks to stay well below the maximum length of a statement
+  static constexpr size_t CHUNK_SIZE = 500;
+
   try
   {
     if (!m_pDB)
@@ -243,30 +274,87 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
     if (!m_pDS)
       return false;
 
-    std::string sql = PrepareSQL("SELECT id, cachedurl, lasthashcheck, imagehash, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE url='%s'", url.c_str());
-    m_pDS->query(sql);
-    if (!m_pDS->eof())
-    { // have some information
-      details.id = m_pDS->fv(0).get_asInt();
-      details.file  = m_pDS->fv(1).get_asString();
-      CDateTime lastCheck;
-      lastCheck.SetFromDBDateTime(m_pDS->fv(2).get_asString());
-      if (lastCheck.IsValid() && lastCheck + CDateTimeSpan(1,0,0,0) < CDateTime::GetCurrentDateTime())
-        details.hash = m_pDS->fv(3).get_asString();
-      details.width = m_pDS->fv(4).get_asInt();
-      details.height = m_pDS->fv(5).get_asInt();
+    size_t start = 0;
+    do
+    {
+      std::string sql = "SELECT url, id, cachedurl, lasthashcheck, imagehash, width, height FROM "
+                        "texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1)";
+      if (!urls.empty())
+      {
+        std::vector<std::string> values;
+        const size_t end = std::min(start + CHUNK_SIZE, urls.size());
+        values.reserve(end - start);
+        for (size_t i = start; i < end; ++i)
+          values.emplace_back(PrepareSQL("'%s'", urls[i].c_str()));
+
+        sql += " WHERE url IN (" + StringUtils::Join(values, ",") + ")";
+      }
+      start += CHUNK_SIZE;
+
+      if (!m_pDS->query(sql))
+        return false;
+
+      ReadCachedTextures(textures);
       m_pDS->close();
-      return true;
-    }
-    m_pDS->close();
+    } while (start < urls.size());
+
+    return true;
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "{}, failed on url '{}'", __FUNCTION__, url);
+    CLog::Log(LOGERROR, "{}, failed on {} urls", __FUNCTION__, urls.size());
   }
   return false;
 }
 
+int CTextureDatabase::GetCachedTextures(int afterId,
+                                        unsigned int count,
+                                        std::unordered_map<std::string, CCachedTexture>& textures)
+{
+  try
+  {
+    if (!m_pDB)
+      return -1;
+    if (!m_pDS)
+      return -1;
+
+    const std::string sql =
+        PrepareSQL("SELECT url, id, cachedurl, lasthashcheck, imagehash, width, height FROM "
+                   "texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) "
+                   "WHERE texture.id > %i ORDER BY texture.id LIMIT %u",
+                   afterId, count);
+    if (!m_pDS->query(sql))
+      return -1;
+
+    const int lastId = ReadCachedTextures(textures);
+    m_pDS->close();
+    return lastId >= 0 ? lastId : afterId;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{}, failed after id {}", __FUNCTION__, afterId);
+  }
+  return -1;
+}
+
+int CTextureDatabase::ReadCachedTextures(std::unordered_map<std::string, CCachedTexture>& textures)
+{
+  int lastId = -1;
+  while (!m_pDS->eof())
+  {
+    CCachedTexture& texture = textures[m_pDS->fv(0).get_asString()];
+    texture.details.id = m_pDS->fv(1).get_asInt();
+    texture.details.file = m_pDS->fv(2).get_asString();
+    texture.lastHashCheck.SetFromDBDateTime(m_pDS->fv(3).get_asString());
+    texture.imageHash = m_pDS->fv(4).get_asString();
+    texture.details.width = m_pDS->fv(5).get_asInt();
+    texture.details.height = m_pDS->fv(6).get_asInt();
+    lastId = texture.details.id;
+    m_pDS->next();
+  }
+  return lastId;
+}
+
 bool CTextureDatabase::GetTextures(CVariant &items, const Filter &filter)
 {
   try
@@ -322,7 +410,9 @@ bool CTextureDatabase::SetCachedTextureValid(const std::string &url, bool update
   return ExecuteQuery(sql);
 }
 
-bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDetails &details)
+bool CTextureDatabase::AddCachedTexture(const std::string& url,
+                                        const CTextureDetails& details,
+                                        uint64_t fileSize)
 {
   try
   {
@@ -335,7 +425,10 @@ bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDe
     m_pDS->exec(sql);
 
     std::string date = details.updateable ? CDateTime::GetCurrentDateTime().GetAsDBDateTime() : "";
-    sql = PrepareSQL("INSERT INTO texture (id, url, cachedurl, imagehash, lasthashcheck) VALUES(NULL, '%s', '%s', '%s', '%s')", url.c_str(), details.file.c_str(), details.hash.c_str(), date.c_str());
+    sql = PrepareSQL("INSERT INTO texture (id, url, cachedurl, imagehash, lasthashcheck, filesize) "
+                     "VALUES(NULL, '%s', '%s', '%s', '%s', %" PRIu64 ")",
+                     url.c_str(), details.file.c_str(), details.hash.c_str(), date.c_str(),
+                     fileSize);
     m_pDS->exec(sql);
     int textureID = (int)m_pDS->lastinsertid();
 
@@ -386,6 +479,103 @@ bool CTextureDatabase::ClearCachedTexture(int id, std::string &cacheFile)
   return false;
 }
 
+bool CTextureDatabase::ClearCachedTextures(const std::vector<int>& ids)
+{
+  if (ids.empty())
+    return true;
+
+  std::vector<std::string> values;
+  values.reserve(ids.size());
+  for (int id : ids)
+    values.emplace_back(std::to_string(id));
+
+  // sizes are removed by the textureDelete trigger
+  return ExecuteQuery("DELETE FROM texture WHERE id IN (" + StringUtils::Join(values, ",") + ")");
+}
+
+bool CTextureDatabase::GetTextureUsage(std::vector<CTextureUsage>& textures)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::string sql = "SELECT texture.id, cachedurl, sum(usecount), max(lastusetime), filesize "
+                      "FROM texture LEFT JOIN sizes ON (texture.id=sizes.idtexture) "
+                      "GROUP BY texture.id";
+    if (!m_pDS->query(sql))
+      return false;
+
+    textures.reserve(textures.size() + m_pDS->num_rows());
+    while (!m_pDS->eof())
+    {
+      CTextureUsage texture;
+      texture.id = m_pDS->fv(0).get_asInt();
+      texture.file = m_pDS->fv(1).get_asString();
+      texture.useCount = m_pDS->fv(2).get_asInt();
+      texture.lastUsed.SetFromDBDateTime(m_pDS->fv(3).get_asString());
+      if (!m_pDS->fv(4).get_isNull())
+        texture.size = m_pDS->fv(4).get_asInt64();
+      textures.push_back(std::move(texture));
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{}, failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CTextureDatabase::SetCachedTextureSizes(const std::vector<CTextureUsage>& textures)
+{
+  if (textures.empty())
+    return true;
+
+  BeginMultipleExecute();
+  for (const CTextureUsage& texture : textures)
+    ExecuteQuery(
+        PrepareSQL("UPDATE texture SET filesize=%" PRIi64 " WHERE id=%i", texture.size, texture.id));
+  return CommitMultipleExecute();
+}
+
+bool CTextureDatabase::AddCachedTextureSize(const std::string& cacheFile, uint64_t size)
+{
+  // an unknown size stays unknown
+  return ExecuteQuery(PrepareSQL("UPDATE texture SET filesize=filesize+%" PRIu64
+                                 " WHERE cachedurl='%s'",
+                                 size, cacheFile.c_str()));
+}
+
+int64_t CTextureDatabase::GetCachedTexturesSize()
+{
+  try
+  {
+    if (!m_pDB)
+      return -1;
+    if (!m_pDS)
+      return -1;
+
+    if (!m_pDS->query("SELECT SUM(filesize) FROM texture"))
+      return -1;
+
+    int64_t size = 0;
+    if (!m_pDS->eof() && !m_pDS->fv(0).get_isNull())
+      size = m_pDS->fv(0).get_asInt64();
+    m_pDS->close();
+    return size;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{}, failed", __FUNCTION__);
+  }
+  return -1;
+}
+
 bool CTextureDatabase::InvalidateCachedTexture(const std::string &url)
 {
   std::string date = (CDateTime::GetCurrentDateTime() - CDateTimeSpan(2, 0, 0, 0)).GetAsDBDateTime();
@@ -423,6 +613,38 @@ std::string CTextureDatabase::GetTextureForPath(const std::string &url, const st
   return "";
 }
 
+bool CTextureDatabase::GetTexturesForPath(const std::string& url,
+                                          std::map<std::string, std::string>& textures)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    if (url.empty())
+      return false;
+
+    std::string sql = PrepareSQL("select type, texture from path where url='%s'", url.c_str());
+    if (!m_pDS->query(sql))
+      return false;
+
+    while (!m_pDS->eof())
+    {
+      textures[m_pDS->fv(0).get_asString()] = m_pDS->fv(1).get_asString();
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{}, failed on url '{}'", __FUNCTION__, url);
+  }
+  return false;
+}
+
 void CTextureDatabase::SetTextureForPath(const std::string &url, const std::string &type, const std::string &texture)
 {
   try
@@ -9,14 +9,49 @@
 #pragma once
 
 #include "TextureCacheJob.h"
+#include "XBDateTime.h"
 #include "dbwrappers/Database.h"
 #include "dbwrappers/DatabaseQuery.h"
 
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class CVariant;
 
+/*!
+ \ingroup textures
+ \brief A cached texture as stored in the texture database
+ */
+class CCachedTexture
+{
+public:
+  /*! \brief Get the details of the texture
+   The image hash is only included if it is due to be checked for an update of the image.
+   \return the details of the texture
+   */
+  CTextureDetails GetDetails() const;
+
+  CTextureDetails details; ///< details of the texture without the image hash
+  std::string imageHash;
+  CDateTime lastHashCheck;
+};
+
+/*!
+ \ingroup textures
+ \brief How much a cached texture has been used
+ */
+class CTextureUsage
+{
+public:
+  int id = -1;
+  std::string file; ///< cached file, relative to the thumbnails folder
+  unsigned int useCount = 0;
+  CDateTime lastUsed;
+  int64_t size = -1; ///< bytes used by the cached file and its .dds version, -1 if unknown
+};
+
 class CTextureRule : public CDatabaseQueryRule
 {
 public:
@@ -63,12 +98,70 @@ public:
   bool Open() override;
 
   bool GetCachedTexture(const std::string &originalURL, CTextureDetails &details);
-  bool AddCachedTexture(const std::string &originalURL, const CTextureDetails &details);
+
+  /*! \brief Get the cached textures of many images at once
+   \param originalURLs urls of the original images, all cached textures are retrieved if empty
+   \param textures [out] the cached textures found, keyed by the url of the original image
+   \return true if the lookup succeeded, false otherwise
+   */
+  bool GetCachedTextures(const std::vector<std::string>& originalURLs,
+                         std::unordered_map<std::string, CCachedTexture>& textures);
+
+  /*! \brief Get a page of all cached textures, ordered by id
+   \param afterId only textures with a larger id are retrieved
+   \param count maximum number of textures to retrieve
+   \param textures [out] the cached textures found are added, keyed by the url of the original image
+   \return id of the last texture retrieved, afterId if there are no more, -1 on failure
+   */
+  int GetCachedTextures(int afterId,
+                        unsigned int count,
+                        std::unordered_map<std::string, CCachedTexture>& textures);
+
+  /*! \brief Add a cached texture, replacing one of the same image
+   \param originalURL url of the original image
+   \param details the texture details
+   \param fileSize bytes used by the cached file
+   \return true if the texture was added, false otherwise
+   */
+  bool AddCachedTexture(const std::string& originalURL,
+                        const CTextureDetails& details,
+                        uint64_t fileSize);
   bool SetCachedTextureValid(const std::string &originalURL, bool updateable);
   bool ClearCachedTexture(const std::string &originalURL, std::string &cacheFile);
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
+
+  /*! \brief Remove many cached textures at once
+   \param textureIDs ids of the textures to remove
+   \return true if the textures were removed, false otherwise
+   */
+  bool ClearCachedTextures(const std::vector<int>& textureIDs);
+
   bool IncrementUseCount(const CTextureDetails &details);
 
+  /*! \brief Get the usage of all cached textures
+   \param textures [out] use count and last use time of each cached texture
+   \return true if the lookup succeeded, false otherwise
+   */
+  bool GetTextureUsage(std::vector<CTextureUsage>& textures);
+
+  /*! \brief Store the size of cached textures worked out from their files
+   \param textures the textures with their id and size
+   \return true if the sizes were stored, false otherwise
+   */
+  bool SetCachedTextureSizes(const std::vector<CTextureUsage>& textures);
+
+  /*! \brief Add the size of a file created for a cached texture later on, e.g. its .dds version
+   \param cacheFile the cached file of the texture, relative to the thumbnails folder
+   \param size bytes used by the new file
+   \return true if the size was updated, false otherwise
+   */
+  bool AddCachedTextureSize(const std::string& cacheFile, uint64_t size);
+
+  /*! \brief Get the bytes used by all cached textures of known size
+   \return the size, -1 on failure
+   */
+  int64_t GetCachedTexturesSize();
+
   /*! \brief Invalidate a previously cached texture
    Invalidates the texture hash, and sets the texture update time to the current time so that
    next texture load it will be re-cached.
@@ -85,6 +178,14 @@ public:
    */
   std::string GetTextureForPath(const std::string &url, const std::string &type);
 
+  /*! \brief Get the textures of all types associated with the given path
+   \param url path that may be associated with textures
+   \param textures [out] URLs of the textures keyed by their type
+   \return true if the lookup succeeded, false otherwise
+   \sa GetTextureForPath
+   */
+  bool GetTexturesForPath(const std::string& url, std::map<std::string, std::string>& textures);
+
   /*! \brief Set a texture associated with the given path
    Used for setting of previously discovered images to save
    stat() on the filesystem all the time. Should be used to set
@@ -117,9 +218,15 @@ protected:
    */
   unsigned int GetURLHash(const std::string &url) const;
 
+  /*! \brief Add the cached textures of the current result set to the given map
+   Expects the columns url, id, cachedurl, lasthashcheck, imagehash, width and height.
+   \return id of the last texture read, -1 if there was none
+   */
+  int ReadCachedTextures(std::unordered_map<std::string, CCachedTexture>& textures);
+
   void CreateTables() override;
   void CreateAnalytics() override;
   void UpdateTables(int version) override;
-  int GetSchemaVersion() const override { return 13; }
+  int GetSchemaVersion() const override { return 14; }
   const char* GetBaseDBName() const override { return "Textures"; }
 };
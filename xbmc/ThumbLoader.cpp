@@ -45,6 +45,17 @@ std::string CThumbLoader::GetCachedImage(const CFileItem &item, const std::strin
   return "";
 }
 
+std::map<std::string, std::string> CThumbLoader::GetCachedImages(const CFileItem& item)
+{
+  std::map<std::string, std::string> images;
+  if (!item.GetPath().empty() && m_textureDatabase->Open())
+  {
+    m_textureDatabase->GetTexturesForPath(item.GetPath(), images);
+    m_textureDatabase->Close();
+  }
+  return images;
+}
+
 void CThumbLoader::SetCachedImage(const CFileItem &item, const std::string &type, const std::string &image)
 {
   if (!item.GetPath().empty() && m_textureDatabase->Open())
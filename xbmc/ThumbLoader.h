@@ -10,6 +10,7 @@
 
 #include "BackgroundInfoLoader.h"
 
+#include <map>
 #include <string>
 
 class CTextureDatabase;
@@ -36,6 +37,13 @@ public:
    */
   virtual std::string GetCachedImage(const CFileItem &item, const std::string &type);
 
+  /*! \brief Get all images of the given item listed in the texture database at once
+   \param item CFileItem to check
+   \return the images associated with this item keyed by their type
+   \sa GetCachedImage
+   */
+  std::map<std::string, std::string> GetCachedImages(const CFileItem& item);
+
   /*! \brief Associate an image with the given item in the texture database
    \param item CFileItem to associate the image with
    \param type the type of image
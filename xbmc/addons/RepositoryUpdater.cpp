@@ -9,7 +9,7 @@
 #include "RepositoryUpdater.h"
 
 #include "ServiceBroker.h"
-#include "TextureDatabase.h"
+#include "TextureCache.h"
 #include "addons/AddonDatabase.h"
 #include "addons/AddonEvents.h"
 #include "addons/AddonInstaller.h"
@@ -91,10 +91,7 @@ bool CRepositoryUpdateJob::DoWork()
 
   //Invalidate art.
   {
-    CTextureDatabase textureDB;
-    textureDB.Open();
-    textureDB.BeginMultipleExecute();
-
+    std::vector<std::string> images;
     for (const auto& addon : addons)
     {
       AddonPtr oldAddon;
@@ -106,16 +103,17 @@ bool CRepositoryUpdateJob::DoWork()
           CLog::Log(LOGDEBUG, "CRepository: invalidating cached art for '{}'", addon->ID());
 
         if (!oldAddon->Icon().empty())
-          textureDB.InvalidateCachedTexture(oldAddon->Icon());
+          images.push_back(oldAddon->Icon());
 
         for (const auto& path : oldAddon->Screenshots())
-          textureDB.InvalidateCachedTexture(path);
+          images.push_back(path);
 
         for (const auto& art : oldAddon->Art())
-          textureDB.InvalidateCachedTexture(art.second);
+          images.push_back(art.second);
       }
     }
-    textureDB.CommitMultipleExecute();
+
+    CServiceBroker::GetTextureCache()->InvalidateCachedImages(images);
   }
 
   database.UpdateRepositoryContent(m_repo->ID(), m_repo->Version(), newChecksum, addons);
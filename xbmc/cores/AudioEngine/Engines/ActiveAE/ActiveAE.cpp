@@ -24,6 +24,7 @@ using namespace ActiveAE;
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 
@@ -44,11 +45,34 @@ void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
   m_bufferedSamples = 0;
   m_suspended = false;
   m_pcmOutput = pcm;
+  m_sinkDelayValid = false;
 }
 
 void CEngineStats::UpdateSinkDelay(const AEDelayStatus& status, int samples)
 {
   std::unique_lock<CCriticalSection> lock(m_lock);
+
+  if (samples > 0)
+  {
+    // the sink ran dry since the last write although the engine had data queued
+    if (m_sinkDelayValid && m_bufferedSamples > samples && m_sinkDelay.delay > 0.0 &&
+        m_sinkDelay.GetDelay() <= 0.0)
+    {
+      m_sinkLatencyStats.xruns++;
+      CLog::Log(LOGDEBUG, "CEngineStats::UpdateSinkDelay - sink underrun, total: {}",
+                m_sinkLatencyStats.xruns);
+    }
+
+    const unsigned int ms = static_cast<unsigned int>(std::max(status.delay, 0.0) * 1000);
+    int bucket = 0;
+    while (bucket < AESinkLatencyStats::BUCKETS - 1 &&
+           ms >= AESinkLatencyStats::BUCKET_LIMITS[bucket])
+      bucket++;
+    m_sinkLatencyStats.latency[bucket]++;
+    m_sinkLatencyStats.writes++;
+  }
+  m_sinkDelayValid = samples > 0;
+
   m_sinkDelay = status;
   if (samples > m_bufferedSamples)
   {
@@ -263,6 +287,35 @@ void CEngineStats::SetCurrentSinkFormat(const AEAudioFormat& SinkFormat)
   m_sinkFormat = SinkFormat;
 }
 
+void CEngineStats::GetSinkLatencyStats(AESinkLatencyStats& stats)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  stats = m_sinkLatencyStats;
+}
+
+void CEngineStats::AddResamplerInit(std::chrono::microseconds time, bool reused)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  if (reused)
+  {
+    m_resampleStats.reuses++;
+    m_resampleStats.reuseTime += time;
+  }
+  else
+  {
+    m_resampleStats.inits++;
+    m_resampleStats.initTime += time;
+    CLog::Log(LOGDEBUG, "CEngineStats::AddResamplerInit - init took {} us, total: {} reused: {}",
+              time.count(), m_resampleStats.inits, m_resampleStats.reuses);
+  }
+}
+
+void CEngineStats::GetResampleStats(AEResampleStats& stats)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  stats = m_resampleStats;
+}
+
 AEAudioFormat CEngineStats::GetCurrentSinkFormat()
 {
   std::unique_lock<CCriticalSection> lock(m_lock);
@@ -1081,6 +1134,11 @@ void CActiveAE::Process()
       gotMsg = true;
       port = &m_controlPort;
     }
+    // check buffers handed back by the sink
+    else if (ReturnSinkBuffers())
+    {
+      continue;
+    }
     // check sink data port
     else if (m_sink.m_dataPort.ReceiveInMessage(&msg))
     {
@@ -1145,6 +1203,25 @@ void CActiveAE::Process()
   }
 }
 
+bool CActiveAE::ReturnSinkBuffers()
+{
+  CSampleBuffer* buffer;
+  bool returned = false;
+  while (m_sink.ReceiveReturnedSample(buffer))
+  {
+    buffer->Return();
+    returned = true;
+  }
+
+  // same as RETURNSAMPLE on the sink data port
+  if (returned && (m_state == AE_TOP_CONFIGURED_IDLE || m_state == AE_TOP_CONFIGURED_PLAY))
+  {
+    m_extTimeout = 0ms;
+    m_state = AE_TOP_CONFIGURED_PLAY;
+  }
+  return returned;
+}
+
 AEAudioFormat CActiveAE::GetInputFormat(AEAudioFormat *desiredFmt)
 {
   AEAudioFormat inputFormat;
@@ -1375,6 +1452,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         (*it)->m_processingBuffers = std::make_unique<CActiveAEStreamBuffers>(
             (*it)->m_inputBuffers->m_format, outputFormat, m_settings.resampleQuality);
         (*it)->m_processingBuffers->ForceResampler((*it)->m_forceResampler);
+        (*it)->m_processingBuffers->SetResampleCache(&m_resampleCache);
 
         (*it)->m_processingBuffers->Create(MAX_CACHE_LEVEL*1000, false, m_settings.stereoupmix, m_settings.normalizelevels);
       }
@@ -1413,6 +1491,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         // resample buffers
         m_vizBuffers = std::make_unique<CActiveAEBufferPoolResample>(m_internalFormat, vizFormat,
                                                                      m_settings.resampleQuality);
+        m_vizBuffers->SetResampleCache(&m_resampleCache);
         //! @todo use cache of sync + water level
         m_vizBuffers->Create(2000 + m_stats.GetMaxDelay() * 1000, false, false);
         m_vizInitialized = false;
@@ -1436,6 +1515,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   {
     m_sinkBuffers = std::make_unique<CActiveAEBufferPoolResample>(sinkInputFormat, m_sinkFormat,
                                                                   m_settings.resampleQuality);
+    m_sinkBuffers->SetResampleCache(&m_resampleCache);
     m_sinkBuffers->Create(MAX_WATER_LEVEL*1000, true, false);
   }
 
@@ -1891,6 +1971,29 @@ void CActiveAE::UnconfigureSink()
   m_currDevice = "";
 
   m_inMsgEvent.Reset();
+
+  AESinkLatencyStats stats;
+  m_stats.GetSinkLatencyStats(stats);
+  if (stats.writes > 0)
+  {
+    std::string latency;
+    for (int i = 0; i < AESinkLatencyStats::BUCKETS - 1; i++)
+      latency += StringUtils::Format("<{}ms: {}, ", AESinkLatencyStats::BUCKET_LIMITS[i],
+                                     stats.latency[i]);
+    latency += StringUtils::Format(">={}ms: {}",
+                                   AESinkLatencyStats::BUCKET_LIMITS[AESinkLatencyStats::BUCKETS - 2],
+                                   stats.latency[AESinkLatencyStats::BUCKETS - 1]);
+    CLog::Log(LOGDEBUG, "ActiveAE::{} - sink writes: {}, underruns: {}, latency after write: {}",
+              __FUNCTION__, stats.writes, stats.xruns, latency);
+  }
+
+  AEResampleStats resampleStats;
+  m_stats.GetResampleStats(resampleStats);
+  if (resampleStats.inits + resampleStats.reuses > 0)
+    CLog::Log(LOGDEBUG,
+              "ActiveAE::{} - resamplers initialized: {} ({} us), reused: {} ({} us)",
+              __FUNCTION__, resampleStats.inits, resampleStats.initTime.count(),
+              resampleStats.reuses, resampleStats.reuseTime.count());
 }
 
 
@@ -2339,11 +2442,11 @@ bool CActiveAE::RunStages()
   busy |= m_sinkBuffers->ResampleBuffers();
   while(!m_sinkBuffers->m_outputSamples.empty())
   {
-    CSampleBuffer *out = NULL;
-    out = m_sinkBuffers->m_outputSamples.front();
+    // the ring holds more buffers than a pool allocates, if it is full anyway
+    // the rest is sent once the sink has played some
+    if (!m_sink.QueueSample(m_sinkBuffers->m_outputSamples.front()))
+      break;
     m_sinkBuffers->m_outputSamples.pop_front();
-    m_sink.m_dataPort.SendOutMessage(CSinkDataProtocol::SAMPLE,
-        &out, sizeof(CSampleBuffer*));
     busy = true;
   }
 
@@ -16,6 +16,7 @@
 #include "threads/SystemClock.h"
 #include "threads/Thread.h"
 
+#include <chrono>
 #include <list>
 #include <memory>
 #include <queue>
@@ -179,6 +180,25 @@ struct MsgStreamFFmpegInfo
   enum AVAudioServiceType audio_service_type;
 };
 
+struct AESinkLatencyStats
+{
+  static constexpr int BUCKETS = 8;
+  //! upper bounds in ms of the latency buckets, the last bucket is open ended
+  static constexpr unsigned int BUCKET_LIMITS[BUCKETS - 1] = {2, 5, 10, 20, 50, 100, 200};
+
+  uint64_t xruns = 0;
+  uint64_t writes = 0;
+  uint64_t latency[BUCKETS] = {};
+};
+
+struct AEResampleStats
+{
+  uint64_t inits = 0; // resamplers built from scratch
+  uint64_t reuses = 0; // resamplers taken from cache
+  std::chrono::microseconds initTime{0};
+  std::chrono::microseconds reuseTime{0};
+};
+
 class CEngineStats
 {
 public:
@@ -202,6 +222,9 @@ public:
   void SetSinkNeedIec(bool needIEC) { m_sinkNeedIecPack = needIEC; }
   bool IsSuspended();
   AEAudioFormat GetCurrentSinkFormat();
+  void GetSinkLatencyStats(AESinkLatencyStats& stats);
+  void AddResamplerInit(std::chrono::microseconds time, bool reused);
+  void GetResampleStats(AEResampleStats& stats);
 protected:
   float m_sinkCacheTotal;
   float m_sinkLatency;
@@ -212,6 +235,9 @@ protected:
   AEAudioFormat m_sinkFormat;
   bool m_pcmOutput;
   bool m_sinkNeedIecPack{false};
+  bool m_sinkDelayValid{false};
+  AESinkLatencyStats m_sinkLatencyStats;
+  AEResampleStats m_resampleStats;
   CCriticalSection m_lock;
   struct StreamStats
   {
@@ -326,6 +352,7 @@ protected:
 
   bool RunStages();
   bool HasWork();
+  bool ReturnSinkBuffers();
   CSampleBuffer* SyncStream(CActiveAEStream *stream);
 
   void ResampleSounds();
@@ -366,6 +393,7 @@ protected:
   AEAudioFormat m_inputFormat;
   AudioSettings m_settings;
   CEngineStats m_stats;
+  CActiveAEResampleCache m_resampleCache{&m_stats};
   IAEEncoder *m_encoder;
   std::string m_currDevice;
   std::unique_ptr<CActiveAESettings> m_settingsHandler;
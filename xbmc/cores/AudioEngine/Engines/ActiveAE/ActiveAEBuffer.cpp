@@ -139,6 +139,9 @@ CActiveAEBufferPoolResample::CActiveAEBufferPoolResample(const AEAudioFormat& in
 
 CActiveAEBufferPoolResample::~CActiveAEBufferPoolResample()
 {
+  if (m_resampleCache && m_resampler)
+    m_resampleCache->Release(m_resampleParams, std::move(m_resampler));
+  m_resampler.reset();
   Flush();
 }
 
@@ -158,38 +161,127 @@ bool CActiveAEBufferPoolResample::Create(unsigned int totaltime, bool remap, boo
       m_inputFormat.m_dataFormat != m_format.m_dataFormat ||
       m_changeResampler)
   {
-    ChangeResampler();
+    if (m_changeResampler || !InitPlaneMap())
+      ChangeResampler();
+  }
+  return true;
+}
+
+bool CActiveAEBufferPoolResample::InitPlaneMap()
+{
+  m_planeMap.clear();
+
+  // only channel order differs, no need for swr to touch the samples
+  if (m_inputFormat.m_dataFormat != AE_FMT_FLOATP || m_format.m_dataFormat != AE_FMT_FLOATP ||
+      m_inputFormat.m_sampleRate != m_format.m_sampleRate || m_forceResampler || m_fillPackets)
+    return false;
+
+  if (!m_remap && m_inputFormat.m_channelLayout.Count() != m_format.m_channelLayout.Count())
+    return false;
+
+  std::vector<int> planeMap;
+  for (unsigned int out = 0; out < m_format.m_channelLayout.Count(); out++)
+  {
+    int idx = -1;
+    for (unsigned int in = 0; in < m_inputFormat.m_channelLayout.Count(); in++)
+    {
+      if (m_inputFormat.m_channelLayout[in] == m_format.m_channelLayout[out])
+      {
+        idx = in;
+        break;
+      }
+    }
+    // a missing channel would be mixed by swr unless we just remap to the sink
+    if (idx < 0 && !m_remap)
+      return false;
+    planeMap.push_back(idx);
   }
+
+  m_planeMap = std::move(planeMap);
+  m_resampler.reset();
   return true;
 }
 
+bool CActiveAEBufferPoolResample::MapPlanes(int64_t timestamp)
+{
+  bool busy = false;
+
+  while (!m_inputSamples.empty() && !m_freeSamples.empty())
+  {
+    CSampleBuffer* in = m_inputSamples.front();
+    if (in->pkt->nb_samples > static_cast<int>(m_format.m_frames) ||
+        in->pkt->planes != static_cast<int>(m_inputFormat.m_channelLayout.Count()))
+    {
+      // does not fit, let the resampler deal with it
+      m_planeMap.clear();
+      m_changeResampler = true;
+      return true;
+    }
+    m_inputSamples.pop_front();
+
+    CSampleBuffer* out = GetFreeBuffer();
+    const int bytes = in->pkt->nb_samples * in->pkt->bytes_per_sample;
+    for (int i = 0; i < out->pkt->planes; i++)
+    {
+      if (m_planeMap[i] >= 0)
+        memcpy(out->pkt->data[i], in->pkt->data[m_planeMap[i]], bytes);
+      else
+        memset(out->pkt->data[i], 0, bytes);
+    }
+    out->pkt->nb_samples = in->pkt->nb_samples;
+    out->timestamp = timestamp ? timestamp : in->timestamp;
+    out->pkt_start_offset = timestamp ? 0 : in->pkt_start_offset;
+    out->centerMixLevel = in->centerMixLevel;
+    m_outputSamples.push_back(out);
+    in->Return();
+    busy = true;
+  }
+  return busy;
+}
+
+AEResampleParams CActiveAEBufferPoolResample::GetResampleParams()
+{
+  AEResampleParams params;
+
+  params.dstConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_format.m_channelLayout);
+  params.dstConfig.channels = m_format.m_channelLayout.Count();
+  params.dstConfig.sample_rate = m_format.m_sampleRate;
+  params.dstConfig.fmt = CAEUtil::GetAVSampleFormat(m_format.m_dataFormat);
+  params.dstConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat);
+  params.dstConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_format.m_dataFormat);
+
+  params.srcConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_inputFormat.m_channelLayout);
+  params.srcConfig.channels = m_inputFormat.m_channelLayout.Count();
+  params.srcConfig.sample_rate = m_inputFormat.m_sampleRate;
+  params.srcConfig.fmt = CAEUtil::GetAVSampleFormat(m_inputFormat.m_dataFormat);
+  params.srcConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_inputFormat.m_dataFormat);
+  params.srcConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_inputFormat.m_dataFormat);
+
+  params.upmix = m_stereoUpmix;
+  params.normalize = m_normalize;
+  params.centerMix = m_centerMixLevel;
+  params.remap = m_remap;
+  if (m_remap)
+    params.remapLayout = m_format.m_channelLayout;
+  params.quality = m_resampleQuality;
+  params.forceResample = m_forceResampler;
+  return params;
+}
+
 void CActiveAEBufferPoolResample::ChangeResampler()
 {
-  m_resampler = CAEResampleFactory::Create();
-
-  SampleConfig dstConfig, srcConfig;
-  dstConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_format.m_channelLayout);
-  dstConfig.channels = m_format.m_channelLayout.Count();
-  dstConfig.sample_rate = m_format.m_sampleRate;
-  dstConfig.fmt = CAEUtil::GetAVSampleFormat(m_format.m_dataFormat);
-  dstConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat);
-  dstConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_format.m_dataFormat);
-
-  srcConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_inputFormat.m_channelLayout);
-  srcConfig.channels = m_inputFormat.m_channelLayout.Count();
-  srcConfig.sample_rate = m_inputFormat.m_sampleRate;
-  srcConfig.fmt = CAEUtil::GetAVSampleFormat(m_inputFormat.m_dataFormat);
-  srcConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_inputFormat.m_dataFormat);
-  srcConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_inputFormat.m_dataFormat);
-
-  m_resampler->Init(dstConfig, srcConfig,
-                    m_stereoUpmix,
-                    m_normalize,
-                    m_centerMixLevel,
-                    m_remap ? &m_format.m_channelLayout : nullptr,
-                    m_resampleQuality,
-                    m_forceResampler);
+  AEResampleParams params = GetResampleParams();
+
+  if (m_resampleCache)
+  {
+    m_resampleCache->Release(m_resampleParams, std::move(m_resampler));
+    m_resampler = m_resampleCache->Acquire(params);
+  }
+  else
+    m_resampler = CActiveAEResampleCache::Create(params, nullptr);
 
+  m_resampleParams = params;
+  m_planeMap.clear();
   m_changeResampler = false;
 }
 
@@ -206,6 +298,8 @@ bool CActiveAEBufferPoolResample::ResampleBuffers(int64_t timestamp)
         ChangeResampler();
       return true;
     }
+    if (!m_planeMap.empty())
+      return MapPlanes(timestamp);
     while(!m_inputSamples.empty())
     {
       in = m_inputSamples.front();
@@ -409,7 +503,8 @@ void CActiveAEBufferPoolResample::Flush()
     m_outputSamples.front()->Return();
     m_outputSamples.pop_front();
   }
-  if (m_resampler)
+  // configuration did not change, only drop what is buffered in the resampler
+  if (m_resampler && (m_changeResampler || !m_resampler->Reset()))
     ChangeResampler();
 }
 
@@ -421,6 +516,13 @@ void CActiveAEBufferPoolResample::SetDrain(bool drain)
 void CActiveAEBufferPoolResample::SetRR(double rr)
 {
   m_resampleRatio = rr;
+
+  // plain channel mapping cannot adjust speed
+  if (rr != 1.0 && !m_planeMap.empty())
+  {
+    m_planeMap.clear();
+    m_changeResampler = true;
+  }
 }
 
 double CActiveAEBufferPoolResample::GetRR() const
@@ -431,6 +533,12 @@ double CActiveAEBufferPoolResample::GetRR() const
 void CActiveAEBufferPoolResample::FillBuffer()
 {
   m_fillPackets = true;
+
+  if (!m_planeMap.empty())
+  {
+    m_planeMap.clear();
+    m_changeResampler = true;
+  }
 }
 
 bool CActiveAEBufferPoolResample::DoesNormalize() const
@@ -443,6 +551,11 @@ void CActiveAEBufferPoolResample::ForceResampler(bool force)
   m_forceResampler = force;
 }
 
+void CActiveAEBufferPoolResample::SetResampleCache(CActiveAEResampleCache* cache)
+{
+  m_resampleCache = cache;
+}
+
 
 // ----------------------------------------------------------------------------------
 // Atempo
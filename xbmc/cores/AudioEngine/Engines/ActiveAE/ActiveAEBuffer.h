@@ -8,11 +8,13 @@
 
 #pragma once
 
+#include "ActiveAEResampleCache.h"
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include <cmath>
 #include <deque>
 #include <memory>
+#include <vector>
 
 extern "C" {
 #include <libavutil/avutil.h>
@@ -89,12 +91,16 @@ public:
   void FillBuffer();
   bool DoesNormalize() const;
   void ForceResampler(bool force);
+  void SetResampleCache(CActiveAEResampleCache* cache);
   AEAudioFormat m_inputFormat;
   std::deque<CSampleBuffer*> m_inputSamples;
   std::deque<CSampleBuffer*> m_outputSamples;
 
 protected:
   void ChangeResampler();
+  AEResampleParams GetResampleParams();
+  bool InitPlaneMap();
+  bool MapPlanes(int64_t timestamp);
 
   uint8_t *m_planes[16];
   bool m_empty = true;
@@ -111,6 +117,9 @@ protected:
   bool m_forceResampler = false;
   AEQuality m_resampleQuality;
   bool m_stereoUpmix = false;
+  CActiveAEResampleCache* m_resampleCache = nullptr;
+  AEResampleParams m_resampleParams;
+  std::vector<int> m_planeMap; // source plane per output plane if only channel order differs
 };
 
 class CActiveAEFilter;
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAEResampleCache.h"
+
+#include "ActiveAE.h"
+#include "cores/AudioEngine/AEResampleFactory.h"
+#include "cores/AudioEngine/Interfaces/AEResample.h"
+
+#include <chrono>
+
+using namespace ActiveAE;
+
+namespace
+{
+bool CompareConfig(const SampleConfig& lhs, const SampleConfig& rhs)
+{
+  return lhs.fmt == rhs.fmt && lhs.channel_layout == rhs.channel_layout &&
+         lhs.channels == rhs.channels && lhs.sample_rate == rhs.sample_rate &&
+         lhs.bits_per_sample == rhs.bits_per_sample && lhs.dither_bits == rhs.dither_bits;
+}
+} // unnamed namespace
+
+bool AEResampleParams::operator==(const AEResampleParams& rhs) const
+{
+  return CompareConfig(dstConfig, rhs.dstConfig) && CompareConfig(srcConfig, rhs.srcConfig) &&
+         upmix == rhs.upmix && normalize == rhs.normalize && centerMix == rhs.centerMix &&
+         remap == rhs.remap && (!remap || remapLayout == rhs.remapLayout) &&
+         quality == rhs.quality && forceResample == rhs.forceResample;
+}
+
+CActiveAEResampleCache::CActiveAEResampleCache(CEngineStats* stats) : m_stats(stats)
+{
+}
+
+CActiveAEResampleCache::~CActiveAEResampleCache() = default;
+
+std::unique_ptr<ActiveAE::IAEResample> CActiveAEResampleCache::Acquire(
+    const AEResampleParams& params)
+{
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    if (it->params == params)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      std::unique_ptr<IAEResample> resampler = std::move(it->resampler);
+      m_entries.erase(it);
+      if (resampler->Reset())
+      {
+        if (m_stats)
+          m_stats->AddResamplerInit(std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::steady_clock::now() - start),
+                                    true);
+        return resampler;
+      }
+      break;
+    }
+  }
+
+  return Create(params, m_stats);
+}
+
+void CActiveAEResampleCache::Release(const AEResampleParams& params,
+                                     std::unique_ptr<IAEResample> resampler)
+{
+  if (!resampler)
+    return;
+
+  m_entries.push_front({params, std::move(resampler)});
+  if (m_entries.size() > MAX_ENTRIES)
+    m_entries.pop_back();
+}
+
+void CActiveAEResampleCache::Clear()
+{
+  m_entries.clear();
+}
+
+std::unique_ptr<ActiveAE::IAEResample> CActiveAEResampleCache::Create(
+    const AEResampleParams& params, CEngineStats* stats)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::unique_ptr<IAEResample> resampler = CAEResampleFactory::Create();
+  CAEChannelInfo remapLayout = params.remapLayout;
+  resampler->Init(params.dstConfig, params.srcConfig, params.upmix, params.normalize,
+                  params.centerMix, params.remap ? &remapLayout : nullptr, params.quality,
+                  params.forceResample);
+
+  if (stats)
+    stats->AddResamplerInit(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - start),
+                            false);
+  return resampler;
+}
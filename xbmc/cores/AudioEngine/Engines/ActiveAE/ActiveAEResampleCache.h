@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AE.h"
+#include "cores/AudioEngine/Utils/AEChannelInfo.h"
+
+#include <list>
+#include <memory>
+
+namespace ActiveAE
+{
+
+class CEngineStats;
+class IAEResample;
+
+/*!
+ * \brief Parameters a resampler was initialized with, used as cache key
+ */
+struct AEResampleParams
+{
+  SampleConfig dstConfig;
+  SampleConfig srcConfig;
+  bool upmix = false;
+  bool normalize = true;
+  double centerMix = 0.0;
+  bool remap = false;
+  CAEChannelInfo remapLayout;
+  AEQuality quality = AE_QUALITY_UNKNOWN;
+  bool forceResample = false;
+
+  bool operator==(const AEResampleParams& rhs) const;
+};
+
+/*!
+ * \brief Keeps recently released resamplers around for reuse
+ *
+ * Seeks, speed changes and GUI sounds let the buffer pools tear down and rebuild
+ * their resampler with the very same configuration. Handing out an already
+ * initialized instance only needs a reset of its internal buffers instead of
+ * rebuilding filter banks and matrices. Only to be used from the engine thread.
+ */
+class CActiveAEResampleCache
+{
+public:
+  explicit CActiveAEResampleCache(CEngineStats* stats);
+  ~CActiveAEResampleCache();
+
+  /*! \brief Get an initialized resampler, from the cache if possible */
+  std::unique_ptr<IAEResample> Acquire(const AEResampleParams& params);
+
+  /*! \brief Give a resampler back for later reuse */
+  void Release(const AEResampleParams& params, std::unique_ptr<IAEResample> resampler);
+
+  /*! \brief Drop all cached resamplers */
+  void Clear();
+
+  /*! \brief Create and init a resampler without cache, reporting to stats if given */
+  static std::unique_ptr<IAEResample> Create(const AEResampleParams& params, CEngineStats* stats);
+
+private:
+  static constexpr size_t MAX_ENTRIES = 8;
+
+  struct Entry
+  {
+    AEResampleParams params;
+    std::unique_ptr<IAEResample> resampler;
+  };
+  std::list<Entry> m_entries;
+  CEngineStats* m_stats;
+};
+
+} // namespace ActiveAE
@@ -188,6 +188,22 @@ bool CActiveAEResampleFFMPEG::Init(SampleConfig dstConfig, SampleConfig srcConfi
   return true;
 }
 
+bool CActiveAEResampleFFMPEG::Reset()
+{
+  if (!m_pContext)
+    return false;
+
+  // swr_init keeps options and custom matrix and reuses the filter bank if
+  // the parameters did not change, it only flushes the internal buffers
+  m_doesResample = m_src_rate != m_dst_rate;
+  if (swr_init(m_pContext) < 0)
+  {
+    CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Reset - init resampler failed");
+    return false;
+  }
+  return true;
+}
+
 int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio)
 {
   int delta = 0;
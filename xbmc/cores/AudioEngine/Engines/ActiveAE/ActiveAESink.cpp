@@ -18,6 +18,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <cstring>
 #include <new> // for std::bad_alloc
 #include <sstream>
 
@@ -54,6 +55,11 @@ void CActiveAESink::Dispose()
   m_bStop = true;
   m_outMsgEvent.Set();
   StopThread();
+  if (m_dataMsg)
+  {
+    m_dataMsg->Release();
+    m_dataMsg = nullptr;
+  }
   m_controlPort.Purge();
   m_dataPort.Purge();
 
@@ -379,7 +385,7 @@ void CActiveAESink::StateMachine(int signal, Protocol *port, Message *msg)
           samples = *((CSampleBuffer**)msg->data);
           CThread::Sleep(std::chrono::milliseconds(1000 * samples->pkt->nb_samples /
                                                    samples->pkt->config.sample_rate));
-          msg->Reply(CSinkDataProtocol::RETURNSAMPLE, &samples, sizeof(CSampleBuffer*));
+          ReturnSample(msg, samples);
           m_extTimeout = 0ms;
           return;
         default:
@@ -436,7 +442,7 @@ void CActiveAESink::StateMachine(int signal, Protocol *port, Message *msg)
           unsigned int delay;
           samples = *((CSampleBuffer**)msg->data);
           delay = OutputSamples(samples);
-          msg->Reply(CSinkDataProtocol::RETURNSAMPLE, &samples, sizeof(CSampleBuffer*));
+          ReturnSample(msg, samples);
           if (m_extError)
           {
             m_sink->Deinitialize();
@@ -637,7 +643,7 @@ void CActiveAESink::Process()
       port = &m_controlPort;
     }
     // check data port
-    else if (m_dataPort.ReceiveOutMessage(&msg))
+    else if (ReceiveDataMessage(&msg))
     {
       gotMsg = true;
       port = &m_dataPort;
@@ -902,21 +908,67 @@ void CActiveAESink::OpenSink()
   m_swapState = CHECK_SWAP;
 }
 
+bool CActiveAESink::QueueSample(CSampleBuffer* samples)
+{
+  if (!m_sampleRing.Push(samples))
+    return false;
+
+  m_outMsgEvent.Set();
+  return true;
+}
+
+bool CActiveAESink::ReceiveDataMessage(Message** msg)
+{
+  // samples queued before a message was sent are visible once it is received
+  // and have to be played first, e.g. ahead of a drain
+  if (!m_dataMsg)
+    m_dataPort.ReceiveOutMessage(&m_dataMsg);
+
+  CSampleBuffer* samples;
+  if (m_sampleRing.Pop(samples))
+  {
+    *msg = m_dataPort.GetMessage();
+    (*msg)->signal = CSinkDataProtocol::SAMPLE;
+    (*msg)->isOut = true;
+    (*msg)->data = (*msg)->buffer;
+    memcpy((*msg)->data, &samples, sizeof(CSampleBuffer*));
+    return true;
+  }
+
+  if (m_dataMsg)
+  {
+    *msg = m_dataMsg;
+    m_dataMsg = nullptr;
+    return true;
+  }
+  return false;
+}
+
 void CActiveAESink::ReturnBuffers()
 {
   Message *msg = nullptr;
   CSampleBuffer *samples;
-  while (m_dataPort.ReceiveOutMessage(&msg))
+  while (ReceiveDataMessage(&msg))
   {
     if (msg->signal == CSinkDataProtocol::SAMPLE)
     {
       samples = *((CSampleBuffer**)msg->data);
-      msg->Reply(CSinkDataProtocol::RETURNSAMPLE, &samples, sizeof(CSampleBuffer*));
+      ReturnSample(msg, samples);
     }
     msg->Release();
   }
 }
 
+void CActiveAESink::ReturnSample(Message* msg, CSampleBuffer* samples)
+{
+  // hand the buffer back through the lock-free ring and only fall back to a
+  // message if the engine is not keeping up
+  if (m_returnRing.Push(samples))
+    m_inMsgEvent->Set();
+  else
+    msg->Reply(CSinkDataProtocol::RETURNSAMPLE, &samples, sizeof(CSampleBuffer*));
+}
+
 unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
 {
   uint8_t **buffer = samples->pkt->data;
@@ -12,6 +12,7 @@
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/AESink.h"
+#include "cores/AudioEngine/Utils/AESPSCRing.h"
 #include "threads/Event.h"
 #include "threads/SystemClock.h"
 #include "threads/Thread.h"
@@ -104,6 +105,8 @@ public:
   bool SupportsFormat(const std::string &device, AEAudioFormat &format);
   bool DeviceExist(std::string driver, const std::string& device);
   bool NeedIecPack() const { return m_needIecPack; }
+  bool QueueSample(CSampleBuffer* samples);
+  bool ReceiveReturnedSample(CSampleBuffer*& samples) { return m_returnRing.Pop(samples); }
   CSinkControlProtocol m_controlPort;
   CSinkDataProtocol m_dataPort;
 
@@ -113,7 +116,9 @@ protected:
   void PrintSinks(std::string& driver);
   void GetDeviceFriendlyName(const std::string& device);
   void OpenSink();
+  bool ReceiveDataMessage(Message** msg);
   void ReturnBuffers();
+  void ReturnSample(Message* msg, CSampleBuffer* samples);
   void SetSilenceTimer();
   bool NeedIECPacking();
 
@@ -124,6 +129,12 @@ protected:
 
   CEvent m_outMsgEvent;
   CEvent *m_inMsgEvent;
+  //! samples to play, handed to the state machine as SAMPLE messages of m_dataPort
+  CAESPSCRing<CSampleBuffer*> m_sampleRing{256};
+  //! played buffers handed back to the engine
+  CAESPSCRing<CSampleBuffer*> m_returnRing{256};
+  //! message of m_dataPort waiting for the samples queued ahead of it
+  Message* m_dataMsg{nullptr};
   int m_state;
   bool m_bStateMachineSelfTrigger;
   std::chrono::milliseconds m_extTimeout;
@@ -752,6 +752,11 @@ void CActiveAEStreamBuffers::ForceResampler(bool force)
   m_resampleBuffers->ForceResampler(force);
 }
 
+void CActiveAEStreamBuffers::SetResampleCache(CActiveAEResampleCache* cache)
+{
+  m_resampleBuffers->SetResampleCache(cache);
+}
+
 std::unique_ptr<CActiveAEBufferPool> CActiveAEStreamBuffers::GetResampleBuffers()
 {
   return std::move(m_resampleBuffers);
@@ -110,6 +110,7 @@ public:
   void FillBuffer();
   bool DoesNormalize();
   void ForceResampler(bool force);
+  void SetResampleCache(CActiveAEResampleCache* cache);
   bool HasWork();
   std::unique_ptr<CActiveAEBufferPool> GetResampleBuffers();
   std::unique_ptr<CActiveAEBufferPool> GetAtempoBuffers();
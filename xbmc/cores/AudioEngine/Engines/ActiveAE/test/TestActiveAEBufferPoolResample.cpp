@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
+#include "cores/AudioEngine/Interfaces/AEResample.h"
+
+#include <initializer_list>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+
+namespace
+{
+// 10 ms periods
+constexpr int PERIOD = 480;
+constexpr int64_t TIMESTAMP = 1234;
+
+AEAudioFormat CreateFormat(const CAEChannelInfo& layout, unsigned int sampleRate = 48000)
+{
+  AEAudioFormat format;
+  format.m_dataFormat = AE_FMT_FLOATP;
+  format.m_sampleRate = sampleRate;
+  format.m_channelLayout = layout;
+  format.m_frames = PERIOD;
+  return format;
+}
+
+CAEChannelInfo CreateLayout(std::initializer_list<AEChannel> channels)
+{
+  CAEChannelInfo layout;
+  for (AEChannel channel : channels)
+    layout += channel;
+  return layout;
+}
+
+class CTestBufferPoolResample : public CActiveAEBufferPoolResample
+{
+public:
+  using CActiveAEBufferPoolResample::CActiveAEBufferPoolResample;
+
+  bool HasResampler() const { return m_resampler != nullptr; }
+  bool MapsPlanes() const { return !m_planeMap.empty(); }
+};
+} // unnamed namespace
+
+class TestActiveAEBufferPoolResample : public testing::Test
+{
+protected:
+  // set up the pools, the pool under test takes buffers from the input pool
+  void Create(const AEAudioFormat& inputFormat,
+              const AEAudioFormat& outputFormat,
+              bool remap,
+              bool forceResampler = false)
+  {
+    m_input = std::make_unique<CActiveAEBufferPool>(inputFormat);
+    m_input->Create(0);
+    m_pool = std::make_unique<CTestBufferPoolResample>(inputFormat, outputFormat, AE_QUALITY_MID);
+    m_pool->ForceResampler(forceResampler);
+    m_pool->Create(0, remap, false);
+  }
+
+  void TearDown() override
+  {
+    // input buffers still held by the pool under test go back to the input pool
+    m_pool.reset();
+    m_input.reset();
+  }
+
+  // queue a period with the value of each sample being the plane number + 1
+  void AddInput()
+  {
+    CSampleBuffer* buffer = m_input->GetFreeBuffer();
+    ASSERT_NE(nullptr, buffer);
+    for (int plane = 0; plane < buffer->pkt->planes; plane++)
+    {
+      float* samples = reinterpret_cast<float*>(buffer->pkt->data[plane]);
+      for (int i = 0; i < PERIOD; i++)
+        samples[i] = plane + 1;
+    }
+    buffer->pkt->nb_samples = PERIOD;
+    buffer->timestamp = TIMESTAMP;
+    m_pool->m_inputSamples.push_back(buffer);
+  }
+
+  // the value of all samples of a plane, -1 if they differ
+  static float GetPlaneValue(const CSampleBuffer* buffer, int plane)
+  {
+    const float* samples = reinterpret_cast<const float*>(buffer->pkt->data[plane]);
+    for (int i = 1; i < buffer->pkt->nb_samples; i++)
+    {
+      if (samples[i] != samples[0])
+        return -1;
+    }
+    return samples[0];
+  }
+
+  std::unique_ptr<CActiveAEBufferPool> m_input;
+  std::unique_ptr<CTestBufferPoolResample> m_pool;
+};
+
+TEST_F(TestActiveAEBufferPoolResample, ReordersPlanes)
+{
+  Create(CreateFormat(CreateLayout({AE_CH_FL, AE_CH_FR, AE_CH_FC})),
+         CreateFormat(CreateLayout({AE_CH_FC, AE_CH_FL, AE_CH_FR})), false);
+  EXPECT_TRUE(m_pool->MapsPlanes());
+  EXPECT_FALSE(m_pool->HasResampler());
+
+  const size_t freeInput = m_input->m_freeSamples.size();
+  AddInput();
+  EXPECT_TRUE(m_pool->ResampleBuffers());
+
+  ASSERT_EQ(1u, m_pool->m_outputSamples.size());
+  EXPECT_TRUE(m_pool->m_inputSamples.empty());
+  CSampleBuffer* out = m_pool->m_outputSamples.front();
+  m_pool->m_outputSamples.pop_front();
+  EXPECT_EQ(PERIOD, out->pkt->nb_samples);
+  EXPECT_EQ(TIMESTAMP, out->timestamp);
+  EXPECT_EQ(3, GetPlaneValue(out, 0));
+  EXPECT_EQ(1, GetPlaneValue(out, 1));
+  EXPECT_EQ(2, GetPlaneValue(out, 2));
+  out->Return();
+
+  // the samples were copied, the input buffer is free again
+  EXPECT_EQ(freeInput, m_input->m_freeSamples.size());
+
+  // nothing left to do
+  EXPECT_FALSE(m_pool->ResampleBuffers());
+}
+
+TEST_F(TestActiveAEBufferPoolResample, SilencesMissingChannelsOnRemap)
+{
+  Create(CreateFormat(CreateLayout({AE_CH_FL, AE_CH_FR})),
+         CreateFormat(CreateLayout({AE_CH_FR, AE_CH_FL, AE_CH_FC})), true);
+  EXPECT_TRUE(m_pool->MapsPlanes());
+  EXPECT_FALSE(m_pool->HasResampler());
+
+  AddInput();
+  EXPECT_TRUE(m_pool->ResampleBuffers(TIMESTAMP + 10));
+
+  ASSERT_EQ(1u, m_pool->m_outputSamples.size());
+  CSampleBuffer* out = m_pool->m_outputSamples.front();
+  m_pool->m_outputSamples.pop_front();
+  EXPECT_EQ(TIMESTAMP + 10, out->timestamp);
+  EXPECT_EQ(2, GetPlaneValue(out, 0));
+  EXPECT_EQ(1, GetPlaneValue(out, 1));
+  EXPECT_EQ(0, GetPlaneValue(out, 2));
+  out->Return();
+}
+
+TEST_F(TestActiveAEBufferPoolResample, MixesMissingChannels)
+{
+  // without remap a missing channel has to be mixed into the others
+  Create(CreateFormat(CreateLayout({AE_CH_FL, AE_CH_FR, AE_CH_FC})),
+         CreateFormat(CreateLayout({AE_CH_FL, AE_CH_FR, AE_CH_LFE})), false);
+  EXPECT_FALSE(m_pool->MapsPlanes());
+  EXPECT_TRUE(m_pool->HasResampler());
+}
+
+TEST_F(TestActiveAEBufferPoolResample, ResamplesOtherRates)
+{
+  Create(CreateFormat(CreateLayout({AE_CH_FL, AE_CH_FR}), 44100),
+         CreateFormat(CreateLayout({AE_CH_FR, AE_CH_FL})), false);
+  EXPECT_FALSE(m_pool->MapsPlanes());
+  EXPECT_TRUE(m_pool->HasResampler());
+}
+
+TEST_F(TestActiveAEBufferPoolResample, ForcedResampler)
+{
+  // e.g. for sync by resampling
+  Create(CreateFormat(CreateLayout({AE_CH_FL, AE_CH_FR})),
+         CreateFormat(CreateLayout({AE_CH_FR, AE_CH_FL})), false, true);
+  EXPECT_FALSE(m_pool->MapsPlanes());
+  EXPECT_TRUE(m_pool->HasResampler());
+}
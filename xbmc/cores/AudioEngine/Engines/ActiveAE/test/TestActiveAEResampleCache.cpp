@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResampleCache.h"
+#include "cores/AudioEngine/Interfaces/AEResample.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+
+#include <iterator>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+
+namespace
+{
+SampleConfig CreateConfig(int sampleRate)
+{
+  const CAEChannelInfo layout(AE_CH_LAYOUT_2_0);
+
+  SampleConfig config;
+  config.fmt = CAEUtil::GetAVSampleFormat(AE_FMT_FLOATP);
+  config.channel_layout = CAEUtil::GetAVChannelLayout(layout);
+  config.channels = layout.Count();
+  config.sample_rate = sampleRate;
+  config.bits_per_sample = CAEUtil::DataFormatToUsedBits(AE_FMT_FLOATP);
+  config.dither_bits = CAEUtil::DataFormatToDitherBits(AE_FMT_FLOATP);
+  return config;
+}
+
+// converts from the given rate to 48 kHz
+AEResampleParams CreateParams(int srcRate)
+{
+  AEResampleParams params;
+  params.dstConfig = CreateConfig(48000);
+  params.srcConfig = CreateConfig(srcRate);
+  params.quality = AE_QUALITY_MID;
+  return params;
+}
+} // unnamed namespace
+
+class TestActiveAEResampleCache : public testing::Test
+{
+protected:
+  AEResampleStats GetResampleStats()
+  {
+    AEResampleStats stats;
+    m_stats.GetResampleStats(stats);
+    return stats;
+  }
+
+  CEngineStats m_stats;
+  CActiveAEResampleCache m_cache{&m_stats};
+};
+
+TEST_F(TestActiveAEResampleCache, ReusesReleasedResampler)
+{
+  const AEResampleParams params = CreateParams(44100);
+
+  std::unique_ptr<IAEResample> resampler = m_cache.Acquire(params);
+  ASSERT_TRUE(resampler);
+  const IAEResample* instance = resampler.get();
+  m_cache.Release(params, std::move(resampler));
+
+  resampler = m_cache.Acquire(params);
+  EXPECT_EQ(instance, resampler.get());
+
+  const AEResampleStats stats = GetResampleStats();
+  EXPECT_EQ(1u, stats.inits);
+  EXPECT_EQ(1u, stats.reuses);
+
+  // handed out resamplers are no longer cached
+  std::unique_ptr<IAEResample> other = m_cache.Acquire(params);
+  EXPECT_NE(resampler.get(), other.get());
+  EXPECT_EQ(2u, GetResampleStats().inits);
+}
+
+TEST_F(TestActiveAEResampleCache, MatchesParams)
+{
+  const AEResampleParams params44 = CreateParams(44100);
+  const AEResampleParams params96 = CreateParams(96000);
+
+  m_cache.Release(params44, m_cache.Acquire(params44));
+
+  // another configuration needs its own resampler and leaves the cached one alone
+  m_cache.Release(params96, m_cache.Acquire(params96));
+  EXPECT_EQ(2u, GetResampleStats().inits);
+  EXPECT_EQ(0u, GetResampleStats().reuses);
+
+  AEResampleParams upmix = params44;
+  upmix.upmix = true;
+  m_cache.Acquire(upmix);
+  EXPECT_EQ(3u, GetResampleStats().inits);
+
+  m_cache.Acquire(params44);
+  m_cache.Acquire(params96);
+  EXPECT_EQ(3u, GetResampleStats().inits);
+  EXPECT_EQ(2u, GetResampleStats().reuses);
+}
+
+TEST_F(TestActiveAEResampleCache, EvictsLeastRecentlyReleased)
+{
+  const int rates[] = {8000,  11025, 16000, 22050, 24000,
+                       32000, 44100, 88200, 96000, 192000};
+  for (int rate : rates)
+    m_cache.Release(CreateParams(rate), m_cache.Acquire(CreateParams(rate)));
+  EXPECT_EQ(10u, GetResampleStats().inits);
+
+  // the cache holds the last 8
+  for (size_t i = 2; i < std::size(rates); i++)
+    m_cache.Acquire(CreateParams(rates[i]));
+  EXPECT_EQ(10u, GetResampleStats().inits);
+  EXPECT_EQ(8u, GetResampleStats().reuses);
+
+  m_cache.Acquire(CreateParams(rates[0]));
+  m_cache.Acquire(CreateParams(rates[1]));
+  EXPECT_EQ(12u, GetResampleStats().inits);
+}
+
+TEST_F(TestActiveAEResampleCache, Clear)
+{
+  const AEResampleParams params = CreateParams(44100);
+
+  m_cache.Release(params, m_cache.Acquire(params));
+  m_cache.Clear();
+
+  EXPECT_TRUE(m_cache.Acquire(params));
+  EXPECT_EQ(2u, GetResampleStats().inits);
+  EXPECT_EQ(0u, GetResampleStats().reuses);
+}
+
+TEST_F(TestActiveAEResampleCache, CreateWithoutStats)
+{
+  EXPECT_TRUE(CActiveAEResampleCache::Create(CreateParams(44100), nullptr));
+  EXPECT_TRUE(CActiveAEResampleCache::Create(CreateParams(44100), &m_stats));
+  EXPECT_EQ(1u, GetResampleStats().inits);
+}
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAESink.h"
+#include "threads/Event.h"
+
+#include <chrono>
+#include <deque>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr unsigned int BUFFERS = 8;
+// 1 ms periods
+constexpr int PERIOD = 48;
+
+AEAudioFormat CreateFormat()
+{
+  AEAudioFormat format;
+  format.m_dataFormat = AE_FMT_FLOAT;
+  format.m_sampleRate = 48000;
+  format.m_channelLayout = AE_CH_LAYOUT_2_0;
+  format.m_frames = PERIOD;
+  return format;
+}
+} // unnamed namespace
+
+// without a configured device the sink sleeps for the length of each sample
+class TestActiveAESink : public testing::Test
+{
+protected:
+  TestActiveAESink() : m_pool(CreateFormat()), m_sink(&m_event) {}
+
+  void SetUp() override
+  {
+    m_pool.Create(BUFFERS);
+    m_sink.Start();
+  }
+
+  void TearDown() override { m_sink.Dispose(); }
+
+  CSampleBuffer* QueueSample(int frames)
+  {
+    CSampleBuffer* samples = m_pool.GetFreeBuffer();
+    if (!samples)
+      return nullptr;
+
+    samples->pkt->nb_samples = frames;
+    EXPECT_TRUE(m_sink.QueueSample(samples));
+    return samples;
+  }
+
+  CSampleBuffer* ReceiveReturnedSample()
+  {
+    CSampleBuffer* samples;
+    while (!m_sink.ReceiveReturnedSample(samples))
+    {
+      if (!m_event.Wait(1s))
+        return nullptr;
+    }
+    samples->Return();
+    return samples;
+  }
+
+  CActiveAEBufferPool m_pool;
+  CEvent m_event;
+  CActiveAESink m_sink;
+};
+
+TEST_F(TestActiveAESink, Stress)
+{
+  // empty samples don't sleep, both rings run as fast as the threads can
+  constexpr unsigned int COUNT = 20000;
+  std::deque<CSampleBuffer*> queued;
+  unsigned int returned = 0;
+
+  while (returned < COUNT)
+  {
+    while (returned + queued.size() < COUNT)
+    {
+      CSampleBuffer* samples = QueueSample(0);
+      if (!samples)
+        break;
+      queued.push_back(samples);
+    }
+
+    // every buffer comes back once, in the order it was queued
+    ASSERT_EQ(queued.front(), ReceiveReturnedSample());
+    queued.pop_front();
+    returned++;
+  }
+  EXPECT_EQ(BUFFERS, m_pool.m_freeSamples.size());
+}
+
+TEST_F(TestActiveAESink, Paced)
+{
+  constexpr unsigned int COUNT = 100;
+  const auto start = std::chrono::steady_clock::now();
+  unsigned int queued = 0;
+  unsigned int returned = 0;
+
+  while (returned < COUNT)
+  {
+    while (queued < COUNT && QueueSample(PERIOD))
+      queued++;
+
+    ASSERT_NE(nullptr, ReceiveReturnedSample());
+    returned++;
+  }
+
+  EXPECT_GE(std::chrono::steady_clock::now() - start, COUNT * 1ms);
+}
+
+TEST_F(TestActiveAESink, DrainAfterQueuedSamples)
+{
+  for (unsigned int i = 0; i < BUFFERS; i++)
+    ASSERT_NE(nullptr, QueueSample(PERIOD));
+
+  Message* reply;
+  ASSERT_TRUE(m_sink.m_dataPort.SendOutMessageSync(CSinkDataProtocol::DRAIN, &reply, 2s));
+  EXPECT_EQ(CSinkDataProtocol::ACC, reply->signal);
+  reply->Release();
+
+  // the samples sent ahead of the drain have been played
+  CSampleBuffer* samples;
+  unsigned int returned = 0;
+  while (m_sink.ReceiveReturnedSample(samples))
+  {
+    samples->Return();
+    returned++;
+  }
+  EXPECT_EQ(BUFFERS, returned);
+}
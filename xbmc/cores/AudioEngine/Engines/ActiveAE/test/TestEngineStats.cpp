@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+
+#include <chrono>
+#include <list>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr unsigned int SAMPLE_RATE = 48000;
+// 10 ms periods
+constexpr int PERIOD = 480;
+
+AEDelayStatus CreateDelay(double delay)
+{
+  AEDelayStatus status;
+  status.SetDelay(delay);
+  return status;
+}
+} // unnamed namespace
+
+class TestEngineStats : public testing::Test
+{
+protected:
+  void SetUp() override { m_stats.Reset(SAMPLE_RATE, true); }
+
+  void AddSamples(int samples) { m_stats.AddSamples(samples, m_streams); }
+
+  AESinkLatencyStats GetSinkLatencyStats()
+  {
+    AESinkLatencyStats stats;
+    m_stats.GetSinkLatencyStats(stats);
+    return stats;
+  }
+
+  CEngineStats m_stats;
+  std::list<CActiveAEStream*> m_streams;
+};
+
+TEST_F(TestEngineStats, LatencyHistogram)
+{
+  AddSamples(10 * PERIOD);
+
+  for (double delay : {0.001, 0.003, 0.004, 0.030, 0.5})
+    m_stats.UpdateSinkDelay(CreateDelay(delay), PERIOD);
+  // only writes count
+  m_stats.UpdateSinkDelay(CreateDelay(0.030), 0);
+
+  const AESinkLatencyStats stats = GetSinkLatencyStats();
+  EXPECT_EQ(5u, stats.writes);
+  EXPECT_EQ(0u, stats.xruns);
+
+  const uint64_t expected[AESinkLatencyStats::BUCKETS] = {1, 2, 0, 0, 1, 0, 0, 1};
+  for (int i = 0; i < AESinkLatencyStats::BUCKETS; i++)
+    EXPECT_EQ(expected[i], stats.latency[i]) << "bucket " << i;
+}
+
+TEST_F(TestEngineStats, Underrun)
+{
+  AddSamples(10 * PERIOD);
+
+  // the sink plays its 2 ms well before the next write
+  m_stats.UpdateSinkDelay(CreateDelay(0.002), PERIOD);
+  std::this_thread::sleep_for(20ms);
+  m_stats.UpdateSinkDelay(CreateDelay(0.002), PERIOD);
+
+  EXPECT_EQ(1u, GetSinkLatencyStats().xruns);
+}
+
+TEST_F(TestEngineStats, NoUnderrunWhileSinkIsBuffered)
+{
+  AddSamples(10 * PERIOD);
+
+  m_stats.UpdateSinkDelay(CreateDelay(0.5), PERIOD);
+  std::this_thread::sleep_for(20ms);
+  m_stats.UpdateSinkDelay(CreateDelay(0.5), PERIOD);
+
+  EXPECT_EQ(0u, GetSinkLatencyStats().xruns);
+}
+
+TEST_F(TestEngineStats, NoUnderrunWithoutData)
+{
+  // the engine had nothing more to give, the sink running dry is no underrun
+  AddSamples(PERIOD);
+  m_stats.UpdateSinkDelay(CreateDelay(0.002), PERIOD);
+  std::this_thread::sleep_for(20ms);
+  AddSamples(PERIOD);
+  m_stats.UpdateSinkDelay(CreateDelay(0.002), PERIOD);
+
+  EXPECT_EQ(0u, GetSinkLatencyStats().xruns);
+}
+
+TEST_F(TestEngineStats, ResetEndsPeriod)
+{
+  // a flush resets the sink, the pause before the next write is no underrun
+  AddSamples(10 * PERIOD);
+  m_stats.UpdateSinkDelay(CreateDelay(0.002), PERIOD);
+  std::this_thread::sleep_for(20ms);
+  m_stats.Reset(SAMPLE_RATE, true);
+  AddSamples(10 * PERIOD);
+  m_stats.UpdateSinkDelay(CreateDelay(0.002), PERIOD);
+
+  const AESinkLatencyStats stats = GetSinkLatencyStats();
+  EXPECT_EQ(0u, stats.xruns);
+  EXPECT_EQ(2u, stats.writes);
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * Wait-free single producer / single consumer ring.
+ *
+ * Exactly one thread may call Push() and exactly one (other) thread may call
+ * Pop(). Neither side ever blocks or takes a lock, which makes it suitable for
+ * handing buffers between the engine and the sink thread at short periods.
+ * Capacity is rounded up to the next power of two.
+ */
+template<typename T>
+class CAESPSCRing
+{
+public:
+  explicit CAESPSCRing(size_t capacity)
+  {
+    size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    m_mask = size - 1;
+    m_items = std::make_unique<T[]>(size);
+  }
+
+  CAESPSCRing(const CAESPSCRing&) = delete;
+  CAESPSCRing& operator=(const CAESPSCRing&) = delete;
+
+  /*! \brief Append an item, called by the producer only
+   \return false if the ring is full
+   */
+  bool Push(const T& item)
+  {
+    const size_t write = m_write.load(std::memory_order_relaxed);
+    if (write - m_readCache > m_mask)
+    {
+      m_readCache = m_read.load(std::memory_order_acquire);
+      if (write - m_readCache > m_mask)
+        return false;
+    }
+    m_items[write & m_mask] = item;
+    m_write.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*! \brief Remove the oldest item, called by the consumer only
+   \return false if the ring is empty
+   */
+  bool Pop(T& item)
+  {
+    const size_t read = m_read.load(std::memory_order_relaxed);
+    if (read == m_writeCache)
+    {
+      m_writeCache = m_write.load(std::memory_order_acquire);
+      if (read == m_writeCache)
+        return false;
+    }
+    item = m_items[read & m_mask];
+    m_read.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*! \brief Number of queued items, only exact when called from producer or consumer */
+  size_t Size() const
+  {
+    return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+  }
+
+  bool Empty() const { return Size() == 0; }
+  size_t Capacity() const { return m_mask + 1; }
+
+private:
+  static constexpr size_t CACHE_LINE = 64;
+
+  std::unique_ptr<T[]> m_items;
+  size_t m_mask;
+
+  // producer side: write index and its cached view of the consumer
+  alignas(CACHE_LINE) std::atomic<size_t> m_write{0};
+  size_t m_readCache{0};
+
+  // consumer side: read index and its cached view of the producer
+  alignas(CACHE_LINE) std::atomic<size_t> m_read{0};
+  size_t m_writeCache{0};
+};
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AESPSCRing.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(TestAESPSCRing, Capacity)
+{
+  CAESPSCRing<int> ring(5);
+  EXPECT_EQ(8u, ring.Capacity());
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(TestAESPSCRing, FullAndEmpty)
+{
+  CAESPSCRing<int> ring(4);
+  int value;
+  EXPECT_FALSE(ring.Pop(value));
+
+  for (int i = 0; i < 4; i++)
+    EXPECT_TRUE(ring.Push(i));
+  EXPECT_FALSE(ring.Push(4));
+  EXPECT_EQ(4u, ring.Size());
+
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_TRUE(ring.Pop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(ring.Pop(value));
+  EXPECT_TRUE(ring.Push(5));
+}
+
+TEST(TestAESPSCRing, ProducerConsumer)
+{
+  // both sides as fast as they can, small ring to force wrap around
+  constexpr unsigned int count = 1000000;
+  CAESPSCRing<unsigned int> ring(16);
+
+  std::thread producer([&ring]() {
+    for (unsigned int i = 0; i < count;)
+    {
+      if (ring.Push(i))
+        i++;
+      else
+        std::this_thread::yield();
+    }
+  });
+
+  unsigned int expected = 0;
+  unsigned int value;
+  while (expected < count)
+  {
+    if (ring.Pop(value))
+    {
+      ASSERT_EQ(expected, value);
+      expected++;
+    }
+    else
+      std::this_thread::yield();
+  }
+  producer.join();
+
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(TestAESPSCRing, PacedConsumer)
+{
+  // a sink taking one buffer per 2 ms period from an engine that runs ahead of it
+  constexpr unsigned int periods = 250;
+  constexpr auto period = 2ms;
+  CAESPSCRing<unsigned int> ring(4);
+  std::atomic<unsigned int> full{0};
+
+  std::thread producer([&]() {
+    for (unsigned int i = 0; i < periods;)
+    {
+      if (ring.Push(i))
+        i++;
+      else
+      {
+        // wait for the sink to make room, as the engine waits for returned buffers
+        full++;
+        std::this_thread::sleep_for(period / 4);
+      }
+    }
+  });
+
+  std::vector<unsigned int> received;
+  auto next = std::chrono::steady_clock::now();
+  while (received.size() < periods)
+  {
+    next += period;
+    std::this_thread::sleep_until(next);
+
+    unsigned int value;
+    if (ring.Pop(value))
+      received.push_back(value);
+  }
+  producer.join();
+
+  for (unsigned int i = 0; i < periods; i++)
+    EXPECT_EQ(i, received[i]);
+  // the ring filled up and the engine had to wait for the sink
+  EXPECT_GT(full, 0u);
+  EXPECT_TRUE(ring.Empty());
+}
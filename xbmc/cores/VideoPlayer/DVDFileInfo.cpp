@@ -12,6 +12,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "pictures/Picture.h"
+#include "pictures/PictureScaler.h"
 #include "video/VideoInfoTag.h"
 #include "filesystem/StackDirectory.h"
 #include "utils/log.h"
@@ -36,10 +37,15 @@
 #include "cores/FFmpeg.h"
 #include "TextureCache.h"
 #include "Util.h"
+#include "threads/CriticalSection.h"
+#include "utils/CPUInfo.h"
 #include "utils/LangCodeExpander.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -70,6 +76,44 @@ bool CDVDFileInfo::GetFileDuration(const std::string &path, int& duration)
     return false;
 }
 
+namespace
+{
+/*!
+ * \brief Throughput of thumb extraction over a burst of files, e.g. a library import
+ */
+class CExtractionStats
+{
+public:
+  void Add(std::chrono::milliseconds duration)
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (m_files == 0 || now - m_last > std::chrono::minutes(1))
+    {
+      m_files = 0;
+      m_start = now - duration;
+    }
+    m_last = now;
+
+    if (++m_files % 50 == 0)
+    {
+      const std::chrono::duration<double, std::ratio<60>> elapsed = now - m_start;
+      CLog::Log(LOGDEBUG, "CDVDFileInfo - thumb extraction throughput {:.1f} files/min",
+                m_files / elapsed.count());
+    }
+  }
+
+private:
+  CCriticalSection m_section;
+  unsigned int m_files = 0;
+  std::chrono::steady_clock::time_point m_start;
+  std::chrono::steady_clock::time_point m_last;
+};
+
+CExtractionStats s_extractionStats;
+} // namespace
+
 int DegreeToOrientation(int degrees)
 {
   switch(degrees)
@@ -89,6 +133,21 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
                                 CTextureDetails &details,
                                 CStreamDetails *pStreamDetails,
                                 int64_t pos)
+{
+  std::vector<ThumbRequest> requests{{pos, &details}};
+  return ExtractThumbs(fileItem, requests, pStreamDetails);
+}
+
+unsigned int CDVDFileInfo::GetMaxConcurrentExtractions()
+{
+  // decoding is cpu bound, leave room for the gui and playback
+  return std::max(1, CServiceBroker::GetCPUInfo()->GetCPUCount() / 2);
+}
+
+bool CDVDFileInfo::ExtractThumbs(const CFileItem& fileItem,
+                                 std::vector<ThumbRequest>& requests,
+                                 CStreamDetails* pStreamDetails,
+                                 const std::function<bool(size_t)>& progress /* = nullptr */)
 {
   const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
   auto start = std::chrono::steady_clock::now();
@@ -180,7 +239,8 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
-  bool bOk = false;
+  int extracted = 0;
+  size_t processed = requests.size();
   int packetsTried = 0;
 
   if (nVideoStream != -1)
@@ -198,52 +258,62 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
 
     if (pVideoCodec)
     {
-      int nTotalLen = pDemuxer->GetStreamLength();
-      int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
-
-      CLog::Log(LOGDEBUG, "{} - seeking to pos {}ms (total: {}ms) in {}", __FUNCTION__, nSeekTo,
-                nTotalLen, redactPath);
+      const int nTotalLen = pDemuxer->GetStreamLength();
+      const int orientation = DegreeToOrientation(hint.orientation);
+      CPictureScaler scaler;
 
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+      for (size_t i = 0; i < requests.size(); i++)
       {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
+        ThumbRequest& request = requests[i];
+        int64_t nSeekTo = (request.pos == -1) ? nTotalLen / 3 : request.pos;
+
+        CLog::Log(LOGDEBUG, "{} - seeking to pos {}ms (total: {}ms) in {}", __FUNCTION__,
+                  nSeekTo, nTotalLen, redactPath);
 
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
+        if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
         {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
+          // the seek lands on the preceding keyframe, that is all we need for a still, so have
+          // the decoder skip every frame nothing else references
+          pVideoCodec->Reset();
+          pVideoCodec->SetCodecControl(DVD_CODEC_CTRL_DROP_ANY);
 
-          if (!pPacket)
-            break;
+          CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+          VideoPicture picture = {};
 
-          if (pPacket->iStreamId != nVideoStream)
+          // num streams * 160 frames, should get a valid frame, if not abort.
+          int abort_index = pDemuxer->GetNrOfStreams() * 160;
+          do
           {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
+            DemuxPacket* pPacket = pDemuxer->Read();
+            packetsTried++;
+
+            if (!pPacket)
+              break;
 
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+            if (pPacket->iStreamId != nVideoStream)
+            {
+              CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+              continue;
+            }
 
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
+            pVideoCodec->AddData(*pPacket);
+            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
 
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
-          {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
-          }
+            iDecoderState = CDVDVideoCodec::VC_NONE;
+            while (iDecoderState == CDVDVideoCodec::VC_NONE)
+            {
+              iDecoderState = pVideoCodec->GetPicture(&picture);
+            }
 
-        } while (abort_index--);
+            if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+            {
+              if(!(picture.iFlags & DVP_FLAG_DROPPED))
+                break;
+            }
 
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
+          } while (abort_index--);
+
+          if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
           {
             unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
             double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
@@ -254,10 +324,8 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
             // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
             int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
             uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
+            if (scaler.Configure(picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P, nWidth,
+                                 nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR))
             {
               uint8_t *planes[YuvImage::MAX_PLANES];
               int stride[YuvImage::MAX_PLANES];
@@ -267,22 +335,34 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
               int srcStride[] = { stride[0], stride[1], stride[2], 0 };
               uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
               int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
+              scaler.Scale(src, srcStride, dst, dstStride);
 
+              CTextureDetails& details = *request.details;
               details.width = nWidth;
               details.height = nHeight;
               CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
+              request.extracted = true;
+              extracted++;
             }
             av_free(pOutBuf);
           }
+          else
+          {
+            CLog::Log(LOGDEBUG, "{} - decode failed in {} after {} packets.", __FUNCTION__,
+                      redactPath, packetsTried);
+          }
+
+          if (picture.videoBuffer)
+          {
+            picture.videoBuffer->Release();
+            picture.videoBuffer = nullptr;
+          }
         }
-        else
+
+        if (progress && !progress(i))
         {
-          CLog::Log(LOGDEBUG, "{} - decode failed in {} after {} packets.", __FUNCTION__,
-                    redactPath, packetsTried);
+          processed = i + 1;
+          break;
         }
       }
     }
@@ -291,19 +371,26 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
   if (pDemuxer)
     delete pDemuxer;
 
-  if(!bOk)
+  // leave an empty file for failed extractions so they are not retried, requests skipped
+  // because of a cancellation are left alone
+  for (size_t i = 0; i < processed; i++)
   {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
+    if (!requests[i].extracted)
+    {
+      XFILE::CFile file;
+      if (file.OpenForWrite(CTextureCache::GetCachedPath(requests[i].details->file)))
+        file.Close();
+    }
   }
 
   auto end = std::chrono::steady_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-  CLog::Log(LOGDEBUG, "{} - measured {} ms to extract thumb from file <{}> in {} packets. ",
-            __FUNCTION__, duration.count(), redactPath, packetsTried);
+  CLog::Log(LOGDEBUG, "{} - measured {} ms to extract {} of {} thumbs from file <{}> in {} packets. ",
+            __FUNCTION__, duration.count(), extracted, requests.size(), redactPath, packetsTried);
+
+  s_extractionStats.Add(duration);
 
-  return bOk;
+  return extracted > 0;
 }
 
 /**
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,12 +23,35 @@ class CTextureDetails;
 class CDVDFileInfo
 {
 public:
+  struct ThumbRequest
+  {
+    int64_t pos; ///< position in ms, -1 to pick one a third into the stream
+    CTextureDetails* details; ///< target of the thumb, file must be set
+    bool extracted = false;
+  };
+
   // Extract a thumbnail image from the media referenced by fileItem, optionally populating a streamdetails class with the data
   static bool ExtractThumb(const CFileItem& fileItem,
                            CTextureDetails &details,
                            CStreamDetails *pStreamDetails,
                            int64_t pos);
 
+  /** \brief Extract several stills (e.g. chapters or bookmarks) from the media referenced by
+  *   fileItem. Input stream, demuxer and decoder are set up once and only keyframes are decoded.
+  *   \param[in,out] requests positions to extract, extracted is set for each successful one.
+  *   \param progress optional, called with the index of each processed request. Returning false
+  *   stops the extraction.
+  *   \return true if at least one thumb was extracted.
+  */
+  static bool ExtractThumbs(const CFileItem& fileItem,
+                            std::vector<ThumbRequest>& requests,
+                            CStreamDetails* pStreamDetails,
+                            const std::function<bool(size_t)>& progress = nullptr);
+
+  /** \brief Number of thumb extractions that may run in parallel, derived from the CPU count.
+  */
+  static unsigned int GetMaxConcurrentExtractions();
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(const std::shared_ptr<CDVDInputStream>& pInputStream,
@@ -29,6 +29,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/GLUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -36,6 +37,10 @@
 #include <locale.h>
 #include <mutex>
 
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
 #ifdef TARGET_DARWIN_OSX
 #include "platform/darwin/osx/CocoaInterface.h"
 #include <CoreVideo/CoreVideo.h>
@@ -92,6 +97,8 @@ CLinuxRendererGL::CPictureBuffer::CPictureBuffer()
   memset(&fields, 0, sizeof(fields));
   memset(&image , 0, sizeof(image));
   memset(&pbo   , 0, sizeof(pbo));
+  memset(&pboMap, 0, sizeof(pboMap));
+  fence = nullptr;
   videoBuffer = nullptr;
   loaded = false;
 }
@@ -231,6 +238,10 @@ bool CLinuxRendererGL::Configure(const VideoPicture &picture, float fps, unsigne
   m_pixelRatio = 1.0;
 
   m_pboSupported = CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_pixel_buffer_object");
+#ifdef GL_MAP_PERSISTENT_BIT
+  m_pboPersistentSupported =
+      CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_buffer_storage");
+#endif
 
   // setup the background colour
   m_clearColour = CServiceBroker::GetWinSystem()->UseLimitedColor() ? (16.0f / 0xff) : 0.0f;
@@ -957,9 +968,15 @@ void CLinuxRendererGL::LoadShaders(int field)
   {
     CLog::Log(LOGINFO, "GL: Using GL_ARB_pixel_buffer_object");
     m_pboUsed = true;
+    m_pboPersistent = m_pboSupported && m_pboPersistentSupported;
+    if (m_pboPersistent)
+      CLog::Log(LOGINFO, "GL: Using persistent mapped pixel buffer objects");
   }
   else
+  {
     m_pboUsed = false;
+    m_pboPersistent = false;
+  }
 }
 
 void CLinuxRendererGL::UnInit()
@@ -1751,6 +1768,12 @@ void CLinuxRendererGL::DeleteTexture(int index)
   CPictureBuffer& buf = m_buffers[index];
   buf.loaded = false;
 
+  if (buf.fence)
+  {
+    glDeleteSync(buf.fence);
+    buf.fence = nullptr;
+  }
+
   if (m_format == AV_PIX_FMT_NV12)
     DeleteNV12Texture(index);
   else if (m_format == AV_PIX_FMT_YUYV422 ||
@@ -1769,35 +1792,69 @@ bool CLinuxRendererGL::UploadTexture(int index)
 
   if (!m_buffers[index].loaded)
   {
-    YuvImage &dst = m_buffers[index].image;
+    CPictureBuffer& buf = m_buffers[index];
+    YuvImage &dst = buf.image;
     YuvImage src;
-    m_buffers[index].videoBuffer->GetPlanes(src.plane);
-    m_buffers[index].videoBuffer->GetStrides(src.stride);
-
-    UnBindPbo(m_buffers[index]);
+    buf.videoBuffer->GetPlanes(src.plane);
+    buf.videoBuffer->GetStrides(src.stride);
 
-    if (m_format == AV_PIX_FMT_NV12)
+    // without pbos there is nothing to gain from staging the frame in system memory,
+    // glTexSubImage2D can read the decoder planes directly using their strides
+    m_copyDirect = !buf.pbo[0];
+    if (m_copyDirect)
     {
-      CVideoBuffer::CopyNV12Picture(&dst, &src);
-      BindPbo(m_buffers[index]);
-      ret = UploadNV12Texture(index);
-    }
-    else if (m_format == AV_PIX_FMT_YUYV422 ||
-             m_format == AV_PIX_FMT_UYVY422)
-    {
-      CVideoBuffer::CopyYUV422PackedPicture(&dst, &src);
-      BindPbo(m_buffers[index]);
-      ret = UploadYUV422PackedTexture(index);
+      YuvImage view = dst;
+      for (int p = 0; p < YuvImage::MAX_PLANES; p++)
+      {
+        view.plane[p] = src.plane[p];
+        view.stride[p] = src.stride[p];
+      }
+
+      if (m_format == AV_PIX_FMT_NV12)
+        ret = UploadNV12Texture(index, view);
+      else if (m_format == AV_PIX_FMT_YUYV422 ||
+               m_format == AV_PIX_FMT_UYVY422)
+        ret = UploadYUV422PackedTexture(index, view);
+      else
+        ret = UploadYV12Texture(index, view);
     }
     else
     {
-      CVideoBuffer::CopyPicture(&dst, &src);
-      BindPbo(m_buffers[index]);
-      ret = UploadYV12Texture(index);
+      UnBindPbo(buf);
+
+      if (m_format == AV_PIX_FMT_NV12)
+      {
+        CVideoBuffer::CopyNV12Picture(&dst, &src);
+        UpdateCopyStats(dst, 2);
+        BindPbo(buf);
+        ret = UploadNV12Texture(index);
+      }
+      else if (m_format == AV_PIX_FMT_YUYV422 ||
+               m_format == AV_PIX_FMT_UYVY422)
+      {
+        CVideoBuffer::CopyYUV422PackedPicture(&dst, &src);
+        UpdateCopyStats(dst, 1);
+        BindPbo(buf);
+        ret = UploadYUV422PackedTexture(index);
+      }
+      else
+      {
+        CVideoBuffer::CopyPicture(&dst, &src);
+        UpdateCopyStats(dst, 3);
+        BindPbo(buf);
+        ret = UploadYV12Texture(index);
+      }
+
+      if (m_pboPersistent)
+      {
+        if (buf.fence)
+          glDeleteSync(buf.fence);
+        buf.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      }
     }
 
     if (ret)
-      m_buffers[index].loaded = true;
+      buf.loaded = true;
   }
 
   if (ret)
@@ -1867,12 +1924,11 @@ bool CLinuxRendererGL::CreateYV12Texture(int index)
 
     for (int i = 0; i < 3; i++)
     {
-      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[i]);
-      glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[i] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-      void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+      uint8_t* pboPtr = CreatePbo(pbo[i], im.planesize[i]);
       if (pboPtr)
       {
-        im.plane[i] = (uint8_t*) pboPtr + PBO_OFFSET;
+        buf.pboMap[i] = pboPtr;
+        im.plane[i] = pboPtr + PBO_OFFSET;
         memset(im.plane[i], 0, im.planesize[i]);
       }
       else
@@ -1892,6 +1948,7 @@ bool CLinuxRendererGL::CreateYV12Texture(int index)
       }
       glDeleteBuffers(3, pbo);
       memset(m_buffers[index].pbo, 0, sizeof(m_buffers[index].pbo));
+      memset(m_buffers[index].pboMap, 0, sizeof(m_buffers[index].pboMap));
     }
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
@@ -1961,9 +2018,14 @@ bool CLinuxRendererGL::CreateYV12Texture(int index)
 }
 
 bool CLinuxRendererGL::UploadYV12Texture(int source)
+{
+  return UploadYV12Texture(source, m_buffers[source].image);
+}
+
+bool CLinuxRendererGL::UploadYV12Texture(int source, const YuvImage& image)
 {
   CPictureBuffer& buf = m_buffers[source];
-  YuvImage* im = &buf.image;
+  const YuvImage* im = &image;
 
   bool deinterlacing;
   if (m_currentField == FIELD_FULL)
@@ -2063,6 +2125,7 @@ void CLinuxRendererGL::DeleteYV12Texture(int index)
       }
       glDeleteBuffers(1, pbo + p);
       pbo[p] = 0;
+      m_buffers[index].pboMap[p] = nullptr;
     }
     else
     {
@@ -2079,9 +2142,14 @@ void CLinuxRendererGL::DeleteYV12Texture(int index)
 // NV12 Texture loading, creation and deletion
 //********************************************************************************************************
 bool CLinuxRendererGL::UploadNV12Texture(int source)
+{
+  return UploadNV12Texture(source, m_buffers[source].image);
+}
+
+bool CLinuxRendererGL::UploadNV12Texture(int source, const YuvImage& image)
 {
   CPictureBuffer& buf = m_buffers[source];
-  YuvImage* im = &buf.image;
+  const YuvImage* im = &image;
 
   bool deinterlacing;
   if (m_currentField == FIELD_FULL)
@@ -2173,12 +2241,11 @@ bool CLinuxRendererGL::CreateNV12Texture(int index)
 
     for (int i = 0; i < 2; i++)
     {
-      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[i]);
-      glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[i] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-      void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+      uint8_t* pboPtr = CreatePbo(pbo[i], im.planesize[i]);
       if (pboPtr)
       {
-        im.plane[i] = (uint8_t*)pboPtr + PBO_OFFSET;
+        buf.pboMap[i] = pboPtr;
+        im.plane[i] = pboPtr + PBO_OFFSET;
         memset(im.plane[i], 0, im.planesize[i]);
       }
       else
@@ -2198,6 +2265,7 @@ bool CLinuxRendererGL::CreateNV12Texture(int index)
       }
       glDeleteBuffers(2, pbo);
       memset(m_buffers[index].pbo, 0, sizeof(m_buffers[index].pbo));
+      memset(m_buffers[index].pboMap, 0, sizeof(m_buffers[index].pboMap));
     }
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
@@ -2305,6 +2373,7 @@ void CLinuxRendererGL::DeleteNV12Texture(int index)
       }
       glDeleteBuffers(1, pbo + p);
       pbo[p] = 0;
+      m_buffers[index].pboMap[p] = nullptr;
     }
     else
     {
@@ -2318,9 +2387,14 @@ void CLinuxRendererGL::DeleteNV12Texture(int index)
 }
 
 bool CLinuxRendererGL::UploadYUV422PackedTexture(int source)
+{
+  return UploadYUV422PackedTexture(source, m_buffers[source].image);
+}
+
+bool CLinuxRendererGL::UploadYUV422PackedTexture(int source, const YuvImage& image)
 {
   CPictureBuffer& buf = m_buffers[source];
-  YuvImage* im = &buf.image;
+  const YuvImage* im = &image;
 
   bool deinterlacing;
   if (m_currentField == FIELD_FULL)
@@ -2391,6 +2465,7 @@ void CLinuxRendererGL::DeleteYUV422PackedTexture(int index)
     }
     glDeleteBuffers(1, pbo);
     pbo[0] = 0;
+    m_buffers[index].pboMap[0] = nullptr;
   }
   else
   {
@@ -2439,12 +2514,11 @@ bool CLinuxRendererGL::CreateYUV422PackedTexture(int index)
     pboSetup = true;
     glGenBuffers(1, pbo);
 
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[0]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[0] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-    void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+    uint8_t* pboPtr = CreatePbo(pbo[0], im.planesize[0]);
     if (pboPtr)
     {
-      im.plane[0] = (uint8_t*)pboPtr + PBO_OFFSET;
+      buf.pboMap[0] = pboPtr;
+      im.plane[0] = pboPtr + PBO_OFFSET;
       memset(im.plane[0], 0, im.planesize[0]);
     }
     else
@@ -2459,6 +2533,7 @@ bool CLinuxRendererGL::CreateYUV422PackedTexture(int index)
       glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
       glDeleteBuffers(1, pbo);
       memset(m_buffers[index].pbo, 0, sizeof(m_buffers[index].pbo));
+      memset(m_buffers[index].pboMap, 0, sizeof(m_buffers[index].pboMap));
     }
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
@@ -2607,6 +2682,26 @@ bool CLinuxRendererGL::Supports(ESCALINGMETHOD method) const
   return false;
 }
 
+uint8_t* CLinuxRendererGL::CreatePbo(GLuint pbo, int size)
+{
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+  if (m_pboPersistent)
+  {
+    // immutable storage that stays mapped for the lifetime of the buffer, this saves
+    // the map/unmap round trip through the driver for every uploaded frame
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size + PBO_OFFSET, nullptr, flags);
+    return static_cast<uint8_t*>(
+        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size + PBO_OFFSET, flags));
+  }
+#endif
+
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size + PBO_OFFSET, nullptr, GL_STREAM_DRAW);
+  return static_cast<uint8_t*>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+}
+
 void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
 {
   bool pbo = false;
@@ -2614,6 +2709,12 @@ void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
   {
     if(!buff.pbo[plane] || buff.image.plane[plane] == (uint8_t*)PBO_OFFSET)
       continue;
+
+    if (m_pboPersistent)
+    {
+      buff.image.plane[plane] = (uint8_t*)PBO_OFFSET;
+      continue;
+    }
     pbo = true;
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buff.pbo[plane]);
@@ -2626,11 +2727,25 @@ void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
 
 void CLinuxRendererGL::UnBindPbo(CPictureBuffer& buff)
 {
+  if (buff.fence)
+  {
+    // the gpu may still be reading the previous frame out of the persistent mapping
+    glClientWaitSync(buff.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+    glDeleteSync(buff.fence);
+    buff.fence = nullptr;
+  }
+
   bool pbo = false;
   for(int plane = 0; plane < YuvImage::MAX_PLANES; plane++)
   {
     if(!buff.pbo[plane] || buff.image.plane[plane] != (uint8_t*)PBO_OFFSET)
       continue;
+
+    if (m_pboPersistent && buff.pboMap[plane])
+    {
+      buff.image.plane[plane] = buff.pboMap[plane] + PBO_OFFSET;
+      continue;
+    }
     pbo = true;
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buff.pbo[plane]);
@@ -2641,6 +2756,48 @@ void CLinuxRendererGL::UnBindPbo(CPictureBuffer& buff)
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
+void CLinuxRendererGL::UpdateCopyStats(const YuvImage& im, int planes)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (m_copyStatsStart == std::chrono::steady_clock::time_point())
+    m_copyStatsStart = now;
+
+  for (int p = 0; p < planes; p++)
+    m_copyBytes += im.planesize[p];
+
+  const std::chrono::duration<double> elapsed = now - m_copyStatsStart;
+  if (elapsed.count() >= 1.0)
+  {
+    m_copyBytesPerSec = m_copyBytes / elapsed.count();
+    m_copyBytes = 0;
+    m_copyStatsStart = now;
+  }
+}
+
+DEBUG_INFO_VIDEO CLinuxRendererGL::GetDebugInfo(int idx)
+{
+  DEBUG_INFO_VIDEO info;
+
+  const char* px = av_get_pix_fmt_name(m_format);
+  info.videoSource = StringUtils::Format("Source: {}x{}, fr: {:.3f}, pixel: {}", m_sourceWidth,
+                                         m_sourceHeight, m_fps, px ? px : "unknown");
+
+  std::string path;
+  if (m_copyDirect)
+    path = "direct";
+  else if (m_pboPersistent)
+    path = "persistent pbo";
+  else if (m_pboUsed)
+    path = "pbo";
+  else
+    path = "sysmem";
+
+  info.shader = StringUtils::Format("Upload: {}, frame copy: {:.1f} MB/s", path,
+                                    m_copyDirect ? 0.0 : m_copyBytesPerSec / (1024.0 * 1024.0));
+
+  return info;
+}
+
 CRenderInfo CLinuxRendererGL::GetRenderInfo()
 {
   CRenderInfo info;
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <vector>
 
 #include "system_gl.h"
@@ -83,6 +84,8 @@ public:
 
   CRenderCapture* GetRenderCapture() override;
 
+  DEBUG_INFO_VIDEO GetDebugInfo(int idx) override;
+
 protected:
 
   bool Render(unsigned int flags, int renderBuffer);
@@ -103,14 +106,17 @@ protected:
   virtual bool CreateTexture(int index);
 
   bool UploadYV12Texture(int index);
+  bool UploadYV12Texture(int index, const YuvImage& im);
   void DeleteYV12Texture(int index);
   bool CreateYV12Texture(int index);
 
   bool UploadNV12Texture(int index);
+  bool UploadNV12Texture(int index, const YuvImage& im);
   void DeleteNV12Texture(int index);
   bool CreateNV12Texture(int index);
 
   bool UploadYUV422PackedTexture(int index);
+  bool UploadYUV422PackedTexture(int index, const YuvImage& im);
   void DeleteYUV422PackedTexture(int index);
   bool CreateYUV422PackedTexture(int index);
 
@@ -126,8 +132,10 @@ protected:
   struct CYuvPlane;
   struct CPictureBuffer;
 
+  uint8_t* CreatePbo(GLuint pbo, int size);
   void BindPbo(CPictureBuffer& buff);
   void UnBindPbo(CPictureBuffer& buff);
+  void UpdateCopyStats(const YuvImage& im, int planes);
   void LoadPlane(CYuvPlane& plane, int type,
                  unsigned width,  unsigned height,
                  int stride, int bpp, void* data);
@@ -182,6 +190,8 @@ protected:
     CYuvPlane fields[MAX_FIELDS][YuvImage::MAX_PLANES];
     YuvImage image;
     GLuint pbo[3]; // one pbo for 3 planes
+    uint8_t* pboMap[3]; // persistent mapping of the pbos, if used
+    GLsync fence; // signalled when the gpu finished reading the persistent pbos
 
     CVideoBuffer *videoBuffer;
     bool loaded;
@@ -215,6 +225,14 @@ protected:
   float m_clearColour = 0.0f;
   bool m_pboSupported = true;
   bool m_pboUsed = false;
+  bool m_pboPersistentSupported = false;
+  bool m_pboPersistent = false;
+
+  // frame copy statistics, shown in the debug overlay
+  uint64_t m_copyBytes = 0;
+  double m_copyBytesPerSec = 0.0;
+  bool m_copyDirect = false;
+  std::chrono::steady_clock::time_point m_copyStatsStart;
   bool m_nonLinStretch = false;
   bool m_nonLinStretchGui = false;
   float m_pixelRatio = 0.0f;
@@ -28,6 +28,8 @@
 #include "platform/posix/ConvUtils.h"
 #endif
 
+#include <algorithm>
+
 using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
@@ -576,10 +578,13 @@ void CDatabase::CopyDB(const std::string& latestDb)
 void CDatabase::DropAnalytics()
 {
   m_pDB->drop_analytics();
+  m_fullTextIndices.clear();
 }
 
 bool CDatabase::Connect(const std::string& dbName, const DatabaseSettings& dbSettings, bool create)
 {
+  m_fullTextIndices.clear();
+
   // create the appropriate database structure
   if (dbSettings.type == "sqlite3")
   {
@@ -689,6 +694,7 @@ void CDatabase::Close()
 
   m_openCount = 0;
   m_multipleExecute = false;
+  m_fullTextIndices.clear();
 
   if (nullptr == m_pDB)
     return;
@@ -832,6 +838,218 @@ bool CDatabase::BuildSQL(const std::string& strQuery, const Filter& filter, std:
   return true;
 }
 
+bool CDatabase::CreateFullTextIndex(const FullTextIndex& index)
+{
+  if (index.columns.empty())
+    return false;
+
+  const std::string columns = StringUtils::Join(index.columns, ", ");
+
+  try
+  {
+    if (m_sqlite)
+    {
+      std::vector<std::string> newValues;
+      std::vector<std::string> updates;
+      for (const auto& column : index.columns)
+      {
+        newValues.emplace_back("new." + column);
+        updates.emplace_back(column + " = new." + column);
+      }
+
+      // the fts5 table is not dropped with the other analytics, recreate it from scratch
+      m_pDS->exec(PrepareSQL("DROP TABLE IF EXISTS %s", index.name.c_str()));
+      m_pDS->exec(PrepareSQL("CREATE VIRTUAL TABLE %s USING fts5(%s)", index.name.c_str(),
+                             columns.c_str()));
+      m_pDS->exec(PrepareSQL("INSERT INTO %s (rowid, %s) SELECT %s, %s FROM %s",
+                             index.name.c_str(), columns.c_str(), index.key.c_str(),
+                             columns.c_str(), index.table.c_str()));
+
+      m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_insert AFTER INSERT ON %s FOR EACH ROW BEGIN "
+                             "INSERT OR REPLACE INTO %s (rowid, %s) VALUES (new.%s, %s); END",
+                             index.name.c_str(), index.table.c_str(), index.name.c_str(),
+                             columns.c_str(), index.key.c_str(),
+                             StringUtils::Join(newValues, ", ").c_str()));
+      m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_delete AFTER DELETE ON %s FOR EACH ROW BEGIN "
+                             "DELETE FROM %s WHERE rowid = old.%s; END",
+                             index.name.c_str(), index.table.c_str(), index.name.c_str(),
+                             index.key.c_str()));
+      m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_update AFTER UPDATE OF %s ON %s FOR EACH ROW BEGIN "
+                             "UPDATE %s SET %s WHERE rowid = old.%s; END",
+                             index.name.c_str(), columns.c_str(), index.table.c_str(),
+                             index.name.c_str(), StringUtils::Join(updates, ", ").c_str(),
+                             index.key.c_str()));
+    }
+    else
+    {
+      // MATCH() needs an index on exactly the queried columns
+      m_pDS->exec(PrepareSQL("ALTER TABLE %s ADD FULLTEXT INDEX %s (%s)", index.table.c_str(),
+                             index.name.c_str(), columns.c_str()));
+      for (size_t i = 0; i < index.columnSubsets.size(); ++i)
+        m_pDS->exec(PrepareSQL("ALTER TABLE %s ADD FULLTEXT INDEX %s_%u (%s)",
+                               index.table.c_str(), index.name.c_str(),
+                               static_cast<unsigned int>(i),
+                               StringUtils::Join(index.columnSubsets[i], ", ").c_str()));
+    }
+  }
+  catch (...)
+  {
+    CLog::Log(LOGWARNING, "{} - full text index {} not supported, searching {} without it",
+              __FUNCTION__, index.name, index.table);
+    m_fullTextIndices[index.name] = false;
+    return false;
+  }
+
+  m_fullTextIndices[index.name] = true;
+  return true;
+}
+
+bool CDatabase::AppendFullTextFilter(Filter& filter,
+                                     const FullTextIndex& index,
+                                     const std::string& keyField,
+                                     const FullTextQuery& query)
+{
+  const std::string match = GetFullTextMatch(index, query, m_sqlite);
+  if (match.empty() || !HasFullTextIndex(index))
+    return false;
+
+  if (m_sqlite)
+  {
+    filter.AppendJoin(PrepareSQL(" JOIN (SELECT rowid AS ftId, rank AS ftScore FROM %s "
+                                 "WHERE %s MATCH '%s') AS %s ON %s.ftId = %s",
+                                 index.name.c_str(), index.name.c_str(), match.c_str(),
+                                 index.name.c_str(), index.name.c_str(), keyField.c_str()));
+    filter.AppendOrder(index.name + ".ftScore");
+  }
+  else
+  {
+    const std::string columns =
+        StringUtils::Join(query.columns.empty() ? index.columns : query.columns, ", ");
+    const std::string against = PrepareSQL("MATCH (%s) AGAINST ('%s' IN BOOLEAN MODE)",
+                                           columns.c_str(), match.c_str());
+
+    filter.AppendJoin(" JOIN (SELECT " + index.key + " AS ftId, " + against + " AS ftScore FROM " +
+                      index.table + " WHERE " + against + ") AS " + index.name + " ON " +
+                      index.name + ".ftId = " + keyField);
+    filter.AppendOrder(index.name + ".ftScore DESC");
+  }
+
+  return true;
+}
+
+std::string CDatabase::GetFullTextMatch(const FullTextIndex& index,
+                                        const FullTextQuery& query,
+                                        bool sqlite)
+{
+  std::vector<std::string> parts;
+
+  if (sqlite)
+  {
+    // every term becomes a phrase, the last word optionally matching as prefix
+    for (const auto& term : query.terms)
+    {
+      std::vector<std::string> words = StringUtils::Split(term, " ");
+      words.erase(std::remove_if(words.begin(), words.end(),
+                                 [](const std::string& word) { return word.empty(); }),
+                  words.end());
+      if (words.empty())
+        continue;
+
+      std::string phrase = StringUtils::Join(words, " ");
+      StringUtils::Replace(phrase, "\"", "\"\"");
+      parts.emplace_back("\"" + phrase + "\"" + (query.prefix ? " *" : ""));
+    }
+    if (parts.empty())
+      return {};
+
+    std::string match = StringUtils::Join(parts, query.matchAll ? " AND " : " OR ");
+    if (!query.columns.empty())
+      match = "{" + StringUtils::Join(query.columns, " ") + "} : (" + match + ")";
+    return match;
+  }
+
+  // MATCH() needs an index on exactly the queried columns
+  if (!query.columns.empty() &&
+      std::find(index.columnSubsets.cbegin(), index.columnSubsets.cend(), query.columns) ==
+          index.columnSubsets.cend())
+    return {};
+
+  // boolean mode: + marks required words, * prefix matches
+  for (const auto& term : query.terms)
+  {
+    std::string cleaned = term;
+    for (const char c : std::string("+-<>()~*\"@"))
+      StringUtils::Replace(cleaned, std::string(1, c), " ");
+
+    std::vector<std::string> words;
+    for (const auto& word : StringUtils::Split(cleaned, " "))
+    {
+      if (word.empty())
+        continue;
+      // shorter words are not indexed by default (innodb_ft_min_token_size)
+      if (word.size() < 3)
+        return {};
+      words.emplace_back(word);
+    }
+    if (words.empty())
+      continue;
+
+    if (words.size() > 1 && !query.prefix)
+    {
+      parts.emplace_back((query.matchAll ? "+\"" : "\"") + StringUtils::Join(words, " ") + "\"");
+      continue;
+    }
+
+    for (auto& word : words)
+      word = (words.size() > 1 ? "+" : "") + word;
+    if (query.prefix)
+      words.back() += "*";
+
+    std::string part = StringUtils::Join(words, " ");
+    if (words.size() > 1)
+      part = "(" + part + ")";
+    parts.emplace_back((query.matchAll ? "+" : "") + part);
+  }
+
+  return StringUtils::Join(parts, " ");
+}
+
+bool CDatabase::HasFullTextIndex(const FullTextIndex& index)
+{
+  const auto it = m_fullTextIndices.find(index.name);
+  if (it != m_fullTextIndices.cend())
+    return it->second;
+
+  if (!m_pDB || !m_pDS)
+    return false;
+
+  std::string query;
+  if (m_sqlite)
+    query = PrepareSQL("SELECT name FROM sqlite_master WHERE type = 'table' AND name = '%s'",
+                       index.name.c_str());
+  else
+    query = PrepareSQL("SELECT index_name FROM information_schema.statistics "
+                       "WHERE table_schema = DATABASE() AND table_name = '%s' "
+                       "AND index_name = '%s' LIMIT 1",
+                       index.table.c_str(), index.name.c_str());
+
+  bool exists = false;
+  try
+  {
+    exists = m_pDS->query(query) && m_pDS->num_rows() > 0;
+    m_pDS->close();
+  }
+  catch (...)
+  {
+    // don't remember the index as missing, the next search looks it up again
+    CLog::Log(LOGERROR, "{} - failed to look up full text index {}", __FUNCTION__, index.name);
+    return false;
+  }
+
+  m_fullTextIndices[index.name] = exists;
+  return exists;
+}
+
 bool CDatabase::BuildSQL(const std::string& strBaseDir,
                          const std::string& strQuery,
                          Filter& filter,
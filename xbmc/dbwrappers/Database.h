@@ -14,6 +14,7 @@ class Database;
 class Dataset;
 } // namespace dbiplus
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -95,6 +96,28 @@ public:
     std::string where;
   };
 
+  /*! \brief Description of a full text index on some text columns of a table.
+   \sa CreateFullTextIndex, AppendFullTextFilter
+   */
+  struct FullTextIndex
+  {
+    std::string name; ///< name of the index (fts5 table on sqlite)
+    std::string table; ///< the indexed table
+    std::string key; ///< the integer primary key of the table
+    std::vector<std::string> columns; ///< the indexed text columns
+    std::vector<std::vector<std::string>> columnSubsets; ///< subsets of columns queried alone
+  };
+
+  /*! \brief Terms to look up in a full text index.
+   */
+  struct FullTextQuery
+  {
+    std::vector<std::string> terms; ///< words or phrases to look for
+    bool matchAll = true; ///< whether all terms have to match or any of them
+    bool prefix = true; ///< whether the last word of a term also matches longer words
+    std::vector<std::string> columns; ///< one of the column subsets of the index, empty for all
+  };
+
   CDatabase();
   virtual ~CDatabase(void);
   bool IsOpen();
@@ -296,6 +319,36 @@ protected:
 
   bool BuildSQL(const std::string& strQuery, const Filter& filter, std::string& strSQL);
 
+  /*! \brief Create a full text index. To be called from CreateAnalytics().
+   On sqlite this creates a fts5 table kept up to date by triggers, on MySQL FULLTEXT indices.
+   \param index the index to create.
+   \return true if the index was created, false if not supported by the database.
+   */
+  bool CreateFullTextIndex(const FullTextIndex& index);
+
+  /*! \brief Restrict a filter to the rows matching a full text query, best matches first.
+   \param filter the filter of a query selecting the indexed rows.
+   \param index the index to look up.
+   \param keyField the field holding the key of the indexed table in the query, e.g. "songview.idSong".
+   \param query the terms to look up.
+   \return true on success, false if the index is not available or cannot handle the query.
+   The filter is unchanged in that case, so the caller can fall back to a LIKE search.
+   */
+  bool AppendFullTextFilter(Filter& filter,
+                            const FullTextIndex& index,
+                            const std::string& keyField,
+                            const FullTextQuery& query);
+
+  /*! \brief Build the expression a full text query is looked up with, not escaped for SQL yet.
+   \param index the index to look up.
+   \param query the terms to look up.
+   \param sqlite whether to build a fts5 MATCH expression or a MySQL boolean mode search string.
+   \return the expression, empty if the index cannot handle the query.
+   */
+  static std::string GetFullTextMatch(const FullTextIndex& index,
+                                      const FullTextQuery& query,
+                                      bool sqlite);
+
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
@@ -318,4 +371,9 @@ private:
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  bool HasFullTextIndex(const FullTextIndex& index);
+
+  /*! whether the full text indices exist, looked up once per connection */
+  std::map<std::string, bool> m_fullTextIndices;
 };
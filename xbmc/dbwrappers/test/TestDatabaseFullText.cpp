@@ -0,0 +1,271 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/Database.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const CDatabase::FullTextIndex ITEMS_INDEX = {
+    "ft_items", "items", "idItem", {"title", "plot"}, {{"title"}}};
+
+CDatabase::FullTextQuery CreateQuery(const std::vector<std::string>& terms,
+                                     bool matchAll = true,
+                                     bool prefix = true)
+{
+  CDatabase::FullTextQuery query;
+  query.terms = terms;
+  query.matchAll = matchAll;
+  query.prefix = prefix;
+  return query;
+}
+
+std::vector<int> Sorted(std::vector<int> items)
+{
+  std::sort(items.begin(), items.end());
+  return items;
+}
+
+class CTestDatabase : public CDatabase
+{
+public:
+  explicit CTestDatabase(bool createIndex) : m_createIndex(createIndex) {}
+
+  using CDatabase::AppendFullTextFilter;
+  using CDatabase::CreateFullTextIndex;
+  using CDatabase::GetFullTextMatch;
+
+  void SetMySQL() { m_sqlite = false; }
+
+  void AddItem(int id, const std::string& title, const std::string& plot)
+  {
+    m_pDS->exec(PrepareSQL("INSERT INTO items (idItem, title, plot) VALUES (%i, '%s', '%s')", id,
+                           title.c_str(), plot.c_str()));
+  }
+
+  void Execute(const std::string& sql) { m_pDS->exec(sql); }
+
+  // the items matching a query, best matches first
+  std::vector<int> Search(const FullTextQuery& query)
+  {
+    std::vector<int> items;
+    Filter filter;
+    if (!AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", query))
+      return items;
+
+    std::string sql;
+    if (!BuildSQL("SELECT items.idItem FROM items", filter, sql) || !m_pDS->query(sql))
+      return items;
+
+    while (!m_pDS->eof())
+    {
+      items.emplace_back(m_pDS->fv(0).get_asInt());
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return items;
+  }
+
+protected:
+  void CreateTables() override
+  {
+    m_pDS->exec("CREATE TABLE items (idItem INTEGER PRIMARY KEY, title TEXT, plot TEXT)");
+  }
+
+  void CreateAnalytics() override
+  {
+    if (m_createIndex)
+      CreateFullTextIndex(ITEMS_INDEX);
+  }
+
+  int GetSchemaVersion() const override { return 1; }
+  const char* GetBaseDBName() const override { return "FullTextTest"; }
+
+private:
+  bool m_createIndex;
+};
+} // unnamed namespace
+
+class TestDatabaseFullText : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_settings.type = "sqlite3";
+    m_settings.name = "fulltexttest";
+    m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db");
+  }
+
+  void TearDown() override { XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db"); }
+
+  bool Connect(CTestDatabase& db) { return db.Connect(m_settings.name, m_settings, true); }
+
+  DatabaseSettings m_settings;
+};
+
+TEST(TestDatabaseFullTextMatch, Sqlite)
+{
+  // every term is a phrase, the last word matching as prefix
+  EXPECT_EQ("\"foo\" * AND \"bar baz\" *",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({"foo", " bar  baz "}), true));
+  EXPECT_EQ("\"foo\" * OR \"bar baz\" *",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({"foo", "bar baz"}, false),
+                                            true));
+  EXPECT_EQ("\"foo\" AND \"bar baz\"",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX,
+                                            CreateQuery({"foo", "bar baz"}, true, false), true));
+
+  // quotes can't end the phrase
+  EXPECT_EQ("\"say \"\"hi\"\"\" *",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({"say \"hi\""}), true));
+
+  CDatabase::FullTextQuery query = CreateQuery({"foo", "bar"}, false);
+  query.columns = {"title"};
+  EXPECT_EQ("{title} : (\"foo\" * OR \"bar\" *)",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX, query, true));
+
+  EXPECT_EQ("", CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({}), true));
+  EXPECT_EQ("", CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({" "}), true));
+}
+
+TEST(TestDatabaseFullTextMatch, MySQL)
+{
+  // boolean mode: + marks required words, * prefix matches
+  EXPECT_EQ("+foo* +(+bar +baz*)",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({"foo", "bar baz"}), false));
+  EXPECT_EQ("foo* (+bar +baz*)",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({"foo", "bar baz"}, false),
+                                            false));
+  EXPECT_EQ("+foo +\"bar baz\"",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX,
+                                            CreateQuery({"foo", "bar baz"}, true, false), false));
+
+  // operators of the boolean mode are no part of the words
+  EXPECT_EQ("+(+foo +bar*)",
+            CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({"-foo+bar\""}), false));
+
+  // words shorter than innodb_ft_min_token_size are not indexed
+  EXPECT_EQ("", CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({"foo", "of"}), false));
+
+  // only the column subsets of the index can be queried
+  CDatabase::FullTextQuery query = CreateQuery({"foo"});
+  query.columns = {"title"};
+  EXPECT_EQ("+foo*", CTestDatabase::GetFullTextMatch(ITEMS_INDEX, query, false));
+  query.columns = {"plot"};
+  EXPECT_EQ("", CTestDatabase::GetFullTextMatch(ITEMS_INDEX, query, false));
+
+  EXPECT_EQ("", CTestDatabase::GetFullTextMatch(ITEMS_INDEX, CreateQuery({}), false));
+}
+
+TEST_F(TestDatabaseFullText, SqliteFilter)
+{
+  CTestDatabase db(true);
+  ASSERT_TRUE(Connect(db));
+
+  CDatabase::Filter filter;
+  ASSERT_TRUE(db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem",
+                                      CreateQuery({"it's", "bar"}, false)));
+  EXPECT_EQ(" JOIN (SELECT rowid AS ftId, rank AS ftScore FROM ft_items WHERE ft_items MATCH "
+            "'\"it''s\" * OR \"bar\" *') AS ft_items ON ft_items.ftId = items.idItem",
+            filter.join);
+  EXPECT_EQ("", filter.where);
+  EXPECT_EQ("ft_items.ftScore", filter.order);
+}
+
+TEST_F(TestDatabaseFullText, SqliteSearch)
+{
+  CTestDatabase db(true);
+  ASSERT_TRUE(Connect(db));
+
+  db.AddItem(1, "Foo bar", "");
+  db.AddItem(2, "Football", "bar bar bar");
+  db.AddItem(3, "Baz", "it's foo");
+  db.AddItem(4, "Nothing", "");
+
+  EXPECT_EQ(std::vector<int>({1, 2}), Sorted(db.Search(CreateQuery({"foo", "bar"}))));
+  EXPECT_EQ(std::vector<int>({1}), db.Search(CreateQuery({"foo", "bar"}, true, false)));
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), Sorted(db.Search(CreateQuery({"foo", "baz"}, false))));
+  EXPECT_EQ(std::vector<int>({3}), db.Search(CreateQuery({"it's"})));
+
+  // the best match comes first
+  EXPECT_EQ(std::vector<int>({2, 1}), db.Search(CreateQuery({"bar"})));
+
+  CDatabase::FullTextQuery query = CreateQuery({"bar"});
+  query.columns = {"title"};
+  EXPECT_EQ(std::vector<int>({1}), db.Search(query));
+
+  // the triggers keep the index up to date
+  db.Execute("UPDATE items SET title = 'Bar' WHERE idItem = 4");
+  db.Execute("DELETE FROM items WHERE idItem = 1");
+  EXPECT_EQ(std::vector<int>({4}), db.Search(query));
+}
+
+TEST_F(TestDatabaseFullText, SqliteMissingIndex)
+{
+  CTestDatabase db(false);
+  ASSERT_TRUE(Connect(db));
+
+  // the caller falls back to LIKE with an unchanged filter
+  CDatabase::Filter filter;
+  filter.AppendWhere("items.idItem > 0");
+  EXPECT_FALSE(db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", CreateQuery({"foo"})));
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ("items.idItem > 0", filter.where);
+  EXPECT_EQ("", filter.order);
+
+  // as when the analytics are recreated on update
+  ASSERT_TRUE(db.CreateFullTextIndex(ITEMS_INDEX));
+  EXPECT_TRUE(db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", CreateQuery({"foo"})));
+}
+
+TEST_F(TestDatabaseFullText, SqliteIndexLookedUpOncePerConnection)
+{
+  CTestDatabase db(true);
+  ASSERT_TRUE(Connect(db));
+  db.Close();
+
+  // the existing index is looked up by the first search only
+  ASSERT_TRUE(Connect(db));
+  CDatabase::Filter filter;
+  EXPECT_TRUE(db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", CreateQuery({"foo"})));
+  db.Execute("DROP TABLE ft_items");
+  EXPECT_TRUE(db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", CreateQuery({"foo"})));
+  db.Close();
+
+  ASSERT_TRUE(Connect(db));
+  EXPECT_FALSE(db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", CreateQuery({"foo"})));
+}
+
+TEST_F(TestDatabaseFullText, MySQLMissingIndex)
+{
+  // MySQL escapes through the connection, without a server there is no index to find
+  CTestDatabase db(true);
+  db.SetMySQL();
+
+  CDatabase::Filter filter;
+  filter.AppendWhere("items.idItem > 0");
+  EXPECT_FALSE(db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", CreateQuery({"foo"})));
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ("items.idItem > 0", filter.where);
+  EXPECT_EQ("", filter.order);
+
+  // queries the index can't handle don't even look for it
+  EXPECT_FALSE(
+      db.AppendFullTextFilter(filter, ITEMS_INDEX, "items.idItem", CreateQuery({"foo", "of"})));
+  EXPECT_EQ("", filter.join);
+}
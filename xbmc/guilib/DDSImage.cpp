@@ -71,6 +71,11 @@ unsigned char *CDDSImage::GetData() const
   return m_data;
 }
 
+bool CDDSImage::HasAlpha() const
+{
+  return (m_desc.pixelFormat.flags & DDPF_ALPHAPIXELS) != 0;
+}
+
 bool CDDSImage::ReadFile(const std::string &inputFile)
 {
   // open the file
@@ -86,8 +91,11 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
     return false;
   if (!GetFormat())
     return false;  // not supported
+  if (m_desc.linearSize != GetStorageRequirements(m_desc.width, m_desc.height, GetFormat()))
+    return false;  // truncated or corrupt
 
   // allocate our data
+  delete[] m_data;
   m_data = new unsigned char[m_desc.linearSize];
   if (!m_data)
     return false;
@@ -100,6 +108,43 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
   return true;
 }
 
+bool CDDSImage::Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *brga, bool hasAlpha)
+{
+  if (!brga || !width || !height || pitch < width * 4)
+    return false;
+
+  Allocate(width, height, XB_FMT_A8R8G8B8);
+  if (hasAlpha)
+    m_desc.pixelFormat.flags |= DDPF_ALPHAPIXELS;
+
+  // store the rows without padding
+  for (unsigned int y = 0; y < height; y++)
+    memcpy(m_data + y * width * 4, brga + y * pitch, width * 4);
+
+  return WriteFile(outputFile);
+}
+
+bool CDDSImage::WriteFile(const std::string &outputFile) const
+{
+  // open the file
+  CFile file;
+  if (!file.OpenForWrite(outputFile, true))
+    return false;
+
+  // write the header
+  if (file.Write("DDS ", 4) != 4)
+    return false;
+  if (file.Write(&m_desc, sizeof(m_desc)) != sizeof(m_desc))
+    return false;
+
+  // and the data
+  if (file.Write(m_data, m_desc.linearSize) != static_cast<ssize_t>(m_desc.linearSize))
+    return false;
+
+  file.Close();
+  return true;
+}
+
 unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format)
 {
   switch (format)
@@ -23,11 +23,25 @@ public:
   unsigned int GetFormat() const;
   unsigned int GetSize() const;
   unsigned char *GetData() const;
+  bool HasAlpha() const;
 
   bool ReadFile(const std::string &file);
 
+  /*! \brief Create a DDS image file from the given uncompressed pixels
+   Pixels are stored as is in A8R8G8B8, so that loading the file doesn't require any decoding.
+   \param outputFile the file to write to
+   \param width the width of the image
+   \param height the height of the image
+   \param pitch the pitch of the source pixels
+   \param brga the source pixels in A8R8G8B8
+   \param hasAlpha whether the image has an alpha channel
+   \return true on successful image creation, false otherwise
+   */
+  bool Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *brga, bool hasAlpha);
+
 private:
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
+  bool WriteFile(const std::string &file) const;
   static const char *GetFourCC(unsigned int format);
 
   static unsigned int GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format);
@@ -43,7 +57,6 @@ private:
   };
 
   enum {
-    ddpf_alphapixels = 0x00000001,
     ddpf_fourcc      = 0x00000004,
     ddpf_rgb         = 0x00000040
   };
@@ -114,6 +114,67 @@ static int64_t mem_file_seek(void *h, int64_t pos, int whence)
   return mbuf->pos;
 }
 
+// Reads the size of a JPEG image from its frame header. Only baseline, extended and
+// progressive images are considered, ffmpeg can't reduce other ones while decoding.
+static bool GetJpegSize(const unsigned char* buffer, size_t size,
+                        unsigned int& width, unsigned int& height)
+{
+  size_t pos = 2; // skip SOI
+  while (pos + 4 <= size)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+
+    const unsigned char marker = buffer[pos + 1];
+    if (marker == 0xFF) // fill byte
+    {
+      pos++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) // markers without segment
+    {
+      pos += 2;
+      continue;
+    }
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+    {
+      if (marker > 0xC2 || pos + 9 > size)
+        return false;
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+    if (marker == 0xD9 || marker == 0xDA) // no frame header before EOI or scan
+      return false;
+
+    pos += 2 + ((buffer[pos + 2] << 8) | buffer[pos + 3]);
+  }
+  return false;
+}
+
+// The largest power of 2 an image can be reduced by while still being at least as large as it
+// is shown at, whether or not it gets rotated.
+static int GetLowres(unsigned int width, unsigned int height,
+                     unsigned int maxWidth, unsigned int maxHeight)
+{
+  // ffmpeg's jpeg decoder supports 1/2, 1/4 and 1/8
+  constexpr int MAX_LOWRES = 3;
+
+  if (!width || !height || !maxWidth || !maxHeight)
+    return 0;
+
+  const double scale =
+      std::max(std::min(static_cast<double>(maxWidth) / width,
+                        static_cast<double>(maxHeight) / height),
+               std::min(static_cast<double>(maxWidth) / height,
+                        static_cast<double>(maxHeight) / width));
+
+  int lowres = 0;
+  while (lowres < MAX_LOWRES && scale * (2 << lowres) <= 1.0)
+    lowres++;
+  return lowres;
+}
+
 CFFmpegImage::CFFmpegImage(const std::string& strMimeType) : m_strMimeType(strMimeType)
 {
   m_hasAlpha = false;
@@ -142,6 +203,12 @@ CFFmpegImage::~CFFmpegImage()
 bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSize,
                                       unsigned int width, unsigned int height)
 {
+  // decode large JPEG images at a reduced size right away instead of scaling them down later
+  unsigned int jpegWidth = 0;
+  unsigned int jpegHeight = 0;
+  m_lowres = 0;
+  if (GetJpegSize(buffer, bufSize, jpegWidth, jpegHeight))
+    m_lowres = GetLowres(jpegWidth, jpegHeight, width, height);
 
   if (!Initialize(buffer, bufSize))
   {
@@ -151,8 +218,16 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
 
   av_frame_free(&m_pFrame);
   m_pFrame = ExtractFrame();
+  if (!m_pFrame)
+    return false;
 
-  return !(m_pFrame == nullptr);
+  if (m_lowres > 0)
+  {
+    m_originalWidth = jpegWidth;
+    m_originalHeight = jpegHeight;
+  }
+
+  return true;
 }
 
 bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
@@ -260,6 +335,9 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
     return false;
   }
 
+  if (m_lowres > 0 && codec->id == AV_CODEC_ID_MJPEG)
+    m_codec_ctx->lowres = m_lowres;
+
   if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
   {
     avformat_close_input(&m_fctx);
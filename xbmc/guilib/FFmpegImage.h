@@ -92,4 +92,6 @@ private:
 
   AVFrame* m_pFrame;
   uint8_t* m_outputBuffer;
+
+  int m_lowres = 0; ///< power of 2 to reduce JPEG images by while decoding
 };
@@ -723,6 +723,15 @@ int CGUIBaseContainer::GetSelectedItem() const
   return CorrectOffset(GetOffset(), GetCursor());
 }
 
+void CGUIBaseContainer::GetViewport(int& first, int& count, int& direction) const
+{
+  // use the offset we're scrolling to rather than the one currently shown
+  const int numItems = static_cast<int>(GetNumItems());
+  first = std::max(0, std::min(GetItemOffset(), numItems));
+  count = std::max(0, std::min(CorrectOffset(GetOffset() + m_itemsPerPage, 0), numItems) - first);
+  direction = ScrollingDown() ? 1 : ScrollingUp() ? -1 : 0;
+}
+
 CGUIListItemPtr CGUIBaseContainer::GetListItem(int offset, unsigned int flag) const
 {
   if (!m_items.size() || !m_layout)
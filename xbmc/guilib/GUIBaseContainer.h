@@ -62,6 +62,13 @@ public:
   void SaveStates(std::vector<CControlState> &states) override;
   virtual int GetSelectedItem() const;
 
+  /*! \brief Get the items shown and the direction the container is scrolling in
+   \param first [out] index of the first item shown
+   \param count [out] number of items shown
+   \param direction [out] 1 when scrolling down, -1 when scrolling up, 0 otherwise
+   */
+  void GetViewport(int& first, int& count, int& direction) const;
+
   void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions) override;
   void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions) override;
 
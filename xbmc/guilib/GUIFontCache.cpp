@@ -9,6 +9,7 @@
 #include "GUIFontTTF.h"
 #include "windowing/GraphicContext.h"
 
+#include <mutex>
 #include <stdint.h>
 #include <vector>
 
@@ -17,7 +18,17 @@ using namespace std::chrono_literals;
 namespace
 {
 constexpr auto FONT_CACHE_TIME_LIMIT = 1000ms;
+constexpr size_t FONT_CACHE_DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+template<class Position, class Value>
+size_t GetEntrySize(const CGUIFontCacheKey<Position>& key)
+{
+  // every character is rendered as a quad
+  return sizeof(CGUIFontCacheEntry<Position, Value>) +
+         key.m_text.size() * (sizeof(character_t) + 4 * sizeof(SVertex)) +
+         key.m_colors.size() * sizeof(UTILS::COLOR::Color);
 }
+} // unnamed namespace
 
 template<class Position, class Value>
 class CGUIFontCacheImpl
@@ -26,23 +37,27 @@ class CGUIFontCacheImpl
   {
     using HashMap = std::multimap<size_t, std::unique_ptr<CGUIFontCacheEntry<Position, Value>>>;
     using HashIter = typename HashMap::iterator;
-    using AgeMap = std::multimap<std::chrono::steady_clock::time_point, HashIter>;
 
     ~EntryList() { Flush(); }
 
     HashIter Insert(size_t hash, std::unique_ptr<CGUIFontCacheEntry<Position, Value>> v)
     {
-      auto r(hashMap.insert(typename HashMap::value_type(hash, std::move(v))));
-      if (r->second)
-        ageMap.insert(typename AgeMap::value_type(r->second->m_lastUsed, r));
-
-      return r;
+      return hashMap.insert(typename HashMap::value_type(hash, std::move(v)));
     }
-    void Flush()
+    void Remove(const CGUIFontCacheEntry<Position, Value>* entry)
     {
-      ageMap.clear();
-      hashMap.clear();
+      CGUIFontCacheHash<Position> hashGen;
+      auto range = hashMap.equal_range(hashGen(entry->m_key));
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second.get() == entry)
+        {
+          hashMap.erase(it);
+          return;
+        }
+      }
     }
+    void Flush() { hashMap.clear(); }
     typename HashMap::iterator FindKey(CGUIFontCacheKey<Position> key)
     {
       CGUIFontCacheHash<Position> hashGen;
@@ -58,30 +73,13 @@ class CGUIFontCacheImpl
 
       return hashMap.end();
     }
-    void UpdateAge(HashIter it, std::chrono::steady_clock::time_point now)
-    {
-      auto range = ageMap.equal_range(it->second->m_lastUsed);
-      for (auto ageit = range.first; ageit != range.second; ++ageit)
-      {
-        if (ageit->second == it)
-        {
-          ageMap.erase(ageit);
-          ageMap.insert(typename AgeMap::value_type(now, it));
-          it->second->m_lastUsed = now;
-          return;
-        }
-      }
-    }
 
     HashMap hashMap;
-    AgeMap ageMap;
   };
 
   EntryList m_list;
-  CGUIFontCache<Position, Value>* m_parent;
 
 public:
-  explicit CGUIFontCacheImpl(CGUIFontCache<Position, Value>* parent) : m_parent(parent) {}
   Value& Lookup(const CGraphicContext& context,
                 Position& pos,
                 const std::vector<UTILS::COLOR::Color>& colors,
@@ -91,9 +89,86 @@ public:
                 bool scrolling,
                 std::chrono::steady_clock::time_point now,
                 bool& dirtyCache);
+  void Remove(const CGUIFontCacheEntry<Position, Value>* entry) { m_list.Remove(entry); }
   void Flush();
 };
 
+CGUIFontCacheEntryBase::~CGUIFontCacheEntryBase()
+{
+  CGUIFontCacheBudget::GetInstance().Remove(*this);
+}
+
+CGUIFontCacheBudget::CGUIFontCacheBudget() : m_budget(FONT_CACHE_DEFAULT_BUDGET)
+{
+}
+
+CGUIFontCacheBudget& CGUIFontCacheBudget::GetInstance()
+{
+  // never destroyed, the fonts may outlive any other static object
+  static CGUIFontCacheBudget* budget = new CGUIFontCacheBudget;
+  return *budget;
+}
+
+void CGUIFontCacheBudget::SetBudget(size_t bytes)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_budget = bytes;
+}
+
+CGUIFontCacheBudget::Statistics CGUIFontCacheBudget::GetStatistics() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  Statistics stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.evictions = m_evictions;
+  stats.entries = m_entries.size();
+  stats.size = m_size;
+  stats.budget = m_budget;
+  return stats;
+}
+
+void CGUIFontCacheBudget::Add(CGUIFontCacheEntryBase& entry,
+                              std::chrono::steady_clock::time_point now)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  entry.m_lruPos = m_entries.insert(m_entries.end(), &entry);
+  m_size += entry.m_size;
+  m_misses++;
+
+  while (m_size > m_budget)
+  {
+    CGUIFontCacheEntryBase* oldest = m_entries.front();
+    if (now - oldest->m_lastUsed <= FONT_CACHE_TIME_LIMIT)
+      break;
+
+    // removes the entry from m_entries through its destructor
+    oldest->Evict();
+    m_evictions++;
+  }
+}
+
+void CGUIFontCacheBudget::Use(CGUIFontCacheEntryBase& entry,
+                              std::chrono::steady_clock::time_point now)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_entries.splice(m_entries.end(), m_entries, entry.m_lruPos);
+  entry.m_lastUsed = now;
+
+  // the font looks a new entry up a second time to store its vertices, that's no hit
+  if (entry.m_filled)
+    m_hits++;
+  else
+    entry.m_filled = true;
+}
+
+void CGUIFontCacheBudget::Remove(CGUIFontCacheEntryBase& entry)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_entries.erase(entry.m_lruPos);
+  m_size -= entry.m_size;
+}
+
 template<class Position, class Value>
 CGUIFontCacheEntry<Position, Value>::~CGUIFontCacheEntry()
 {
@@ -103,25 +178,14 @@ CGUIFontCacheEntry<Position, Value>::~CGUIFontCacheEntry()
 }
 
 template<class Position, class Value>
-void CGUIFontCacheEntry<Position, Value>::Assign(const CGUIFontCacheKey<Position>& key,
-                                                 std::chrono::steady_clock::time_point now)
+void CGUIFontCacheEntry<Position, Value>::Evict()
 {
-  m_key.m_pos = key.m_pos;
-  m_key.m_colors.assign(key.m_colors.begin(), key.m_colors.end());
-  m_key.m_text.assign(key.m_text.begin(), key.m_text.end());
-  m_key.m_alignment = key.m_alignment;
-  m_key.m_maxPixelWidth = key.m_maxPixelWidth;
-  m_key.m_scrolling = key.m_scrolling;
-  m_matrix = key.m_matrix;
-  m_key.m_scaleX = key.m_scaleX;
-  m_key.m_scaleY = key.m_scaleY;
-  m_lastUsed = now;
-  m_value.clear();
+  m_cache.Remove(this);
 }
 
 template<class Position, class Value>
 CGUIFontCache<Position, Value>::CGUIFontCache(CGUIFontTTF& font)
-  : m_impl(std::make_unique<CGUIFontCacheImpl<Position, Value>>(this)), m_font(font)
+  : m_impl(std::make_unique<CGUIFontCacheImpl<Position, Value>>()), m_font(font)
 {
 }
 
@@ -140,7 +204,7 @@ Value& CGUIFontCache<Position, Value>::Lookup(const CGraphicContext& context,
                                               bool& dirtyCache)
 {
   if (!m_impl)
-    m_impl = std::make_unique<CGUIFontCacheImpl<Position, Value>>(this);
+    m_impl = std::make_unique<CGUIFontCacheImpl<Position, Value>>();
 
   return m_impl->Lookup(context, pos, colors, text, alignment, maxPixelWidth, scrolling, now,
                         dirtyCache);
@@ -167,27 +231,14 @@ Value& CGUIFontCacheImpl<Position, Value>::Lookup(const CGraphicContext& context
   {
     // Cache miss
     dirtyCache = true;
-    std::unique_ptr<CGUIFontCacheEntry<Position, Value>> entry;
-
-    if (!m_list.ageMap.empty())
-    {
-      const auto duration =
-          std::chrono::duration_cast<std::chrono::milliseconds>(now - m_list.ageMap.begin()->first);
-      if (duration > FONT_CACHE_TIME_LIMIT)
-      {
-        entry = std::move(m_list.ageMap.begin()->second->second);
-        m_list.hashMap.erase(m_list.ageMap.begin()->second);
-        m_list.ageMap.erase(m_list.ageMap.begin());
-      }
-    }
 
-    // add new entry
+    // add new entry, this may evict old entries of any font
     CGUIFontCacheHash<Position> hashgen;
-    if (!entry)
-      entry = std::make_unique<CGUIFontCacheEntry<Position, Value>>(*m_parent, key, now);
-    else
-      entry->Assign(key, now);
-    return m_list.Insert(hashgen(key), std::move(entry))->second->m_value;
+    auto entry = std::make_unique<CGUIFontCacheEntry<Position, Value>>(*this, key, now);
+    entry->m_size = GetEntrySize<Position, Value>(key);
+    auto it = m_list.Insert(hashgen(key), std::move(entry));
+    CGUIFontCacheBudget::GetInstance().Add(*it->second, now);
+    return it->second->m_value;
   }
   else
   {
@@ -197,7 +248,7 @@ Value& CGUIFontCacheImpl<Position, Value>::Lookup(const CGraphicContext& context
     pos.UpdateWithOffsets(i->second->m_key.m_pos, scrolling);
 
     // Update time in entry and move to the back of the list
-    m_list.UpdateAge(i, now);
+    CGUIFontCacheBudget::GetInstance().Use(*i->second, now);
 
     dirtyCache = false;
 
@@ -13,6 +13,7 @@
 \brief
 */
 
+#include "threads/CriticalSection.h"
 #include "utils/ColorUtils.h"
 #include "utils/TransformMatrix.h"
 
@@ -21,6 +22,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstring>
+#include <list>
 #include <memory>
 #include <stdint.h>
 #include <vector>
@@ -71,19 +73,87 @@ struct CGUIFontCacheKey
   }
 };
 
+/*!
+ \brief The part of a font cache entry that is accounted by CGUIFontCacheBudget
+ */
+struct CGUIFontCacheEntryBase
+{
+  explicit CGUIFontCacheEntryBase(std::chrono::steady_clock::time_point now) : m_lastUsed(now) {}
+  virtual ~CGUIFontCacheEntryBase();
+
+  /*!
+   \brief Remove the entry from the cache of its font, this destroys the entry
+   */
+  virtual void Evict() = 0;
+
+  std::chrono::steady_clock::time_point m_lastUsed;
+  size_t m_size = 0; ///< estimated memory used by the entry in bytes
+  bool m_filled = false; ///< the font has looked the entry up again to store its vertices
+  std::list<CGUIFontCacheEntryBase*>::iterator m_lruPos;
+};
+
+/*!
+ \brief The memory budget shared by the vertex caches of all fonts
+
+ The entries of all font caches are kept in a single least recently used order.
+ While the cached vertices exceed the budget, the oldest entries are evicted,
+ whichever font they belong to. Entries used within the last second may still
+ be referenced by a batch that hasn't been rendered yet and are never evicted,
+ so the budget can be exceeded for a moment when a lot of new text is shown.
+
+ Like the font caches themselves, this relies on fonts being rendered and
+ unloaded by the rendering thread only.
+ */
+class CGUIFontCacheBudget
+{
+public:
+  struct Statistics
+  {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t size = 0; ///< estimated memory used by all entries in bytes
+    size_t budget = 0;
+  };
+
+  static CGUIFontCacheBudget& GetInstance();
+
+  void SetBudget(size_t bytes);
+  Statistics GetStatistics() const;
+
+  /*!
+   \brief Account a new entry and evict old entries while the budget is exceeded
+   */
+  void Add(CGUIFontCacheEntryBase& entry, std::chrono::steady_clock::time_point now);
+  void Use(CGUIFontCacheEntryBase& entry, std::chrono::steady_clock::time_point now);
+  void Remove(CGUIFontCacheEntryBase& entry);
+
+private:
+  CGUIFontCacheBudget();
+
+  mutable CCriticalSection m_critSection;
+  std::list<CGUIFontCacheEntryBase*> m_entries; ///< least recently used first
+  size_t m_size = 0;
+  size_t m_budget;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  uint64_t m_evictions = 0;
+};
+
 template<class Position, class Value>
-struct CGUIFontCacheEntry
+struct CGUIFontCacheEntry : public CGUIFontCacheEntryBase
 {
-  const CGUIFontCache<Position, Value>& m_cache;
+  CGUIFontCacheImpl<Position, Value>& m_cache;
   CGUIFontCacheKey<Position> m_key;
   TransformMatrix m_matrix;
-  std::chrono::steady_clock::time_point m_lastUsed;
   Value m_value;
 
-  CGUIFontCacheEntry(const CGUIFontCache<Position, Value>& cache,
+  CGUIFontCacheEntry(CGUIFontCacheImpl<Position, Value>& cache,
                      const CGUIFontCacheKey<Position>& key,
                      std::chrono::steady_clock::time_point now)
-    : m_cache(cache),
+    : CGUIFontCacheEntryBase(now),
+      m_cache(cache),
       m_key(key.m_pos,
             *new std::vector<UTILS::COLOR::Color>,
             *new vecText,
@@ -92,17 +162,16 @@ struct CGUIFontCacheEntry
             key.m_scrolling,
             m_matrix,
             key.m_scaleX,
-            key.m_scaleY),
-      m_lastUsed(now)
+            key.m_scaleY)
   {
     m_key.m_colors.assign(key.m_colors.begin(), key.m_colors.end());
     m_key.m_text.assign(key.m_text.begin(), key.m_text.end());
     m_matrix = key.m_matrix;
   }
 
-  ~CGUIFontCacheEntry();
+  ~CGUIFontCacheEntry() override;
 
-  void Assign(const CGUIFontCacheKey<Position>& key, std::chrono::steady_clock::time_point now);
+  void Evict() override;
 };
 
 template<class Position>
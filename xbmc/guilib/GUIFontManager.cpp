@@ -30,6 +30,8 @@
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "filesystem/Directory.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingDefinitions.h"
 #include "utils/FileUtils.h"
@@ -426,6 +428,11 @@ void GUIFontManager::LoadFonts(const std::string& fontSet)
   const std::string filePath = g_SkinInfo->GetSkinPath("Font.xml", &m_skinResolution);
   CLog::LogF(LOGINFO, "Loading fonts from '{}'", filePath);
 
+  CGUIFontCacheBudget::GetInstance().SetBudget(
+      static_cast<size_t>(
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiFontCacheSize) *
+      1024 * 1024);
+
   CXBMCTinyXML xmlDoc;
   if (!LoadXMLData(filePath, xmlDoc))
     return;
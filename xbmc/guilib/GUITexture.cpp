@@ -187,6 +187,7 @@ void CGUITexture::Render()
   color = CServiceBroker::GetWinSystem()->GetGfxContext().MergeColor(color);
 
   // setup our renderer
+  CServiceBroker::GetGUI()->GetTextureManager().CountBind(m_texture.m_textures[m_currentFrame].get());
   Begin(color);
 
   // compute the texture coordinates
@@ -268,6 +269,16 @@ void CGUITexture::Render(float left,
   int orientation = GetOrientation();
   OrientateTexture(texture, u3, v3, orientation);
 
+  // move into the image's place in a texture atlas
+  if (m_texture.m_texOffsetX || m_texture.m_texOffsetY)
+  {
+    if (m_texture.m_texCoordsArePixels)
+      texture += CPoint(m_texture.m_texOffsetX, m_texture.m_texOffsetY);
+    else
+      texture += CPoint(m_texture.m_texOffsetX * m_texCoordsScaleU,
+                        m_texture.m_texOffsetY * m_texCoordsScaleV);
+  }
+
   if (m_diffuse.size())
   {
     // flip the texture as necessary.  Diffuse just gets flipped according to m_info.orientation.
@@ -276,6 +287,15 @@ void CGUITexture::Render(float left,
     diffuse.y1 *= m_diffuseScaleV / v3; diffuse.y2 *= m_diffuseScaleV / v3;
     diffuse += m_diffuseOffset;
     OrientateTexture(diffuse, m_diffuseU, m_diffuseV, m_info.orientation);
+
+    if (m_diffuse.m_texOffsetX || m_diffuse.m_texOffsetY)
+    {
+      if (m_diffuse.m_texCoordsArePixels)
+        diffuse += CPoint(m_diffuse.m_texOffsetX, m_diffuse.m_texOffsetY);
+      else
+        diffuse += CPoint(static_cast<float>(m_diffuse.m_texOffsetX) / m_diffuse.m_texWidth,
+                          static_cast<float>(m_diffuse.m_texOffsetY) / m_diffuse.m_texHeight);
+    }
   }
 
   float x[4], y[4], z[4];
@@ -245,10 +245,8 @@ bool CTexture::LoadFromFileInternal(const std::string& texturePath,
   { // special case for DDS images
     CDDSImage image;
     if (image.ReadFile(texturePath))
-    {
-      Update(image.GetWidth(), image.GetHeight(), 0, image.GetFormat(), image.GetData(), false);
-      return true;
-    }
+      return LoadFromMemory(image.GetWidth(), image.GetHeight(), 0, image.GetFormat(),
+                            image.HasAlpha(), image.GetData());
     return false;
   }
 
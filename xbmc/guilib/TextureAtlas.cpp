@@ -0,0 +1,248 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureAtlas.h"
+
+#include "Texture.h"
+#include "TextureBundle.h"
+#include "XBTF.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+// icons, flags and button states, larger textures gain little from sharing a texture
+constexpr unsigned int MAX_IMAGE_SIZE = 128;
+constexpr unsigned int PADDING = 1;
+// the atlases stay loaded as long as the skin, don't let them grow without bounds
+constexpr size_t MAX_ATLASES = 4;
+
+struct Candidate
+{
+  std::string name;
+  size_t bundle;
+  unsigned int width;
+  unsigned int height;
+};
+
+struct Placement
+{
+  const Candidate* candidate;
+  unsigned int x;
+  unsigned int y;
+};
+} // unnamed namespace
+
+CTextureAtlasPacker::CTextureAtlasPacker(unsigned int width,
+                                         unsigned int height,
+                                         unsigned int padding)
+  : m_width(width), m_height(height), m_padding(padding)
+{
+}
+
+bool CTextureAtlasPacker::Insert(unsigned int width,
+                                 unsigned int height,
+                                 unsigned int& x,
+                                 unsigned int& y)
+{
+  const unsigned int paddedWidth = width + 2 * m_padding;
+  const unsigned int paddedHeight = height + 2 * m_padding;
+  if (paddedWidth > m_width)
+    return false;
+
+  // use the shelf with room that wastes the least height
+  Shelf* best = nullptr;
+  for (Shelf& shelf : m_shelves)
+  {
+    if (shelf.height >= paddedHeight && shelf.used + paddedWidth <= m_width &&
+        (!best || shelf.height < best->height))
+      best = &shelf;
+  }
+
+  if (!best)
+  {
+    const unsigned int top = GetUsedHeight();
+    if (top + paddedHeight > m_height)
+      return false;
+
+    m_shelves.push_back({top, paddedHeight, 0});
+    best = &m_shelves.back();
+  }
+
+  x = best->used + m_padding;
+  y = best->y + m_padding;
+  best->used += paddedWidth;
+  m_usedArea += static_cast<uint64_t>(width) * height;
+
+  return true;
+}
+
+unsigned int CTextureAtlasPacker::GetUsedHeight() const
+{
+  if (m_shelves.empty())
+    return 0;
+
+  return m_shelves.back().y + m_shelves.back().height;
+}
+
+void CTextureAtlas::Build(CTextureBundle* bundles, size_t count, unsigned int maxAtlasSize)
+{
+  Clear();
+
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<Candidate> candidates;
+  for (size_t i = 0; i < count; i++)
+  {
+    for (const CXBTFFile& file : bundles[i].GetAtlasCandidates(MAX_IMAGE_SIZE))
+    {
+      // animations are loaded frame by frame
+      if (StringUtils::EndsWithNoCase(file.GetPath(), ".gif"))
+        continue;
+
+      // the texture manager loads a texture from the first bundle that has it
+      bool overridden = false;
+      for (size_t j = 0; j < i && !overridden; j++)
+        overridden = bundles[j].HasFile(file.GetPath());
+
+      if (!overridden)
+        candidates.push_back({file.GetPath(), i, file.GetFrames().front().GetWidth(),
+                              file.GetFrames().front().GetHeight()});
+    }
+  }
+
+  if (candidates.empty())
+    return;
+
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    if (a.height != b.height)
+      return a.height > b.height;
+    if (a.width != b.width)
+      return a.width > b.width;
+    return a.name < b.name;
+  });
+
+  const size_t total = candidates.size();
+  uint64_t usedArea = 0;
+  std::vector<uint8_t> pixels;
+  while (!candidates.empty() && m_atlases.size() < MAX_ATLASES)
+  {
+    CTextureAtlasPacker packer(maxAtlasSize, maxAtlasSize, PADDING);
+
+    std::vector<Placement> placements;
+    std::vector<Candidate> remaining;
+    for (const Candidate& candidate : candidates)
+    {
+      unsigned int x, y;
+      if (packer.Insert(candidate.width, candidate.height, x, y))
+        placements.push_back({&candidate, x, y});
+      else
+        remaining.push_back(candidate);
+    }
+
+    if (placements.empty())
+      break;
+
+    const unsigned int width = packer.GetWidth();
+    const unsigned int height = packer.GetUsedHeight();
+    std::vector<uint8_t> atlasPixels(static_cast<size_t>(width) * height * 4);
+
+    bool atlasHasAlpha = false;
+    std::vector<std::pair<std::string, Entry>> entries;
+    for (const Placement& placement : placements)
+    {
+      const Candidate& candidate = *placement.candidate;
+      unsigned int imageWidth, imageHeight;
+      bool hasAlpha;
+      if (!bundles[candidate.bundle].LoadPixels(candidate.name, pixels, imageWidth, imageHeight,
+                                                hasAlpha) ||
+          imageWidth != candidate.width || imageHeight != candidate.height)
+        continue;
+
+      CopyImage(atlasPixels.data(), width * 4, placement.x, placement.y, pixels.data(), imageWidth,
+                imageHeight, PADDING);
+      atlasHasAlpha |= hasAlpha;
+      entries.emplace_back(candidate.name,
+                           Entry{nullptr, placement.x, placement.y, imageWidth, imageHeight});
+    }
+
+    std::shared_ptr<CTexture> texture = CTexture::CreateTexture();
+    if (!texture || !texture->LoadFromMemory(width, height, width * 4, XB_FMT_A8R8G8B8,
+                                             atlasHasAlpha, atlasPixels.data()))
+    {
+      CLog::Log(LOGERROR, "{} - unable to create a {}x{} texture atlas", __FUNCTION__, width,
+                height);
+      break;
+    }
+
+    for (auto& entry : entries)
+    {
+      entry.second.texture = texture;
+      m_entries.emplace(std::move(entry.first), std::move(entry.second));
+    }
+
+    m_memUsage += static_cast<uint64_t>(texture->GetTextureWidth()) *
+                  texture->GetTextureHeight() * 4;
+    usedArea += packer.GetUsedArea();
+    m_atlases.push_back(std::move(texture));
+
+    candidates = std::move(remaining);
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  CLog::Log(LOGINFO,
+            "{} - packed {} of {} textures into {} atlases ({} KiB, {:.0f}% used) in {} ms",
+            __FUNCTION__, m_entries.size(), total, m_atlases.size(), m_memUsage / 1024,
+            m_memUsage ? usedArea * 4 * 100.0 / m_memUsage : 0.0,
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+void CTextureAtlas::Clear()
+{
+  m_entries.clear();
+  m_atlases.clear();
+  m_memUsage = 0;
+}
+
+const CTextureAtlas::Entry* CTextureAtlas::Get(const std::string& name) const
+{
+  const auto it = m_entries.find(name);
+  if (it == m_entries.end())
+    return nullptr;
+
+  return &it->second;
+}
+
+void CTextureAtlas::CopyImage(uint8_t* dest,
+                              unsigned int destPitch,
+                              unsigned int x,
+                              unsigned int y,
+                              const uint8_t* src,
+                              unsigned int width,
+                              unsigned int height,
+                              unsigned int padding)
+{
+  const int rows = static_cast<int>(height + padding);
+  for (int row = -static_cast<int>(padding); row < rows; row++)
+  {
+    const int srcRow = std::min(std::max(row, 0), static_cast<int>(height) - 1);
+    const uint8_t* srcLine = src + static_cast<size_t>(srcRow) * width * 4;
+    uint8_t* destLine = dest + static_cast<size_t>(static_cast<int>(y) + row) * destPitch + x * 4;
+
+    std::memcpy(destLine, srcLine, width * 4);
+    for (unsigned int i = 1; i <= padding; i++)
+    {
+      std::memcpy(destLine - i * 4, srcLine, 4);
+      std::memcpy(destLine + (width - 1 + i) * 4, srcLine + (width - 1) * 4, 4);
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CTexture;
+class CTextureBundle;
+
+/*!
+ \ingroup textures
+ \brief Places images on the shelves (rows) of a texture atlas.
+
+ Images should be inserted sorted by decreasing height to waste little space.
+ Each image is surrounded by padding pixels to keep linear filtering from
+ sampling its neighbours.
+ */
+class CTextureAtlasPacker
+{
+public:
+  CTextureAtlasPacker(unsigned int width, unsigned int height, unsigned int padding);
+
+  /*!
+   * \brief Reserve the space for an image in the atlas
+   * \param width width of the image
+   * \param height height of the image
+   * \param[out] x horizontal position of the image in the atlas
+   * \param[out] y vertical position of the image in the atlas
+   * \return false if the image doesn't fit into the atlas any more
+   */
+  bool Insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y);
+
+  unsigned int GetWidth() const { return m_width; }
+  unsigned int GetUsedHeight() const; ///< height of the atlas that is actually used
+  uint64_t GetUsedArea() const { return m_usedArea; } ///< pixels covered by images
+
+private:
+  struct Shelf
+  {
+    unsigned int y;
+    unsigned int height;
+    unsigned int used;
+  };
+
+  unsigned int m_width;
+  unsigned int m_height;
+  unsigned int m_padding;
+  std::vector<Shelf> m_shelves;
+  uint64_t m_usedArea = 0;
+};
+
+/*!
+ \ingroup textures
+ \brief The small textures of the skin's texture bundles packed into a few shared textures.
+
+ Skins use hundreds of small icons, flags and button states. Packing them into
+ atlases saves the texture switches between them when rendering.
+ */
+class CTextureAtlas
+{
+public:
+  struct Entry
+  {
+    std::shared_ptr<CTexture> texture;
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+    unsigned int height;
+  };
+
+  /*!
+   * \brief Pack the small textures of the bundles, the first bundle takes precedence
+   * \param bundles the texture bundles
+   * \param count number of bundles
+   * \param maxAtlasSize maximum width and height of an atlas
+   */
+  void Build(CTextureBundle* bundles, size_t count, unsigned int maxAtlasSize);
+  void Clear();
+
+  /*!
+   * \brief Get the place of a texture in the atlases
+   * \param name the normalized name of the texture in the bundle
+   * \return the entry or nullptr if the texture wasn't packed
+   */
+  const Entry* Get(const std::string& name) const;
+
+  unsigned int GetAtlasCount() const { return static_cast<unsigned int>(m_atlases.size()); }
+  unsigned int GetTextureCount() const { return static_cast<unsigned int>(m_entries.size()); }
+  uint64_t GetMemoryUsage() const { return m_memUsage; }
+
+  /*!
+   * \brief Copy an A8R8G8B8 image into the atlas and repeat its edge pixels into the padding
+   * \param dest the pixels of the atlas
+   * \param destPitch bytes per row of the atlas
+   * \param x horizontal position of the image in the atlas
+   * \param y vertical position of the image in the atlas
+   * \param src the pixels of the image, rows of width * 4 bytes
+   * \param width width of the image
+   * \param height height of the image
+   * \param padding number of padding pixels around the image
+   */
+  static void CopyImage(uint8_t* dest,
+                        unsigned int destPitch,
+                        unsigned int x,
+                        unsigned int y,
+                        const uint8_t* src,
+                        unsigned int width,
+                        unsigned int height,
+                        unsigned int padding);
+
+private:
+  std::vector<std::shared_ptr<CTexture>> m_atlases;
+  std::unordered_map<std::string, Entry> m_entries;
+  uint64_t m_memUsage = 0;
+};
@@ -9,6 +9,7 @@
 #include "TextureBundle.h"
 
 #include "guilib/TextureBundleXBT.h"
+#include "guilib/XBTF.h"
 
 class CTexture;
 
@@ -67,6 +68,27 @@ bool CTextureBundle::LoadAnim(const std::string& filename,
     return false;
 }
 
+std::vector<CXBTFFile> CTextureBundle::GetAtlasCandidates(unsigned int maxSize)
+{
+  std::vector<CXBTFFile> files = m_tbXBT.GetAtlasCandidates(maxSize);
+  if (!files.empty())
+    m_useXBT = true;
+
+  return files;
+}
+
+bool CTextureBundle::LoadPixels(const std::string& filename,
+                                std::vector<uint8_t>& pixels,
+                                unsigned int& width,
+                                unsigned int& height,
+                                bool& hasAlpha)
+{
+  if (m_useXBT)
+    return m_tbXBT.LoadPixels(filename, pixels, width, height, hasAlpha);
+  else
+    return false;
+}
+
 void CTextureBundle::Close()
 {
   m_tbXBT.CloseBundle();
@@ -10,6 +10,7 @@
 
 #include "TextureBundleXBT.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -66,6 +67,30 @@ public:
                 int& width,
                 int& height,
                 int& nLoops);
+
+  /*!
+   * \brief Get the textures of the bundle that can be packed into a texture atlas
+   *
+   * \param[in] maxSize the maximum width and height of a texture
+   * \return the single frame A8R8G8B8 textures not larger than maxSize x maxSize
+   */
+  std::vector<CXBTFFile> GetAtlasCandidates(unsigned int maxSize);
+
+  /*!
+   * \brief Load the pixels of an A8R8G8B8 texture from bundle
+   *
+   * \param[in] filename name of the texture to load
+   * \param[out] pixels the pixels of the texture, rows of width * 4 bytes
+   * \param[out] width width of the texture
+   * \param[out] height height of the texture
+   * \param[out] hasAlpha whether the texture has an alpha channel
+   * \return true if the pixels were loaded
+   */
+  bool LoadPixels(const std::string& filename,
+                  std::vector<uint8_t>& pixels,
+                  unsigned int& width,
+                  unsigned int& height,
+                  bool& hasAlpha);
   void Close();
 private:
   CTextureBundleXBT m_tbXBT;
@@ -210,6 +210,57 @@ bool CTextureBundleXBT::LoadAnim(const std::string& filename,
   return true;
 }
 
+std::vector<CXBTFFile> CTextureBundleXBT::GetAtlasCandidates(unsigned int maxSize)
+{
+  if ((m_XBTFReader == nullptr || !m_XBTFReader->IsOpen()) && !OpenBundle())
+    return {};
+
+  std::vector<CXBTFFile> files;
+  for (const CXBTFFile& file : m_XBTFReader->GetFiles())
+  {
+    // animations and compressed (DXT) textures stay separate textures
+    if (file.GetFrames().size() != 1)
+      continue;
+
+    const CXBTFFrame& frame = file.GetFrames().front();
+    if (frame.GetFormat() == XB_FMT_A8R8G8B8 && frame.GetWidth() <= maxSize &&
+        frame.GetHeight() <= maxSize)
+      files.push_back(file);
+  }
+
+  return files;
+}
+
+bool CTextureBundleXBT::LoadPixels(const std::string& filename,
+                                   std::vector<uint8_t>& pixels,
+                                   unsigned int& width,
+                                   unsigned int& height,
+                                   bool& hasAlpha)
+{
+  std::string name = Normalize(filename);
+
+  CXBTFFile file;
+  if (!m_XBTFReader->Get(name, file) || file.GetFrames().empty())
+    return false;
+
+  const CXBTFFrame& frame = file.GetFrames().front();
+  if (frame.GetFormat() != XB_FMT_A8R8G8B8)
+    return false;
+
+  pixels = UnpackFrame(*m_XBTFReader, frame);
+  if (pixels.size() != static_cast<size_t>(frame.GetWidth()) * frame.GetHeight() * 4)
+  {
+    CLog::Log(LOGERROR, "Error loading texture: {}", filename);
+    return false;
+  }
+
+  width = frame.GetWidth();
+  height = frame.GetHeight();
+  hasAlpha = frame.HasAlpha();
+
+  return true;
+}
+
 bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name,
                                               const CXBTFFrame& frame,
                                               std::unique_ptr<CTexture>& texture)
@@ -18,6 +18,7 @@
 class CTexture;
 class CXBTFReader;
 class CXBTFFrame;
+class CXBTFFile;
 
 class CTextureBundleXBT
 {
@@ -48,6 +49,20 @@ public:
                 int& height,
                 int& nLoops);
 
+  /*!
+   * \brief See CTextureBundle::GetAtlasCandidates
+   */
+  std::vector<CXBTFFile> GetAtlasCandidates(unsigned int maxSize);
+
+  /*!
+   * \brief See CTextureBundle::LoadPixels
+   */
+  bool LoadPixels(const std::string& filename,
+                  std::vector<uint8_t>& pixels,
+                  unsigned int& width,
+                  unsigned int& height,
+                  bool& hasAlpha);
+
   //! @todo Change return to std::optional<std::vector<uint8_t>>> when c++17 is allowed
   static std::vector<uint8_t> UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
 
@@ -16,6 +16,9 @@
 #include "filesystem/File.h"
 #include "guilib/TextureBundle.h"
 #include "guilib/TextureFormats.h"
+#include "rendering/RenderSystem.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
@@ -45,6 +48,12 @@
 #include <cassert>
 #include <exception>
 
+namespace
+{
+// large enough for the small textures of a skin, limited to the maximum texture size of the GPU
+constexpr unsigned int MAX_ATLAS_SIZE = 2048;
+} // unnamed namespace
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -56,6 +65,8 @@ CTextureArray::CTextureArray(int width, int height, int loops,  bool texCoordsAr
   m_orientation = 0;
   m_texWidth = 0;
   m_texHeight = 0;
+  m_texOffsetX = 0;
+  m_texOffsetY = 0;
   m_texCoordsArePixels = false;
 }
 
@@ -82,6 +93,8 @@ void CTextureArray::Reset()
   m_orientation = 0;
   m_texWidth = 0;
   m_texHeight = 0;
+  m_texOffsetX = 0;
+  m_texOffsetY = 0;
   m_texCoordsArePixels = false;
 }
 
@@ -177,6 +190,11 @@ unsigned int CTextureMap::GetMemoryUsage() const
   return m_memUsage;
 }
 
+unsigned int CTextureMap::GetTextureCount() const
+{
+  return m_atlasImage ? 0 : m_texture.size();
+}
+
 void CTextureMap::Flush()
 {
   if (!m_referenceCount)
@@ -212,6 +230,15 @@ void CTextureMap::Add(std::unique_ptr<CTexture> texture, int delay)
   m_texture.Add(std::move(texture), delay);
 }
 
+void CTextureMap::AddAtlasImage(const CTextureAtlas::Entry& entry)
+{
+  // the memory is accounted to the atlas
+  m_atlasImage = true;
+  m_texture.Add(entry.texture, 100);
+  m_texture.m_texOffsetX = static_cast<int>(entry.x);
+  m_texture.m_texOffsetY = static_cast<int>(entry.y);
+}
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -337,6 +364,14 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
   const auto start = std::chrono::steady_clock::now();
 #endif
 
+  if (bundle >= 0 && !m_atlasBuilt)
+  {
+    m_atlasBuilt = true;
+    if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureAtlas)
+      m_atlas.Build(m_TexBundle, 2,
+                    std::min(MAX_ATLAS_SIZE, CServiceBroker::GetRenderSystem()->GetMaxTextureSize()));
+  }
+
   if (bundle >= 0 && StringUtils::EndsWithNoCase(strPath, ".gif"))
   {
     CTextureMap* pMap = nullptr;
@@ -424,6 +459,18 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
     return pMap->GetTexture();
   }
 
+  if (bundle >= 0)
+  {
+    const CTextureAtlas::Entry* entry = m_atlas.Get(CTextureBundle::Normalize(strTextureName));
+    if (entry)
+    {
+      CTextureMap* pMap = new CTextureMap(strTextureName, entry->width, entry->height, 0);
+      pMap->AddAtlasImage(*entry);
+      m_vecTextures.push_back(pMap);
+      return pMap->GetTexture();
+    }
+  }
+
   std::unique_ptr<CTexture> pTexture;
   int width = 0, height = 0;
   if (bundle >= 0)
@@ -542,6 +589,8 @@ void CGUITextureManager::Cleanup()
     delete pMap;
     i = m_vecTextures.erase(i);
   }
+  m_atlas.Clear();
+  m_atlasBuilt = false;
   m_TexBundle[0].Close();
   m_TexBundle[1].Close();
   m_TexBundle[0] = CTextureBundle(true);
@@ -553,6 +602,13 @@ void CGUITextureManager::Dump() const
 {
   CLog::Log(LOGDEBUG, "{0}: total texturemaps size: {1}", __FUNCTION__, m_vecTextures.size());
 
+  const Statistics stats = GetStatistics();
+  CLog::Log(LOGDEBUG,
+            "{}: {} textures ({} images in {} atlases), {} KiB, {} binds and {} texture switches in "
+            "the last rendered frame",
+            __FUNCTION__, stats.textures, stats.atlasImages, stats.atlases, stats.memory / 1024,
+            stats.binds, stats.switches);
+
   for (int i = 0; i < (int)m_vecTextures.size(); ++i)
   {
     const CTextureMap* pMap = m_vecTextures[i];
@@ -590,7 +646,35 @@ unsigned int CGUITextureManager::GetMemoryUsage() const
   {
     memUsage += m_vecTextures[i]->GetMemoryUsage();
   }
-  return memUsage;
+  return memUsage + static_cast<unsigned int>(m_atlas.GetMemoryUsage());
+}
+
+void CGUITextureManager::NewFrame()
+{
+  // keep the numbers of the last frame that was actually rendered
+  if (m_frameBinds > 0)
+  {
+    m_lastFrameBinds = m_frameBinds;
+    m_lastFrameSwitches = m_frameSwitches;
+  }
+  m_frameBinds = 0;
+  m_frameSwitches = 0;
+  m_lastBound = nullptr;
+}
+
+CGUITextureManager::Statistics CGUITextureManager::GetStatistics() const
+{
+  Statistics stats;
+  for (const CTextureMap* pMap : m_vecTextures)
+    stats.textures += pMap->GetTextureCount();
+
+  stats.atlases = m_atlas.GetAtlasCount();
+  stats.atlasImages = m_atlas.GetTextureCount();
+  stats.textures += stats.atlases;
+  stats.memory = GetMemoryUsage();
+  stats.binds = m_lastFrameBinds;
+  stats.switches = m_lastFrameSwitches;
+  return stats;
 }
 
 void CGUITextureManager::SetTexturePath(const std::string &texturePath)
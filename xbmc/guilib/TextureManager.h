@@ -9,6 +9,7 @@
 #pragma once
 
 #include "GUIComponent.h"
+#include "TextureAtlas.h"
 #include "TextureBundle.h"
 #include "threads/CriticalSection.h"
 
@@ -49,6 +50,8 @@ public:
   int m_loops;
   int m_texWidth;
   int m_texHeight;
+  int m_texOffsetX; ///< position of the image within the texture, non zero for atlas images
+  int m_texOffsetY;
   bool m_texCoordsArePixels;
 };
 
@@ -67,12 +70,14 @@ public:
   virtual ~CTextureMap();
 
   void Add(std::unique_ptr<CTexture> texture, int delay);
+  void AddAtlasImage(const CTextureAtlas::Entry& entry);
   bool Release();
 
   const std::string& GetName() const;
   const CTextureArray& GetTexture();
   void Dump() const;
   uint32_t GetMemoryUsage() const;
+  unsigned int GetTextureCount() const; ///< textures owned by the map, atlas images share the atlas
   void Flush();
   bool IsEmpty() const;
   void SetHeight(int height);
@@ -84,6 +89,7 @@ protected:
   std::string m_textureName;
   unsigned int m_referenceCount;
   uint32_t m_memUsage;
+  bool m_atlasImage = false;
 };
 
 /*!
@@ -96,6 +102,16 @@ protected:
 class CGUITextureManager
 {
 public:
+  struct Statistics
+  {
+    unsigned int textures = 0; ///< textures of the loaded skin images, including the atlases
+    unsigned int atlases = 0;
+    unsigned int atlasImages = 0; ///< skin images packed into the atlases
+    uint64_t memory = 0; ///< bytes of the loaded textures
+    unsigned int binds = 0; ///< textures bound by GUI images in the last rendered frame
+    unsigned int switches = 0; ///< binds in that frame that changed the bound texture
+  };
+
   CGUITextureManager(void);
   virtual ~CGUITextureManager(void);
 
@@ -116,6 +132,22 @@ public:
 
   void FreeUnusedTextures(unsigned int timeDelay = 0); ///< Free textures (called from app thread only)
   void ReleaseHwTexture(unsigned int texture);
+
+  /*!
+   * \brief Count a texture bind of a GUI image for the statistics (render thread only)
+   */
+  void CountBind(const CTexture* texture)
+  {
+    m_frameBinds++;
+    if (texture != m_lastBound)
+    {
+      m_frameSwitches++;
+      m_lastBound = texture;
+    }
+  }
+  void NewFrame(); ///< Start counting the binds of the next frame (render thread only)
+  Statistics GetStatistics() const;
+
 protected:
   std::vector<CTextureMap*> m_vecTextures;
   std::list<std::pair<CTextureMap*, std::chrono::time_point<std::chrono::steady_clock>>>
@@ -124,6 +156,15 @@ protected:
   typedef std::vector<CTextureMap*>::iterator ivecTextures;
   // we have 2 texture bundles (one for the base textures, one for the theme)
   CTextureBundle m_TexBundle[2];
+  // the small textures of the bundles, packed when the first bundled texture is loaded
+  CTextureAtlas m_atlas;
+  bool m_atlasBuilt = false;
+
+  const CTexture* m_lastBound = nullptr;
+  unsigned int m_frameBinds = 0;
+  unsigned int m_frameSwitches = 0;
+  unsigned int m_lastFrameBinds = 0;
+  unsigned int m_lastFrameSwitches = 0;
 
   std::vector<std::string> m_texturePaths;
   CCriticalSection m_section;
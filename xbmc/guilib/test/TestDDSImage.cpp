@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/DDSImage.h"
+#include "guilib/XBTF.h"
+#include "test/TestUtils.h"
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+std::vector<unsigned char> CreatePixels(unsigned int width, unsigned int height, unsigned int pitch)
+{
+  std::vector<unsigned char> pixels(pitch * height, 0xcd);
+  for (unsigned int y = 0; y < height; y++)
+  {
+    for (unsigned int x = 0; x < width; x++)
+    {
+      unsigned char* pixel = &pixels[y * pitch + x * 4];
+      pixel[0] = x * 255 / width;
+      pixel[1] = y * 255 / height;
+      pixel[2] = (x + y) & 0xff;
+      pixel[3] = 0xff;
+    }
+  }
+  return pixels;
+}
+} // unnamed namespace
+
+TEST(TestDDSImage, RoundTrip)
+{
+  // odd size with a padded pitch, as textures have
+  constexpr unsigned int WIDTH = 33;
+  constexpr unsigned int HEIGHT = 17;
+  constexpr unsigned int PITCH = 48 * 4;
+  const std::vector<unsigned char> pixels = CreatePixels(WIDTH, HEIGHT, PITCH);
+
+  CFile* file = XBMC_CREATETEMPFILE(".dds");
+  ASSERT_NE(file, nullptr);
+  const std::string path = XBMC_TEMPFILEPATH(file);
+
+  CDDSImage created;
+  ASSERT_TRUE(created.Create(path, WIDTH, HEIGHT, PITCH, pixels.data(), true));
+
+  CDDSImage image;
+  ASSERT_TRUE(image.ReadFile(path));
+  EXPECT_EQ(image.GetWidth(), WIDTH);
+  EXPECT_EQ(image.GetHeight(), HEIGHT);
+  EXPECT_EQ(image.GetFormat(), static_cast<unsigned int>(XB_FMT_A8R8G8B8));
+  EXPECT_EQ(image.GetSize(), WIDTH * HEIGHT * 4);
+  EXPECT_TRUE(image.HasAlpha());
+  for (unsigned int y = 0; y < HEIGHT; y++)
+    EXPECT_EQ(memcmp(image.GetData() + y * WIDTH * 4, &pixels[y * PITCH], WIDTH * 4), 0);
+
+  ASSERT_TRUE(created.Create(path, WIDTH, HEIGHT, PITCH, pixels.data(), false));
+  ASSERT_TRUE(image.ReadFile(path));
+  EXPECT_FALSE(image.HasAlpha());
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestDDSImage, Truncated)
+{
+  constexpr unsigned int SIZE = 64;
+  const std::vector<unsigned char> pixels = CreatePixels(SIZE, SIZE, SIZE * 4);
+
+  CFile* file = XBMC_CREATETEMPFILE(".dds");
+  ASSERT_NE(file, nullptr);
+  const std::string path = XBMC_TEMPFILEPATH(file);
+
+  CDDSImage created;
+  ASSERT_TRUE(created.Create(path, SIZE, SIZE, SIZE * 4, pixels.data(), false));
+
+  std::vector<uint8_t> buffer;
+  ASSERT_GT(CFile().LoadFile(path, buffer), 0);
+  CFile truncated;
+  ASSERT_TRUE(truncated.OpenForWrite(path, true));
+  ASSERT_EQ(truncated.Write(buffer.data(), buffer.size() / 2), static_cast<ssize_t>(buffer.size() / 2));
+  truncated.Close();
+
+  CDDSImage image;
+  EXPECT_FALSE(image.ReadFile(path));
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/FFmpegImage.h"
+#include "guilib/XBTF.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::vector<unsigned char> CreateJpeg(unsigned int width, unsigned int height)
+{
+  std::vector<unsigned char> pixels(width * height * 4);
+  for (unsigned int y = 0; y < height; y++)
+  {
+    for (unsigned int x = 0; x < width; x++)
+    {
+      unsigned char* pixel = &pixels[(y * width + x) * 4];
+      pixel[0] = x * 255 / width;
+      pixel[1] = y * 255 / height;
+      pixel[2] = ((x / 40 + y / 40) & 1) * 200;
+      pixel[3] = 0xff;
+    }
+  }
+
+  CFFmpegImage encoder("image/jpeg");
+  unsigned char* jpeg = nullptr;
+  unsigned int jpegSize = 0;
+  if (!encoder.CreateThumbnailFromSurface(pixels.data(), width, height, XB_FMT_A8R8G8B8, width * 4,
+                                          "photo.jpg", jpeg, jpegSize))
+    return {};
+
+  std::vector<unsigned char> result(jpeg, jpeg + jpegSize);
+  encoder.ReleaseThumbnailBuffer();
+  return result;
+}
+} // unnamed namespace
+
+TEST(TestFFmpegImage, ScaledDecode)
+{
+  constexpr unsigned int WIDTH = 640;
+  constexpr unsigned int HEIGHT = 480;
+  std::vector<unsigned char> jpeg = CreateJpeg(WIDTH, HEIGHT);
+  ASSERT_FALSE(jpeg.empty());
+
+  struct
+  {
+    unsigned int maxWidth;
+    unsigned int maxHeight;
+    unsigned int divisor;
+  } const cases[] = {
+      {0, 0, 1}, // no size requested
+      {WIDTH, HEIGHT, 1},
+      {400, 300, 1}, // half the size would be smaller than shown
+      {320, 240, 2},
+      {240, 320, 2}, // shown rotated
+      {160, 120, 4},
+      {80, 60, 8},
+      {40, 30, 8}, // the decoder can't reduce by more than 8
+  };
+
+  for (const auto& c : cases)
+  {
+    CFFmpegImage image("image/jpeg");
+    ASSERT_TRUE(image.LoadImageFromMemory(jpeg.data(), jpeg.size(), c.maxWidth, c.maxHeight));
+    EXPECT_EQ(WIDTH / c.divisor, image.Width()) << c.maxWidth << "x" << c.maxHeight;
+    EXPECT_EQ(HEIGHT / c.divisor, image.Height()) << c.maxWidth << "x" << c.maxHeight;
+    EXPECT_EQ(WIDTH, image.originalWidth());
+    EXPECT_EQ(HEIGHT, image.originalHeight());
+
+    std::vector<unsigned char> pixels(image.Width() * image.Height() * 4);
+    EXPECT_TRUE(image.Decode(pixels.data(), image.Width(), image.Height(), image.Width() * 4,
+                             XB_FMT_A8R8G8B8));
+  }
+}
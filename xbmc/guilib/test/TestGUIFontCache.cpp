@@ -0,0 +1,183 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIFontTTF.h"
+#include "guilib/Texture.h"
+#include "windowing/GraphicContext.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr size_t DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+int liveBuffers = 0;
+
+/*!
+ * \brief A font without glyphs that looks its texts up in the vertex cache the same way
+ * DrawTextInternal() does with hardware clipping.
+ */
+class CTestFont : public CGUIFontTTF
+{
+public:
+  CTestFont() : CGUIFontTTF("test") {}
+  ~CTestFont() override
+  {
+    // the vertex buffers are destroyed through the virtual DestroyVertexBuffer()
+    m_dynamicCache.Flush();
+  }
+
+  void DrawText(const CGraphicContext& context,
+                float y,
+                const vecText& text,
+                std::chrono::steady_clock::time_point now)
+  {
+    const std::vector<UTILS::COLOR::Color> colors{0xFFFFFFFF};
+    bool dirtyCache;
+    CGUIFontCacheDynamicPosition pos(0, y, 0);
+    m_dynamicCache.Lookup(context, pos, colors, text, 0, 0, false, now, dirtyCache);
+    if (!dirtyCache)
+      return;
+
+    const std::vector<SVertex> vertices(text.size() * 4);
+    CVertexBuffer newVertexBuffer = CreateVertexBuffer(vertices);
+    CGUIFontCacheDynamicPosition newPos(0, y, 0);
+    CVertexBuffer& vertexBuffer =
+        m_dynamicCache.Lookup(context, newPos, colors, text, 0, 0, false, now, dirtyCache);
+    vertexBuffer = newVertexBuffer;
+  }
+
+  CVertexBuffer CreateVertexBuffer(const std::vector<SVertex>& vertices) const override
+  {
+    liveBuffers++;
+    return CVertexBuffer(BUFFER_HANDLE_INIT, vertices.size() / 4, this);
+  }
+  void DestroyVertexBuffer(CVertexBuffer& bufferHandle) const override { liveBuffers--; }
+
+protected:
+  std::unique_ptr<CTexture> ReallocTexture(unsigned int& newHeight) override { return nullptr; }
+  bool CopyCharToTexture(FT_BitmapGlyph bitGlyph,
+                         unsigned int x1,
+                         unsigned int y1,
+                         unsigned int x2,
+                         unsigned int y2) override
+  {
+    return false;
+  }
+  void DeleteHardwareTexture() override {}
+
+private:
+  bool FirstBegin() override { return true; }
+  void LastEnd() override {}
+};
+
+vecText CreateText(const std::string& label)
+{
+  return vecText(label.begin(), label.end());
+}
+} // unnamed namespace
+
+TEST(TestGUIFontCache, NoEvictionOfRecentEntries)
+{
+  CGraphicContext context;
+  const CGUIFontCacheBudget::Statistics before = CGUIFontCacheBudget::GetInstance().GetStatistics();
+  CGUIFontCacheBudget::GetInstance().SetBudget(1);
+  {
+    CTestFont font;
+    auto now = std::chrono::steady_clock::now();
+
+    // all of these texts may still be waiting to be rendered
+    for (int i = 0; i < 10; i++)
+      font.DrawText(context, 0, CreateText("Item " + std::to_string(i)), now);
+    font.DrawText(context, 0, CreateText("Item 0"), now);
+
+    CGUIFontCacheBudget::Statistics stats = CGUIFontCacheBudget::GetInstance().GetStatistics();
+    EXPECT_EQ(before.entries + 10, stats.entries);
+    EXPECT_EQ(before.misses + 10, stats.misses);
+    EXPECT_EQ(before.hits + 1, stats.hits);
+    EXPECT_EQ(before.evictions, stats.evictions);
+    EXPECT_EQ(10, liveBuffers);
+
+    now += 2s;
+    font.DrawText(context, 0, CreateText("Item 10"), now);
+
+    stats = CGUIFontCacheBudget::GetInstance().GetStatistics();
+    EXPECT_EQ(before.entries + 1, stats.entries);
+    EXPECT_EQ(before.evictions + 10, stats.evictions);
+    EXPECT_EQ(1, liveBuffers);
+  }
+  CGUIFontCacheBudget::GetInstance().SetBudget(DEFAULT_BUDGET);
+
+  EXPECT_EQ(0, liveBuffers);
+  EXPECT_EQ(before.entries, CGUIFontCacheBudget::GetInstance().GetStatistics().entries);
+  EXPECT_EQ(before.size, CGUIFontCacheBudget::GetInstance().GetStatistics().size);
+}
+
+TEST(TestGUIFontCache, ScrollingLists)
+{
+  constexpr size_t BUDGET = 1024 * 1024;
+  constexpr int FONTS = 3;
+  constexpr int ITEMS = 1000;
+  constexpr int ROWS = 20;
+  constexpr int FRAMES = 6000;
+  constexpr int FRAMES_PER_ROW = 4;
+  constexpr float ROW_HEIGHT = 40.0f;
+
+  CGraphicContext context;
+  const CGUIFontCacheBudget::Statistics before = CGUIFontCacheBudget::GetInstance().GetStatistics();
+  CGUIFontCacheBudget::GetInstance().SetBudget(BUDGET);
+
+  std::vector<vecText> labels;
+  for (int i = 0; i < ITEMS; i++)
+    labels.push_back(CreateText("Artist " + std::to_string(i) + " - Album title of item " +
+                                std::to_string(i)));
+
+  size_t peakSize = 0;
+  {
+    std::vector<std::unique_ptr<CTestFont>> fonts;
+    for (int i = 0; i < FONTS; i++)
+      fonts.emplace_back(std::make_unique<CTestFont>());
+
+    // every font renders its own list, scrolling down and back up again at a different speed
+    auto now = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; frame++, now += 16ms)
+    {
+      for (int i = 0; i < FONTS; i++)
+      {
+        const int scroll = frame * (i + 1) / FRAMES_PER_ROW % (2 * (ITEMS - ROWS));
+        const int offset = scroll < ITEMS - ROWS ? scroll : 2 * (ITEMS - ROWS) - scroll;
+        for (int row = 0; row < ROWS; row++)
+          fonts[i]->DrawText(context, row * ROW_HEIGHT, labels[offset + row], now);
+      }
+
+      const CGUIFontCacheBudget::Statistics stats =
+          CGUIFontCacheBudget::GetInstance().GetStatistics();
+      peakSize = std::max(peakSize, stats.size - before.size);
+      ASSERT_EQ(static_cast<int>(stats.entries - before.entries), liveBuffers);
+    }
+  }
+  const CGUIFontCacheBudget::Statistics stats = CGUIFontCacheBudget::GetInstance().GetStatistics();
+  CGUIFontCacheBudget::GetInstance().SetBudget(DEFAULT_BUDGET);
+
+  // the texts of the last second may exceed the budget, but not by much
+  EXPECT_LE(peakSize, 2 * BUDGET);
+  EXPECT_GT(stats.evictions, before.evictions);
+  EXPECT_EQ(0, liveBuffers);
+
+  const uint64_t hits = stats.hits - before.hits;
+  const uint64_t misses = stats.misses - before.misses;
+  EXPECT_GT(hits, misses * 10);
+}
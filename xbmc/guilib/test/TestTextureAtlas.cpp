@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/TextureAtlas.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Rect
+{
+  unsigned int x1, y1, x2, y2;
+
+  bool Intersects(const Rect& other) const
+  {
+    return x1 < other.x2 && other.x1 < x2 && y1 < other.y2 && other.y1 < y2;
+  }
+};
+
+// sizes of the small textures of a typical skin: icons, flags, button states and overlays
+std::vector<std::pair<unsigned int, unsigned int>> CreateSkinTextures(int count)
+{
+  std::mt19937 mt(42);
+  std::uniform_int_distribution<unsigned int> size(12, 128);
+  std::vector<std::pair<unsigned int, unsigned int>> textures;
+  for (int i = 0; i < count; i++)
+  {
+    const unsigned int width = size(mt);
+    textures.emplace_back(width, i % 3 == 0 ? width : size(mt));
+  }
+
+  std::sort(textures.begin(), textures.end(),
+            [](const auto& a, const auto& b) { return a.second > b.second; });
+  return textures;
+}
+} // unnamed namespace
+
+TEST(TestTextureAtlas, PackerNoOverlap)
+{
+  constexpr unsigned int PADDING = 1;
+  CTextureAtlasPacker packer(512, 512, PADDING);
+
+  std::vector<Rect> placed;
+  for (const auto& texture : CreateSkinTextures(100))
+  {
+    unsigned int x, y;
+    if (!packer.Insert(texture.first, texture.second, x, y))
+      continue;
+
+    // the padding belongs to the image and must not be shared with another one
+    const Rect rect{x - PADDING, y - PADDING, x + texture.first + PADDING,
+                    y + texture.second + PADDING};
+    EXPECT_LE(rect.x2, 512u);
+    EXPECT_LE(rect.y2, 512u);
+    for (const Rect& other : placed)
+      EXPECT_FALSE(rect.Intersects(other));
+    placed.push_back(rect);
+  }
+
+  EXPECT_FALSE(placed.empty());
+  EXPECT_LE(packer.GetUsedHeight(), 512u);
+}
+
+TEST(TestTextureAtlas, PackerFull)
+{
+  CTextureAtlasPacker packer(64, 64, 0);
+  unsigned int x, y;
+
+  EXPECT_FALSE(packer.Insert(65, 8, x, y));
+
+  for (int i = 0; i < 4; i++)
+  {
+    ASSERT_TRUE(packer.Insert(32, 32, x, y));
+    EXPECT_EQ(static_cast<unsigned int>(i % 2) * 32, x);
+    EXPECT_EQ(static_cast<unsigned int>(i / 2) * 32, y);
+  }
+  EXPECT_FALSE(packer.Insert(1, 1, x, y));
+  EXPECT_EQ(64u, packer.GetUsedHeight());
+  EXPECT_EQ(64u * 64u, packer.GetUsedArea());
+}
+
+TEST(TestTextureAtlas, CopyImageRepeatsEdges)
+{
+  // 2x2 image placed at (1,1) of a 4x4 atlas with one pixel of padding
+  const std::vector<uint8_t> image = {1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4};
+  std::vector<uint8_t> atlas(4 * 4 * 4);
+  CTextureAtlas::CopyImage(atlas.data(), 4 * 4, 1, 1, image.data(), 2, 2, 1);
+
+  const uint8_t expected[4][4] = {{1, 1, 2, 2}, {1, 1, 2, 2}, {3, 3, 4, 4}, {3, 3, 4, 4}};
+  for (unsigned int y = 0; y < 4; y++)
+  {
+    for (unsigned int x = 0; x < 4; x++)
+    {
+      for (unsigned int c = 0; c < 4; c++)
+        EXPECT_EQ(expected[y][x], atlas[(y * 4 + x) * 4 + c]) << "pixel " << x << "," << y;
+    }
+  }
+}
+
+TEST(TestTextureAtlas, SkinTextures)
+{
+  constexpr int TEXTURES = 600;
+  const auto textures = CreateSkinTextures(TEXTURES);
+
+  std::vector<std::pair<unsigned int, unsigned int>> remaining = textures;
+  int atlases = 0;
+  uint64_t usedArea = 0;
+  uint64_t atlasArea = 0;
+  while (!remaining.empty())
+  {
+    CTextureAtlasPacker packer(2048, 2048, 1);
+    std::vector<std::pair<unsigned int, unsigned int>> left;
+    for (const auto& texture : remaining)
+    {
+      unsigned int x, y;
+      if (!packer.Insert(texture.first, texture.second, x, y))
+        left.push_back(texture);
+    }
+    ASSERT_LT(left.size(), remaining.size());
+
+    atlases++;
+    usedArea += packer.GetUsedArea();
+    atlasArea += static_cast<uint64_t>(packer.GetWidth()) * packer.GetUsedHeight();
+    remaining = std::move(left);
+  }
+
+  // the texture switches between these images are gone
+  EXPECT_LE(atlases, 2);
+
+  // and the shelves leave little of the atlases unused
+  EXPECT_GE(usedArea * 100 / atlasArea, 80u);
+}
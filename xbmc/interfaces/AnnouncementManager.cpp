@@ -9,11 +9,15 @@
 #include "AnnouncementManager.h"
 
 #include "FileItem.h"
+#include "ServiceBroker.h"
 #include "music/MusicDatabase.h"
 #include "music/tags/MusicInfoTag.h"
 #include "playlists/PlayListTypes.h"
 #include "pvr/channels/PVRChannel.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -24,6 +28,15 @@
 
 #define LOOKUP_PROPERTY "database-lookup"
 
+using namespace std::chrono_literals;
+
+namespace
+{
+// library changes come in bursts (e.g. during scans) and only tell about the latest state
+constexpr int COALESCE_FLAGS = ANNOUNCEMENT::VideoLibrary | ANNOUNCEMENT::AudioLibrary;
+constexpr auto STATISTICS_INTERVAL = 10s;
+} // unnamed namespace
+
 using namespace ANNOUNCEMENT;
 
 const std::string CAnnouncementManager::ANNOUNCEMENT_SENDER = "xbmc";
@@ -51,13 +64,13 @@ void CAnnouncementManager::Deinitialize()
   m_announcers.clear();
 }
 
-void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener)
+void CAnnouncementManager::AddAnnouncer(IAnnouncer* listener, int flags)
 {
   if (!listener)
     return;
 
   std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
-  m_announcers.push_back(listener);
+  m_announcers.push_back({listener, flags});
 }
 
 void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
@@ -68,7 +81,7 @@ void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
   std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
   for (unsigned int i = 0; i < m_announcers.size(); i++)
   {
-    if (m_announcers[i] == listener)
+    if (m_announcers[i].listener == listener)
     {
       m_announcers.erase(m_announcers.begin() + i);
       return;
@@ -134,12 +147,42 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag,
   announcement.message = message;
   announcement.data = data;
 
+  announcement.time = std::chrono::steady_clock::now();
+
   if (item != nullptr)
     announcement.item = CFileItemPtr(new CFileItem(*item));
+  else if (flag & COALESCE_FLAGS)
+  {
+    // identical announcements only need to be delivered once
+    std::string json;
+    CJSONVariantWriter::Write(data, json, true);
+    announcement.key = StringUtils::Format("{}|{}|{}|{}", static_cast<int>(flag), sender, message, json);
+  }
 
   {
     std::unique_lock<CCriticalSection> lock(m_queueCritSection);
-    m_announcementQueue.push_back(announcement);
+    m_announced++;
+
+    if (announcement.key.empty())
+      m_barriers++;
+    else
+    {
+      const auto it = m_pending.find(announcement.key);
+      if (it != m_pending.end())
+      {
+        // drop the older one, the survivor is queued behind the announcements that arrived in
+        // between. The arrival time of the older one is kept so that an item updated again and
+        // again is not held back forever.
+        announcement.time = it->second->time;
+        m_announcementQueue.erase(it->second);
+        m_pending.erase(it);
+        m_coalesced++;
+      }
+    }
+
+    m_announcementQueue.push_back(std::move(announcement));
+    if (!m_announcementQueue.back().key.empty())
+      m_pending.emplace(m_announcementQueue.back().key, std::prev(m_announcementQueue.end()));
   }
   m_queueEvent.Set();
 }
@@ -155,9 +198,12 @@ void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
 
   // Make a copy of announcers. They may be removed or even remove themselves during execution of IAnnouncer::Announce()!
 
-  std::vector<IAnnouncer *> announcers(m_announcers);
+  std::vector<CAnnouncer> announcers(m_announcers);
   for (unsigned int i = 0; i < announcers.size(); i++)
-    announcers[i]->Announce(flag, sender, message, data);
+  {
+    if (announcers[i].flags & flag)
+      announcers[i].listener->Announce(flag, sender, message, data);
+  }
 }
 
 void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
@@ -320,13 +366,35 @@ void CAnnouncementManager::Process()
 {
   SetPriority(ThreadPriority::LOWEST);
 
+  m_statisticsTime = std::chrono::steady_clock::now();
+
   while (!m_bStop)
   {
     std::unique_lock<CCriticalSection> lock(m_queueCritSection);
     if (!m_announcementQueue.empty())
     {
-      auto announcement = m_announcementQueue.front();
+      // hold back announcements which may be coalesced for the configured window, unless
+      // other announcements are waiting behind them
+      const CAnnounceData& front = m_announcementQueue.front();
+      if (!front.key.empty() && m_barriers == 0)
+      {
+        const auto due = front.time + GetCoalesceWindow();
+        const auto now = std::chrono::steady_clock::now();
+        if (now < due)
+        {
+          CSingleExit ex(m_queueCritSection);
+          m_queueEvent.Wait(std::chrono::duration_cast<std::chrono::milliseconds>(due - now) + 1ms);
+          continue;
+        }
+      }
+
+      auto announcement = std::move(m_announcementQueue.front());
       m_announcementQueue.pop_front();
+      if (announcement.key.empty())
+        m_barriers--;
+      else
+        m_pending.erase(announcement.key);
+
       {
         CSingleExit ex(m_queueCritSection);
         DoAnnounce(announcement.flag, announcement.sender, announcement.message, announcement.item,
@@ -335,8 +403,39 @@ void CAnnouncementManager::Process()
     }
     else
     {
+      LogStatistics();
+
       CSingleExit ex(m_queueCritSection);
       m_queueEvent.Wait();
     }
   }
 }
+
+std::chrono::milliseconds CAnnouncementManager::GetCoalesceWindow() const
+{
+  const auto settingsComponent = CServiceBroker::GetSettingsComponent();
+  if (!settingsComponent)
+    return 0ms;
+
+  const auto advancedSettings = settingsComponent->GetAdvancedSettings();
+  if (!advancedSettings)
+    return 0ms;
+
+  return std::chrono::milliseconds(advancedSettings->m_jsonAnnouncementWindow);
+}
+
+void CAnnouncementManager::LogStatistics()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_statisticsTime < STATISTICS_INTERVAL || m_announced == 0)
+    return;
+
+  const double seconds = std::chrono::duration<double>(now - m_statisticsTime).count();
+  CLog::Log(LOGDEBUG, LOGANNOUNCE,
+            "CAnnouncementManager - {:.1f} announcements/s, {} of {} coalesced", m_announced / seconds,
+            m_coalesced, m_announced);
+
+  m_statisticsTime = now;
+  m_announced = 0;
+  m_coalesced = 0;
+}
@@ -14,8 +14,11 @@
 #include "threads/Thread.h"
 #include "utils/Variant.h"
 
+#include <chrono>
 #include <list>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 class CFileItem;
@@ -32,7 +35,13 @@ namespace ANNOUNCEMENT
     void Start();
     void Deinitialize();
 
-    void AddAnnouncer(IAnnouncer *listener);
+    /*!
+     * \brief Subscribe to announcements.
+     * \param listener The subscriber
+     * \param flags The announcement flags the subscriber is interested in, announcements
+     * with other flags are not delivered to it
+     */
+    void AddAnnouncer(IAnnouncer* listener, int flags = ANNOUNCE_ALL | Info);
     void RemoveAnnouncer(IAnnouncer *listener);
 
     void Announce(AnnouncementFlag flag, const std::string& message);
@@ -80,6 +89,8 @@ namespace ANNOUNCEMENT
       std::string message;
       std::shared_ptr<CFileItem> item;
       CVariant data;
+      std::chrono::steady_clock::time_point time;
+      std::string key; // set for announcements that may be coalesced
     };
     std::list<CAnnounceData> m_announcementQueue;
     CEvent m_queueEvent;
@@ -88,8 +99,26 @@ namespace ANNOUNCEMENT
     CAnnouncementManager(const CAnnouncementManager&) = delete;
     CAnnouncementManager const& operator=(CAnnouncementManager const&) = delete;
 
+    std::chrono::milliseconds GetCoalesceWindow() const;
+    void LogStatistics();
+
+    struct CAnnouncer
+    {
+      IAnnouncer* listener;
+      int flags;
+    };
+
     CCriticalSection m_announcersCritSection;
     CCriticalSection m_queueCritSection;
-    std::vector<IAnnouncer *> m_announcers;
+    std::vector<CAnnouncer> m_announcers;
+
+    // queued announcements that may still be coalesced, by key
+    std::unordered_map<std::string, std::list<CAnnounceData>::iterator> m_pending;
+    // number of queued announcements that may not be coalesced
+    unsigned int m_barriers = 0;
+
+    uint64_t m_announced = 0;
+    uint64_t m_coalesced = 0;
+    std::chrono::steady_clock::time_point m_statisticsTime;
   };
 }
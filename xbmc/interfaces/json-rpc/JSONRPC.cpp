@@ -240,7 +240,21 @@ JSONRPC_STATUS CJSONRPC::NotifyAll(const std::string &method, ITransportLayer *t
 
 std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client)
 {
-  CVariant inputroot, outputroot, result;
+  CVariant outputroot;
+
+  std::string str;
+  if (MethodCall(inputString, transport, client, outputroot))
+    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
+  return str;
+}
+
+bool CJSONRPC::MethodCall(const std::string& inputString,
+                          ITransportLayer* transport,
+                          IClient* client,
+                          CVariant& outputroot)
+{
+  CVariant inputroot;
   bool hasResponse = false;
 
   CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming request: {}", inputString);
@@ -263,7 +277,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
           CVariant response;
           if (HandleMethodCall(*itr, response, transport, client))
           {
-            outputroot.append(response);
+            outputroot.append(std::move(response));
             hasResponse = true;
           }
         }
@@ -279,11 +293,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
     hasResponse = true;
   }
 
-  std::string str;
-  if (hasResponse)
-    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
-
-  return str;
+  return hasResponse;
 }
 
 bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
@@ -316,7 +326,8 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
     errorCode = InvalidRequest;
   }
 
-  BuildResponse(request, errorCode, result, response);
+  // results can be huge, move them into the response instead of copying
+  BuildResponse(request, errorCode, std::move(result), response);
 
   return !isNotification;
 }
@@ -326,7 +337,7 @@ inline bool CJSONRPC::IsProperJSONRPC(const CVariant& inputroot)
   return inputroot.isMember("jsonrpc") && inputroot["jsonrpc"].isString() && inputroot["jsonrpc"] == CVariant("2.0") && inputroot.isMember("method") && inputroot["method"].isString() && (!inputroot.isMember("params") || inputroot["params"].isArray() || inputroot["params"].isObject());
 }
 
-inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response)
+inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, CVariant&& result, CVariant& response)
 {
   response["jsonrpc"] = "2.0";
   response["id"] = request.isMember("id") ? request["id"] : CVariant();
@@ -334,7 +345,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
   switch (code)
   {
     case OK:
-      response["result"] = result;
+      response["result"] = std::move(result);
       break;
     case ACK:
       response["result"] = "OK";
@@ -347,7 +358,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
       response["error"]["code"] = InvalidParams;
       response["error"]["message"] = "Invalid params.";
       if (!result.isNull())
-        response["error"]["data"] = result;
+        response["error"]["data"] = std::move(result);
       break;
     case MethodNotFound:
       response["error"]["code"] = MethodNotFound;
@@ -236,6 +236,7 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 // Textures operations
   { "Textures.GetTextures",                         CTextureOperations::GetTextures },
   { "Textures.RemoveTexture",                       CTextureOperations::RemoveTexture },
+  { "Textures.GetCacheStatistics",                  CTextureOperations::GetCacheStatistics },
 
 // Settings operations
   { "Settings.GetSections",                         CSettingsOperations::GetSections },
@@ -93,3 +93,19 @@ JSONRPC_STATUS CTextureOperations::RemoveTexture(const std::string &method, ITra
 
   return ACK;
 }
+
+JSONRPC_STATUS CTextureOperations::GetCacheStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  const CTextureCache::Statistics statistics = CServiceBroker::GetTextureCache()->GetStatistics();
+
+  result["size"] = statistics.size;
+  result["maxsize"] = statistics.maxSize;
+  result["textures"] = statistics.textures;
+  result["hits"] = statistics.hits;
+  result["misses"] = statistics.misses;
+  const uint64_t loads = statistics.hits + statistics.misses;
+  result["hitrate"] = loads > 0 ? static_cast<double>(statistics.hits) / loads : 0.0;
+  result["evicted"] = statistics.evicted;
+
+  return OK;
+}
@@ -0,0 +1,198 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "interfaces/AnnouncementManager.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/Variant.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ANNOUNCEMENT;
+using namespace std::chrono_literals;
+
+namespace
+{
+class CTestAnnouncer : public IAnnouncer
+{
+public:
+  void Announce(AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    std::string received = message;
+    if (data.isMember("id"))
+      received += " " + data["id"].asString();
+    m_received.push_back(received);
+    m_event.Set();
+  }
+
+  // wait until the given message was received
+  bool WaitFor(const std::string& message, std::chrono::milliseconds timeout = 5000ms)
+  {
+    const auto end = std::chrono::steady_clock::now() + timeout;
+    while (true)
+    {
+      {
+        std::unique_lock<CCriticalSection> lock(m_critSection);
+        for (const std::string& received : m_received)
+        {
+          if (received == message)
+            return true;
+        }
+      }
+
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= end)
+        return false;
+      m_event.Wait(std::chrono::duration_cast<std::chrono::milliseconds>(end - now));
+    }
+  }
+
+  std::vector<std::string> GetReceived()
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    return m_received;
+  }
+
+private:
+  CCriticalSection m_critSection;
+  CEvent m_event;
+  std::vector<std::string> m_received;
+};
+
+CVariant CreateData(int id)
+{
+  CVariant data;
+  data["id"] = id;
+  return data;
+}
+} // unnamed namespace
+
+class TestAnnouncementManager : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_window = Window();
+    m_announcementManager.AddAnnouncer(&m_announcer);
+  }
+
+  void TearDown() override
+  {
+    m_announcementManager.Deinitialize();
+    Window() = m_window;
+  }
+
+  static unsigned int& Window()
+  {
+    return CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonAnnouncementWindow;
+  }
+
+  CAnnouncementManager m_announcementManager;
+  CTestAnnouncer m_announcer;
+  unsigned int m_window = 0;
+};
+
+TEST_F(TestAnnouncementManager, CoalescesIdenticalAnnouncements)
+{
+  // everything is queued before the announcement thread runs
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", CreateData(1));
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", CreateData(1));
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", CreateData(2));
+  m_announcementManager.Announce(VideoLibrary, "OnRemove", CreateData(1));
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", CreateData(1));
+  m_announcementManager.Announce(AudioLibrary, "OnUpdate", CreateData(1));
+  m_announcementManager.Announce(AudioLibrary, "OnUpdate", CreateData(1));
+  m_announcementManager.Announce(Other, "Marker");
+  m_announcementManager.Start();
+
+  ASSERT_TRUE(m_announcer.WaitFor("Marker"));
+
+  // the survivor of a duplicate takes the place of the last one
+  const std::vector<std::string> expected{"OnUpdate 2", "OnRemove 1", "OnUpdate 1", "OnUpdate 1",
+                                          "Marker"};
+  EXPECT_EQ(expected, m_announcer.GetReceived());
+}
+
+TEST_F(TestAnnouncementManager, DoesNotCoalesceOtherFlags)
+{
+  m_announcementManager.Announce(Player, "OnPlay", CreateData(1));
+  m_announcementManager.Announce(Player, "OnPlay", CreateData(1));
+  m_announcementManager.Announce(Other, "Marker");
+  m_announcementManager.Announce(Other, "Marker");
+  m_announcementManager.Announce(Other, "End");
+  m_announcementManager.Start();
+
+  ASSERT_TRUE(m_announcer.WaitFor("End"));
+
+  const std::vector<std::string> expected{"OnPlay 1", "OnPlay 1", "Marker", "Marker", "End"};
+  EXPECT_EQ(expected, m_announcer.GetReceived());
+}
+
+TEST_F(TestAnnouncementManager, DoesNotCoalesceItems)
+{
+  const auto item = std::make_shared<CFileItem>("item", false);
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", item, CreateData(1));
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", item, CreateData(1));
+  m_announcementManager.Announce(Other, "Marker");
+  m_announcementManager.Start();
+
+  ASSERT_TRUE(m_announcer.WaitFor("Marker"));
+
+  const std::vector<std::string> expected{"OnUpdate 1", "OnUpdate 1", "Marker"};
+  EXPECT_EQ(expected, m_announcer.GetReceived());
+}
+
+TEST_F(TestAnnouncementManager, HoldsBackForWindow)
+{
+  Window() = 200;
+  m_announcementManager.Start();
+
+  const auto start = std::chrono::steady_clock::now();
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", CreateData(1));
+  std::this_thread::sleep_for(50ms);
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", CreateData(1));
+
+  ASSERT_TRUE(m_announcer.WaitFor("OnUpdate 1"));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 200ms);
+
+  m_announcementManager.Announce(Other, "Marker");
+  ASSERT_TRUE(m_announcer.WaitFor("Marker"));
+
+  const std::vector<std::string> expected{"OnUpdate 1", "Marker"};
+  EXPECT_EQ(expected, m_announcer.GetReceived());
+}
+
+TEST_F(TestAnnouncementManager, OtherAnnouncementsEndWindow)
+{
+  Window() = 60000;
+  m_announcementManager.Start();
+
+  // the library announcement must not hold back the one queued behind it
+  m_announcementManager.Announce(VideoLibrary, "OnUpdate", CreateData(1));
+  m_announcementManager.Announce(Other, "Marker");
+
+  ASSERT_TRUE(m_announcer.WaitFor("Marker"));
+
+  const std::vector<std::string> expected{"OnUpdate 1", "Marker"};
+  EXPECT_EQ(expected, m_announcer.GetReceived());
+}
@@ -74,6 +74,15 @@ using KODI::MESSAGING::HELPERS::DialogResponse;
 #define RECENTLY_PLAYED_LIMIT 25
 #define MIN_FULL_SEARCH_LENGTH 3
 
+namespace
+{
+const CDatabase::FullTextIndex ARTIST_FULLTEXT_INDEX = {
+    "ftArtist", "artist", "idArtist", {"strArtist"}, {}};
+const CDatabase::FullTextIndex ALBUM_FULLTEXT_INDEX = {
+    "ftAlbum", "album", "idAlbum", {"strAlbum"}, {}};
+const CDatabase::FullTextIndex SONG_FULLTEXT_INDEX = {"ftSong", "song", "idSong", {"strTitle"}, {}};
+} // unnamed namespace
+
 #ifdef HAS_DVD_DRIVE
 using namespace CDDB;
 using namespace MEDIA_DETECT;
@@ -395,6 +404,11 @@ void CMusicDatabase::CreateAnalytics()
               "END");
   CreateRemovedLinkTriggers(); // DELETE ON song_artist and album_artist tables
 
+  // Full text indices used by search, falls back to LIKE when unavailable
+  CreateFullTextIndex(ARTIST_FULLTEXT_INDEX);
+  CreateFullTextIndex(ALBUM_FULLTEXT_INDEX);
+  CreateFullTextIndex(SONG_FULLTEXT_INDEX);
+
   // Create native functions stored in DB (MySQL/MariaDB only)
   CreateNativeDBFunctions();
 
@@ -3351,16 +3365,18 @@ bool CMusicDatabase::SearchArtists(const std::string& search, CFileItemList& art
       return false;
 
     std::string strVariousArtists = g_localizeStrings.Get(340).c_str();
-    std::string strSQL;
+    Filter filter(PrepareSQL("strArtist <> '%s'", strVariousArtists.c_str()));
     if (search.size() >= MIN_FULL_SEARCH_LENGTH)
-      strSQL = PrepareSQL("SELECT * FROM artist "
-                          "WHERE (strArtist LIKE '%s%%' OR strArtist LIKE '%% %s%%') "
-                          "AND strArtist <> '%s' ",
-                          search.c_str(), search.c_str(), strVariousArtists.c_str());
+    {
+      if (!AppendFullTextFilter(filter, ARTIST_FULLTEXT_INDEX, "artist.idArtist", {{search}}))
+        filter.AppendWhere(PrepareSQL("strArtist LIKE '%s%%' OR strArtist LIKE '%% %s%%'",
+                                      search.c_str(), search.c_str()));
+    }
     else
-      strSQL = PrepareSQL("SELECT * FROM artist "
-                          "WHERE strArtist LIKE '%s%%' AND strArtist <> '%s' ",
-                          search.c_str(), strVariousArtists.c_str());
+      filter.AppendWhere(PrepareSQL("strArtist LIKE '%s%%'", search.c_str()));
+
+    std::string strSQL;
+    BuildSQL("SELECT artist.* FROM artist", filter, strSQL);
 
     if (!m_pDS->query(strSQL))
       return false;
@@ -3998,15 +4014,19 @@ bool CMusicDatabase::SearchSongs(const std::string& search, CFileItemList& items
     if (!baseUrl.FromString("musicdb://songs/"))
       return false;
 
-    std::string strSQL;
+    Filter filter;
     if (search.size() >= MIN_FULL_SEARCH_LENGTH)
-      strSQL = PrepareSQL("SELECT * FROM songview "
-                          "WHERE strTitle LIKE '%s%%' or strTitle LIKE '%% %s%%' LIMIT 1000",
-                          search.c_str(), search.c_str());
+    {
+      if (!AppendFullTextFilter(filter, SONG_FULLTEXT_INDEX, "songview.idSong", {{search}}))
+        filter.AppendWhere(PrepareSQL("strTitle LIKE '%s%%' or strTitle LIKE '%% %s%%'",
+                                      search.c_str(), search.c_str()));
+    }
     else
-      strSQL = PrepareSQL("SELECT * FROM songview "
-                          "WHERE strTitle LIKE '%s%%' LIMIT 1000",
-                          search.c_str());
+      filter.AppendWhere(PrepareSQL("strTitle LIKE '%s%%'", search.c_str()));
+    filter.limit = "1000";
+
+    std::string strSQL;
+    BuildSQL("SELECT songview.* FROM songview", filter, strSQL);
 
     if (!m_pDS->query(strSQL))
       return false;
@@ -4041,15 +4061,18 @@ bool CMusicDatabase::SearchAlbums(const std::string& search, CFileItemList& albu
     if (nullptr == m_pDS)
       return false;
 
-    std::string strSQL;
+    Filter filter;
     if (search.size() >= MIN_FULL_SEARCH_LENGTH)
-      strSQL = PrepareSQL("SELECT * FROM albumview "
-                          "WHERE strAlbum LIKE '%s%%' OR strAlbum LIKE '%% %s%%'",
-                          search.c_str(), search.c_str());
+    {
+      if (!AppendFullTextFilter(filter, ALBUM_FULLTEXT_INDEX, "albumview.idAlbum", {{search}}))
+        filter.AppendWhere(PrepareSQL("strAlbum LIKE '%s%%' OR strAlbum LIKE '%% %s%%'",
+                                      search.c_str(), search.c_str()));
+    }
     else
-      strSQL = PrepareSQL("SELECT * FROM albumview "
-                          "WHERE strAlbum LIKE '%s%%'",
-                          search.c_str());
+      filter.AppendWhere(PrepareSQL("strAlbum LIKE '%s%%'", search.c_str()));
+
+    std::string strSQL;
+    BuildSQL("SELECT albumview.* FROM albumview", filter, strSQL);
 
     if (!m_pDS->query(strSQL))
       return false;
@@ -9308,7 +9331,7 @@ void CMusicDatabase::UpdateTables(int version)
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 82;
+  return 83;
 }
 
 int CMusicDatabase::GetMusicNeedsTagScan()
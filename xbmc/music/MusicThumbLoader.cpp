@@ -72,25 +72,23 @@ bool CMusicThumbLoader::LoadItemCached(CFileItem* pItem)
       return true;
   }
 
+  if (pItem->HasArt("thumb") && pItem->HasArt("fanart"))
+    return false;
+
+  // look up both fallbacks at once instead of one query per type
+  const std::map<std::string, std::string> cachedArt = GetCachedImages(*pItem);
+
   // Fallback to folder thumb when path has one cached
-  if (!pItem->HasArt("thumb"))
-  {
-    std::string art = GetCachedImage(*pItem, "thumb");
-    if (!art.empty())
-      pItem->SetArt("thumb", art);
-  }
+  auto art = cachedArt.find("thumb");
+  if (!pItem->HasArt("thumb") && art != cachedArt.end() && !art->second.empty())
+    pItem->SetArt("thumb", art->second);
 
   // Fallback to folder fanart when path has one cached
   //! @todo Remove as "fanart" is never been cached for music folders (only for
   // artists) or start caching fanart for folders?
-  if (!pItem->HasArt("fanart"))
-  {
-    std::string art = GetCachedImage(*pItem, "fanart");
-    if (!art.empty())
-    {
-      pItem->SetArt("fanart", art);
-    }
-  }
+  art = cachedArt.find("fanart");
+  if (!pItem->HasArt("fanart") && art != cachedArt.end() && !art->second.empty())
+    pItem->SetArt("fanart", art->second);
 
   return false;
 }
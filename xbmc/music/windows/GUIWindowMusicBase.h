@@ -74,6 +74,10 @@ protected:
   void OnRipCD();
   std::string GetStartFolder(const std::string &dir) override;
   void OnItemLoaded(CFileItem* pItem) override {}
+  void OnViewportChanged(const std::vector<CFileItemPtr>& items) override
+  {
+    m_thumbLoader.SetPriorityItems(items);
+  }
 
   virtual void OnScan(int iItem, bool bPromptRescan = false);
 
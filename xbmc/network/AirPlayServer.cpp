@@ -320,7 +320,7 @@ CAirPlayServer::CAirPlayServer(int port, bool nonlocal) : CThread("AirPlayServer
   m_nonlocal = nonlocal;
   m_usePassword = false;
   m_origVolume = -1;
-  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
+  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this, ANNOUNCEMENT::Player);
 }
 
 CAirPlayServer::~CAirPlayServer()
@@ -685,7 +685,7 @@ void CAirTunesServer::RegisterActionListener(bool doRegister)
 
   if (doRegister)
   {
-    CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
+    CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this, ANNOUNCEMENT::Player);
     appListener->RegisterActionListener(this);
     ServerInstance->Create();
   }
@@ -14,10 +14,12 @@
 #include "network/Network.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/JSONVariantStreamWriter.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 #include "websocket/WebSocketManager.h"
 
+#include <algorithm>
 #include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +28,16 @@
 #include <memory.h>
 #include <netinet/in.h>
 
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+#define TCPSERVER_USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
+#if !defined(TARGET_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using namespace std::chrono_literals;
 
 #if defined(TARGET_WINDOWS) || defined(HAVE_LIBBLUETOOTH)
@@ -54,12 +66,47 @@ static const bdaddr_t bt_bdaddr_local = {{0, 0, 0, 0xff, 0xff, 0xff}};
 using namespace JSONRPC;
 
 #define RECEIVEBUFFER 4096
+#define SENDBUFFER 16384
+#define MAXEVENTS 256
+#define POLLTIMEOUT 1000
 
 namespace
 {
 constexpr size_t maxBufferLength = 64 * 1024;
+// a client not reading its notifications is dropped once this much is queued for it
+constexpr size_t maxSendQueueLength = 1024 * 1024;
+
+constexpr uint32_t POLL_READ = 1 << 0;
+constexpr uint32_t POLL_WRITE = 1 << 1;
+constexpr uint32_t POLL_CLOSE = 1 << 2;
+
+#if defined(MSG_NOSIGNAL)
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+bool SetNonBlocking(SOCKET socket)
+{
+#ifdef TARGET_WINDOWS
+  u_long nonblocking = 1;
+  return ioctlsocket(socket, FIONBIO, &nonblocking) == 0;
+#else
+  return fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK) == 0;
+#endif
 }
 
+bool WouldBlock()
+{
+#ifdef TARGET_WINDOWS
+  const int error = WSAGetLastError();
+  return error == WSAEWOULDBLOCK || error == WSAEINTR;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+} // unnamed namespace
+
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
 bool CTCPServer::StartServer(int port, bool nonlocal)
@@ -108,113 +155,418 @@ void CTCPServer::Process()
 {
   m_bStop = false;
 
+  std::vector<std::pair<SOCKET, uint32_t>> events;
   while (!m_bStop)
   {
-    SOCKET          max_fd = 0;
-    fd_set          rfds;
-    struct timeval  to     = {1, 0};
-    FD_ZERO(&rfds);
+    if (!Poll(events))
+    {
+      CLog::Log(LOGERROR, "JSONRPC Server: Polling failed");
+      CThread::Sleep(1000ms);
+      Initialize();
+      continue;
+    }
 
-    for (auto& it : m_servers)
+    for (const auto& event : events)
     {
-      FD_SET(it, &rfds);
-      if ((intptr_t)it > (intptr_t)max_fd)
-        max_fd = it;
+      const SOCKET socket = event.first;
+
+#if !defined(TARGET_WINDOWS)
+      if (socket == m_wakeFds[0])
+      {
+        char buffer[64];
+        while (read(m_wakeFds[0], buffer, sizeof(buffer)) > 0)
+          ;
+        FlushDirtyClients();
+        continue;
+      }
+#endif
+
+      if (std::find(m_servers.begin(), m_servers.end(), socket) != m_servers.end())
+      {
+        AcceptConnections(socket);
+        continue;
+      }
+
+      const auto it = m_connections.find(socket);
+      if (it == m_connections.end())
+        continue;
+
+      CTCPClient* client = it->second;
+      if (event.second & POLL_CLOSE)
+      {
+        CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+        RemoveClient(socket);
+        continue;
+      }
+
+      if (event.second & POLL_READ)
+      {
+        client = ReadFromClient(socket, client);
+        if (client == nullptr)
+          continue;
+      }
+
+      // send the responses right away instead of waiting for the next poll
+      WriteToClient(socket, client);
     }
+  }
+
+  Deinitialize();
+}
+
+void CTCPServer::AcceptConnections(SOCKET server)
+{
+  // the listening sockets are non-blocking, take all pending connections at once
+  while (true)
+  {
+    CTCPClient *newconnection = new CTCPClient();
+    newconnection->m_socket =
+        accept(server, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
 
-    for (unsigned int i = 0; i < m_connections.size(); i++)
+    if (newconnection->m_socket == INVALID_SOCKET)
     {
-      FD_SET(m_connections[i]->m_socket, &rfds);
-      if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
-        max_fd = m_connections[i]->m_socket;
+      const bool wouldBlock = WouldBlock();
+      delete newconnection;
+      if (wouldBlock)
+        return;
+
+      CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: {}", errno);
+      if (EBADF == errno)
+      {
+        CThread::Sleep(1000ms);
+        Initialize();
+      }
+      return;
     }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
-    if (res < 0)
+    CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
+#if !defined(TCPSERVER_USE_EPOLL) && !defined(TARGET_WINDOWS)
+    // select() can't watch descriptors beyond FD_SETSIZE
+    if (newconnection->m_socket >= FD_SETSIZE)
     {
-      CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
-      CThread::Sleep(1000ms);
-      Initialize();
+      CLog::Log(LOGERROR, "JSONRPC Server: Too many open files, refusing new connection");
+      newconnection->Disconnect();
+      delete newconnection;
+      continue;
     }
-    else if (res > 0)
+#endif
+    if (!SetNonBlocking(newconnection->m_socket))
     {
-      for (int i = m_connections.size() - 1; i >= 0; i--)
-      {
-        int socket = m_connections[i]->m_socket;
-        if (FD_ISSET(socket, &rfds))
-        {
-          char buffer[RECEIVEBUFFER] = {};
-          int  nread = 0;
-          nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
-          bool close = false;
-          if (nread > 0)
-          {
-            std::string response;
-            if (m_connections[i]->IsNew())
-            {
-              CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
-
-              if (!response.empty())
-                m_connections[i]->Send(response.c_str(), response.size());
-
-              if (websocket != NULL)
-              {
-                // Replace the CTCPClient with a CWebSocketClient
-                CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
-                delete m_connections[i];
-                m_connections.erase(m_connections.begin() + i);
-                m_connections.insert(m_connections.begin() + i, websocketClient);
-              }
-            }
-
-            if (response.size() <= 0)
-              m_connections[i]->PushBuffer(this, buffer, nread);
-
-            close = m_connections[i]->Closing();
-          }
-          else
-            close = true;
+      CLog::Log(LOGERROR, "JSONRPC Server: Failed to set up new connection");
+      newconnection->Disconnect();
+      delete newconnection;
+      continue;
+    }
 
-          if (close)
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
-            m_connections[i]->Disconnect();
-            delete m_connections[i];
-            m_connections.erase(m_connections.begin() + i);
-          }
-        }
-      }
+    newconnection->m_pollEvents = POLL_READ;
+    AddPolling(newconnection->m_socket);
+
+    std::unique_lock<CCriticalSection> lock(m_connectionsLock);
+    m_connections.emplace(newconnection->m_socket, newconnection);
+    CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+  }
+}
+
+CTCPServer::CTCPClient* CTCPServer::ReadFromClient(SOCKET socket, CTCPClient* client)
+{
+  char buffer[RECEIVEBUFFER] = {};
+  const int nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
+  if (nread < 0 && WouldBlock())
+    return client;
 
-      for (auto& it : m_servers)
+  bool close = false;
+  if (nread > 0)
+  {
+    std::string response;
+    if (client->IsNew())
+    {
+      CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
+
+      if (!response.empty())
+        client->Send(response.c_str(), response.size());
+
+      if (websocket != NULL)
       {
-        if (FD_ISSET(it, &rfds))
+        // Replace the CTCPClient with a CWebSocketClient
+        CWebSocketClient* websocketClient;
         {
-          CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
-          CTCPClient *newconnection = new CTCPClient();
-          newconnection->m_socket =
-              accept(it, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
-
-          if (newconnection->m_socket == INVALID_SOCKET)
-          {
-            CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: {}", errno);
-            if (EBADF == errno)
-            {
-              CThread::Sleep(1000ms);
-              Initialize();
-              break;
-            }
-          }
-          else
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
-            m_connections.push_back(newconnection);
-          }
+          std::unique_lock<CCriticalSection> lock(m_connectionsLock);
+          std::unique_lock<CCriticalSection> clientLock(client->m_critSection);
+          websocketClient = new CWebSocketClient(websocket, *client);
+          m_connections[socket] = websocketClient;
         }
+        delete client;
+        client = websocketClient;
       }
     }
+
+    if (response.size() <= 0)
+      client->PushBuffer(this, buffer, nread);
+
+    close = client->Closing();
   }
+  else
+    close = true;
 
-  Deinitialize();
+  if (close)
+  {
+    CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+    RemoveClient(socket);
+    return nullptr;
+  }
+
+  return client;
+}
+
+void CTCPServer::WriteToClient(SOCKET socket, CTCPClient* client)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(client->m_critSection);
+    if (client->Flush() && !client->Closing())
+    {
+      UpdatePolling(*client);
+      return;
+    }
+  }
+
+  CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+  RemoveClient(socket);
+}
+
+void CTCPServer::FlushDirtyClients()
+{
+  std::vector<SOCKET> dirty;
+  {
+    std::unique_lock<CCriticalSection> lock(m_connectionsLock);
+    dirty.swap(m_dirtyConnections);
+  }
+
+  for (const SOCKET socket : dirty)
+  {
+    const auto it = m_connections.find(socket);
+    if (it == m_connections.end())
+      continue;
+
+    {
+      std::unique_lock<CCriticalSection> lock(it->second->m_critSection);
+      it->second->m_dirty = false;
+    }
+
+    WriteToClient(socket, it->second);
+  }
+}
+
+void CTCPServer::RemoveClient(SOCKET socket)
+{
+  const auto it = m_connections.find(socket);
+  if (it == m_connections.end())
+    return;
+
+  CTCPClient* client = it->second;
+  RemovePolling(socket);
+  client->Disconnect();
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_connectionsLock);
+    m_connections.erase(it);
+  }
+
+  delete client;
+}
+
+bool CTCPServer::InitializePolling()
+{
+  DeinitializePolling();
+
+#if defined(TCPSERVER_USE_EPOLL)
+  m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (m_epollFd < 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to create epoll instance: {}", errno);
+    return false;
+  }
+#endif
+
+#if !defined(TARGET_WINDOWS)
+  if (pipe(m_wakeFds) < 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to create wake up pipe: {}", errno);
+    m_wakeFds[0] = m_wakeFds[1] = -1;
+    DeinitializePolling();
+    return false;
+  }
+
+  SetNonBlocking(m_wakeFds[0]);
+  SetNonBlocking(m_wakeFds[1]);
+  AddPolling(m_wakeFds[0]);
+#endif
+
+  for (const auto& server : m_servers)
+  {
+    SetNonBlocking(server);
+    AddPolling(server);
+  }
+
+  return true;
+}
+
+void CTCPServer::DeinitializePolling()
+{
+#if defined(TCPSERVER_USE_EPOLL)
+  if (m_epollFd >= 0)
+    close(m_epollFd);
+  m_epollFd = -1;
+#endif
+
+#if !defined(TARGET_WINDOWS)
+  for (int& fd : m_wakeFds)
+  {
+    if (fd >= 0)
+      close(fd);
+    fd = -1;
+  }
+#endif
+}
+
+bool CTCPServer::Poll(std::vector<std::pair<SOCKET, uint32_t>>& events)
+{
+  events.clear();
+
+#if defined(TCPSERVER_USE_EPOLL)
+  struct epoll_event ready[MAXEVENTS];
+  const int res = epoll_wait(m_epollFd, ready, MAXEVENTS, POLLTIMEOUT);
+  if (res < 0)
+    return errno == EINTR;
+
+  for (int i = 0; i < res; i++)
+  {
+    uint32_t flags = 0;
+    if (ready[i].events & (EPOLLERR | EPOLLHUP))
+      flags |= POLL_CLOSE;
+    if (ready[i].events & EPOLLIN)
+      flags |= POLL_READ;
+    if (ready[i].events & EPOLLOUT)
+      flags |= POLL_WRITE;
+    events.emplace_back(static_cast<SOCKET>(ready[i].data.fd), flags);
+  }
+
+  return true;
+#else
+  SOCKET          max_fd = 0;
+  fd_set          rfds, wfds;
+  struct timeval  to     = {POLLTIMEOUT / 1000, 0};
+  FD_ZERO(&rfds);
+  FD_ZERO(&wfds);
+
+  const auto add = [&max_fd](SOCKET socket, fd_set& fds) {
+    FD_SET(socket, &fds);
+    if ((intptr_t)socket > (intptr_t)max_fd)
+      max_fd = socket;
+  };
+
+  for (auto& it : m_servers)
+    add(it, rfds);
+
+#if !defined(TARGET_WINDOWS)
+  add(m_wakeFds[0], rfds);
+#endif
+
+  for (const auto& it : m_connections)
+  {
+    std::unique_lock<CCriticalSection> lock(it.second->m_critSection);
+    if (it.second->m_pollEvents & POLL_READ)
+      add(it.first, rfds);
+    if (it.second->m_pollEvents & POLL_WRITE)
+      add(it.first, wfds);
+  }
+
+  const int res = select((intptr_t)max_fd + 1, &rfds, &wfds, NULL, &to);
+  if (res < 0)
+    return false;
+  if (res == 0)
+    return true;
+
+  for (auto& it : m_servers)
+  {
+    if (FD_ISSET(it, &rfds))
+      events.emplace_back(it, POLL_READ);
+  }
+
+#if !defined(TARGET_WINDOWS)
+  if (FD_ISSET(m_wakeFds[0], &rfds))
+    events.emplace_back(m_wakeFds[0], POLL_READ);
+#endif
+
+  for (const auto& it : m_connections)
+  {
+    uint32_t flags = 0;
+    if (FD_ISSET(it.first, &rfds))
+      flags |= POLL_READ;
+    if (FD_ISSET(it.first, &wfds))
+      flags |= POLL_WRITE;
+    if (flags != 0)
+      events.emplace_back(it.first, flags);
+  }
+
+  return true;
+#endif
+}
+
+void CTCPServer::AddPolling(SOCKET socket)
+{
+#if defined(TCPSERVER_USE_EPOLL)
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = socket;
+  if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, socket, &event) < 0)
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to poll socket: {}", errno);
+#endif
+}
+
+void CTCPServer::RemovePolling(SOCKET socket)
+{
+#if defined(TCPSERVER_USE_EPOLL)
+  epoll_ctl(m_epollFd, EPOLL_CTL_DEL, socket, NULL);
+#endif
+}
+
+void CTCPServer::UpdatePolling(CTCPClient& client)
+{
+  uint32_t events = 0;
+  if (client.WantsRead())
+    events |= POLL_READ;
+  // a failed client is closed by the server thread once it is writable
+  if (client.HasPendingData() || client.Closing())
+    events |= POLL_WRITE;
+
+  if (events == client.m_pollEvents || client.m_socket == INVALID_SOCKET)
+    return;
+
+  client.m_pollEvents = events;
+
+#if defined(TCPSERVER_USE_EPOLL)
+  struct epoll_event event = {};
+  if (events & POLL_READ)
+    event.events |= EPOLLIN;
+  if (events & POLL_WRITE)
+    event.events |= EPOLLOUT;
+  event.data.fd = client.m_socket;
+  epoll_ctl(m_epollFd, EPOLL_CTL_MOD, client.m_socket, &event);
+#else
+  WakeUp();
+#endif
+}
+
+void CTCPServer::WakeUp()
+{
+#if !defined(TARGET_WINDOWS)
+  if (m_wakeFds[1] >= 0)
+  {
+    const char c = 0;
+    if (write(m_wakeFds[1], &c, 1) < 0 && errno != EAGAIN)
+      CLog::Log(LOGERROR, "JSONRPC Server: Failed to wake up: {}", errno);
+  }
+#endif
 }
 
 bool CTCPServer::PrepareDownload(const char *path, CVariant &details, std::string &protocol)
@@ -237,21 +589,44 @@ void CTCPServer::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
                           const std::string& message,
                           const CVariant& data)
 {
-  if (m_connections.empty())
-    return;
-
-  std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+  std::unique_lock<CCriticalSection> lock(m_connectionsLock);
 
-  for (unsigned int i = 0; i < m_connections.size(); i++)
+  // serialized once when the first interested client is found and shared by all clients
+  std::shared_ptr<const std::string> str;
+  for (const auto& connection : m_connections)
   {
+    CTCPClient* client = connection.second;
+    std::unique_lock<CCriticalSection> clientLock(client->m_critSection);
+    if ((client->GetAnnouncementFlags() & flag) == 0)
+      continue;
+
+    if (!str)
     {
-      std::unique_lock<CCriticalSection> lock(m_connections[i]->m_critSection);
-      if ((m_connections[i]->GetAnnouncementFlags() & flag) == 0)
-        continue;
+      str = std::make_shared<const std::string>(IJSONRPCAnnouncer::AnnouncementToJSONRPC(
+          flag, sender, message, data,
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact));
+      m_announcements++;
+      m_announcementBytes += str->size();
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    client->Send(str);
+
+    if (m_wakeFds[1] < 0)
+    {
+      // no way to wake up the server thread, write right away
+      client->Flush();
+      UpdatePolling(*client);
+    }
+    else if (!client->m_dirty)
+    {
+      client->m_dirty = true;
+      m_dirtyConnections.push_back(connection.first);
+    }
   }
+
+  // the server thread writes to all clients in one go, batching bursts of announcements
+  if (str && m_wakeFds[1] >= 0)
+    WakeUp();
 }
 
 bool CTCPServer::Initialize()
@@ -263,7 +638,7 @@ bool CTCPServer::Initialize()
   started |= InitializeBlue();
   started |= InitializeTCP();
 
-  if (started)
+  if (started && InitializePolling())
   {
     CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
     CLog::Log(LOGINFO, "JSONRPC Server: Successfully initialized");
@@ -479,13 +854,26 @@ bool CTCPServer::InitializeTCP()
 
 void CTCPServer::Deinitialize()
 {
-  for (unsigned int i = 0; i < m_connections.size(); i++)
+  if (m_announcements > 0)
+  {
+    CLog::Log(LOGDEBUG, "JSONRPC Server: Serialized {} announcements, {} bytes", m_announcements,
+              m_announcementBytes);
+    m_announcements = 0;
+    m_announcementBytes = 0;
+  }
+
   {
-    m_connections[i]->Disconnect();
-    delete m_connections[i];
+    std::unique_lock<CCriticalSection> lock(m_connectionsLock);
+    for (const auto& connection : m_connections)
+    {
+      connection.second->Disconnect();
+      delete connection.second;
+    }
+
+    m_connections.clear();
   }
 
-  m_connections.clear();
+  DeinitializePolling();
 
   for (unsigned int i = 0; i < m_servers.size(); i++)
     closesocket(m_servers[i]);
@@ -543,12 +931,133 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
 
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
-  unsigned int sent = 0;
-  do
+  Queue(std::make_shared<const std::string>(data, size));
+}
+
+void CTCPServer::CTCPClient::Send(const std::shared_ptr<const std::string>& message)
+{
+  Queue(message);
+}
+
+void CTCPServer::CTCPClient::Queue(std::shared_ptr<const std::string> message)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_socket == INVALID_SOCKET || m_sendFailed)
+    return;
+
+  if (m_sendQueueLength + message->size() > maxSendQueueLength)
   {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    CLog::Log(LOGINFO, "JSONRPC Server: client send queue size {} exceeded", maxSendQueueLength);
+    m_sendFailed = true;
+    return;
+  }
+
+  m_sendQueueLength += message->size();
+  m_sendQueue.push_back({std::move(message), nullptr, nullptr});
+}
+
+void CTCPServer::CTCPClient::SendResponse(CVariant&& response)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_socket == INVALID_SOCKET || m_sendFailed)
+    return;
+
+  auto value = std::make_shared<CVariant>(std::move(response));
+  auto writer = std::make_shared<CJSONVariantStreamWriter>(
+      *value, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
+  // serialize the response while sending it, large responses never need to be held in memory
+  if (HasPendingData())
+  {
+    // keep the order of the messages, no further requests are read until it is written
+    m_sendQueue.push_back({nullptr, std::move(value), std::move(writer)});
+    m_queuedResponses++;
+    return;
+  }
+
+  m_response = std::move(value);
+  m_responseWriter = std::move(writer);
+}
+
+bool CTCPServer::CTCPClient::Flush()
+{
+  while (!m_sendFailed && m_socket != INVALID_SOCKET)
+  {
+    const std::string& current = m_sendMessage ? *m_sendMessage : m_sendBuffer;
+    if (m_sendOffset == current.size())
+    {
+      m_sendMessage.reset();
+      m_sendBuffer.clear();
+      m_sendOffset = 0;
+
+      if (m_responseWriter)
+      {
+        m_sendBuffer.resize(SENDBUFFER);
+        m_sendBuffer.resize(m_responseWriter->Read(&m_sendBuffer[0], SENDBUFFER));
+        if (m_sendBuffer.empty())
+        {
+          if (m_responseWriter->HasFailed())
+            CLog::Log(LOGERROR, "JSONRPC Server: Failed to serialize response");
+
+          m_responseWriter.reset();
+          m_response.reset();
+        }
+        continue;
+      }
+
+      if (m_sendQueue.empty())
+        return true;
+
+      QueuedMessage& next = m_sendQueue.front();
+      if (next.responseWriter)
+      {
+        m_response = std::move(next.response);
+        m_responseWriter = std::move(next.responseWriter);
+        m_sendQueue.pop_front();
+        m_queuedResponses--;
+        continue;
+      }
+
+      if (next.message->size() >= SENDBUFFER)
+      {
+        m_sendMessage = std::move(next.message);
+        m_sendQueue.pop_front();
+        m_sendQueueLength -= m_sendMessage->size();
+        continue;
+      }
+
+      // batch small messages (e.g. a burst of announcements) into one write
+      while (!m_sendQueue.empty() && m_sendQueue.front().message &&
+             m_sendBuffer.size() + m_sendQueue.front().message->size() <= SENDBUFFER)
+      {
+        m_sendBuffer.append(*m_sendQueue.front().message);
+        m_sendQueueLength -= m_sendQueue.front().message->size();
+        m_sendQueue.pop_front();
+      }
+      continue;
+    }
+
+    const int result = send(m_socket, current.data() + m_sendOffset,
+                            current.size() - m_sendOffset, SEND_FLAGS);
+    if (result < 0)
+    {
+      if (WouldBlock())
+        return true;
+
+      m_sendFailed = true;
+      break;
+    }
+
+    m_sendOffset += result;
+  }
+
+  return false;
+}
+
+bool CTCPServer::CTCPClient::HasPendingData() const
+{
+  const size_t size = m_sendMessage ? m_sendMessage->size() : m_sendBuffer.size();
+  return m_sendOffset < size || m_responseWriter || !m_sendQueue.empty();
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -614,8 +1123,9 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
       }
       if (m_beginBrackets > 0 && m_endBrackets > 0 && m_beginBrackets == m_endBrackets)
       {
-        std::string line = CJSONRPC::MethodCall(m_buffer, host, this);
-        Send(line.c_str(), line.size());
+        CVariant response;
+        if (CJSONRPC::MethodCall(m_buffer, host, this, response))
+          SendResponse(std::move(response));
         m_beginChar = m_beginBrackets = m_endBrackets = 0;
         m_buffer.clear();
       }
@@ -625,9 +1135,11 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
 
 void CTCPServer::CTCPClient::Disconnect()
 {
+  std::unique_lock<CCriticalSection> lock(m_critSection);
   if (m_socket > 0)
   {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
+    // hand out whatever the socket still accepts
+    Flush();
     shutdown(m_socket, SHUT_RDWR);
     closesocket(m_socket);
     m_socket = INVALID_SOCKET;
@@ -646,6 +1158,17 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_sendMessage       = client.m_sendMessage;
+  m_sendBuffer        = client.m_sendBuffer;
+  m_sendOffset        = client.m_sendOffset;
+  m_sendQueue         = client.m_sendQueue;
+  m_sendQueueLength   = client.m_sendQueueLength;
+  m_queuedResponses   = client.m_queuedResponses;
+  m_sendFailed        = client.m_sendFailed;
+  m_response          = client.m_response;
+  m_responseWriter    = client.m_responseWriter;
+  m_pollEvents        = client.m_pollEvents;
+  m_dirty             = client.m_dirty;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -695,6 +1218,29 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
 }
 
+void CTCPServer::CWebSocketClient::Send(const std::shared_ptr<const std::string>& message)
+{
+  // framed for this client, can't be shared
+  Send(message->c_str(), static_cast<unsigned int>(message->size()));
+}
+
+void CTCPServer::CWebSocketClient::SendResponse(CVariant&& response)
+{
+  // a response is sent as one message
+  CJSONVariantStreamWriter writer(
+      response,
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
+  std::string str;
+  if (!writer.ReadAll(str))
+  {
+    CLog::Log(LOGERROR, "WebSocket: Failed to serialize response");
+    return;
+  }
+
+  Send(str.c_str(), str.size());
+}
+
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   bool send;
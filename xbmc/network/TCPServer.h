@@ -15,12 +15,18 @@
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
 
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <sys/socket.h>
 
 #include "PlatformDefs.h"
 
+class CJSONVariantStreamWriter;
 class CVariant;
 
 namespace JSONRPC
@@ -50,6 +56,21 @@ namespace JSONRPC
     bool InitializeTCP();
     void Deinitialize();
 
+    class CTCPClient;
+    void AcceptConnections(SOCKET server);
+    CTCPClient* ReadFromClient(SOCKET socket, CTCPClient* client);
+    void WriteToClient(SOCKET socket, CTCPClient* client);
+    void RemoveClient(SOCKET socket);
+
+    bool InitializePolling();
+    void DeinitializePolling();
+    bool Poll(std::vector<std::pair<SOCKET, uint32_t>>& events);
+    void AddPolling(SOCKET socket);
+    void RemovePolling(SOCKET socket);
+    void UpdatePolling(CTCPClient& client);
+    void WakeUp();
+    void FlushDirtyClients();
+
     class CTCPClient : public IClient
     {
     public:
@@ -64,26 +85,72 @@ namespace JSONRPC
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
 
+      /*!
+       * \brief Queue a message to be sent to the client.
+       *
+       * Never blocks, the server thread writes the queued messages once the socket is
+       * writable, batching small ones into a single write. A client not reading its
+       * messages is disconnected once the queue exceeds its limit.
+       */
       virtual void Send(const char *data, unsigned int size);
+      //! Queue a message shared with other clients, e.g. an announcement
+      virtual void Send(const std::shared_ptr<const std::string>& message);
+      virtual void SendResponse(CVariant&& response);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
       virtual bool IsNew() const { return m_new; }
-      virtual bool Closing() const { return false; }
+      virtual bool Closing() const { return m_sendFailed; }
+
+      /*!
+       * \brief Write as much of the queued data as the socket accepts without blocking.
+       * \return False if the connection failed, true otherwise
+       */
+      bool Flush();
+
+      //! Whether data is waiting to be sent, must be called with m_critSection held
+      bool HasPendingData() const;
+      //! Whether the client's requests should be read, must be called with m_critSection held
+      bool WantsRead() const { return m_responseWriter == nullptr && m_queuedResponses == 0; }
 
       SOCKET m_socket;
       sockaddr_storage m_cliaddr;
       socklen_t m_addrlen;
       CCriticalSection m_critSection;
+      uint32_t m_pollEvents = 0;
+      bool m_dirty = false; //!< queued for the server thread to flush
 
     protected:
       void Copy(const CTCPClient& client);
+      void Queue(std::shared_ptr<const std::string> message);
     private:
       bool m_new;
       int m_announcementflags;
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+
+      struct QueuedMessage
+      {
+        std::shared_ptr<const std::string> message;
+        // or a response, streamed once the messages queued before it are written
+        std::shared_ptr<CVariant> response;
+        std::shared_ptr<CJSONVariantStreamWriter> responseWriter;
+      };
+
+      // the data currently being written, either a large message or small messages batched
+      // into m_sendBuffer, and the messages queued behind it
+      std::shared_ptr<const std::string> m_sendMessage;
+      std::string m_sendBuffer;
+      size_t m_sendOffset = 0;
+      std::deque<QueuedMessage> m_sendQueue;
+      size_t m_sendQueueLength = 0;
+      size_t m_queuedResponses = 0;
+      bool m_sendFailed = false;
+
+      // a response streamed while it is written, keeping large responses out of the queue
+      std::shared_ptr<CVariant> m_response;
+      std::shared_ptr<CJSONVariantStreamWriter> m_responseWriter;
     };
 
     class CWebSocketClient : public CTCPClient
@@ -96,19 +163,32 @@ namespace JSONRPC
       ~CWebSocketClient() override;
 
       void Send(const char *data, unsigned int size) override;
+      void Send(const std::shared_ptr<const std::string>& message) override;
+      void SendResponse(CVariant&& response) override;
       void PushBuffer(CTCPServer *host, const char *buffer, int length) override;
       void Disconnect() override;
 
       bool IsNew() const override { return m_websocket == NULL; }
-      bool Closing() const override { return m_websocket != NULL && m_websocket->GetState() == WebSocketStateClosed; }
+      bool Closing() const override
+      {
+        return CTCPClient::Closing() ||
+               (m_websocket != NULL && m_websocket->GetState() == WebSocketStateClosed);
+      }
 
     private:
       CWebSocket *m_websocket;
       std::string m_buffer;
     };
 
-    std::vector<CTCPClient*> m_connections;
+    // only modified by the server thread, which therefore reads it without locking
+    std::unordered_map<SOCKET, CTCPClient*> m_connections;
+    CCriticalSection m_connectionsLock;
+    std::vector<SOCKET> m_dirtyConnections; // protected by m_connectionsLock
     std::vector<SOCKET> m_servers;
+    int m_epollFd = -1;
+    uint64_t m_announcements = 0;
+    uint64_t m_announcementBytes = 0;
+    int m_wakeFds[2] = {-1, -1};
     int m_port;
     bool m_nonlocal;
     void* m_sdpd;
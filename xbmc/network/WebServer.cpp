@@ -10,8 +10,10 @@
 
 #include "CompileInfo.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "XBDateTime.h"
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/Settings.h"
@@ -33,9 +35,18 @@
 #include <pthread.h>
 #endif
 
+// MHD sends responses backed by a file descriptor with sendfile() where possible
+#if defined(TARGET_POSIX) && MHD_VERSION >= 0x00094600
+#define WEBSERVER_USE_FD_RESPONSE
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <inttypes.h>
 
 #define MAX_POST_BUFFER_SIZE 2048
+#define STREAM_BLOCK_SIZE 32768
 
 #define PAGE_FILE_NOT_FOUND \
   "<html><head><title>File not found</title></head><body>File not found</body></html>"
@@ -209,6 +220,14 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
         {
           bool cacheable = IsRequestCacheable(request);
 
+          // handle If-None-Match which takes precedence over If-Modified-Since
+          std::string entityTag;
+          const std::string ifNoneMatch = HTTPRequestHandlerUtils::GetRequestHeaderValue(
+              connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+          const bool checkEntityTag = !ifNoneMatch.empty() && handler->GetEntityTag(entityTag);
+          if (cacheable && checkEntityTag && MatchesEntityTag(ifNoneMatch, entityTag))
+            return SendNotModifiedResponse(handler);
+
           CDateTime lastModified;
           if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
           {
@@ -221,18 +240,10 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
             CDateTime ifModifiedSinceDate;
             CDateTime ifUnmodifiedSinceDate;
             // handle If-Modified-Since (but only if the response is cacheable)
-            if (cacheable && ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
+            if (cacheable && !checkEntityTag &&
+                ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
                 lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
-            {
-              struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
-              if (response == nullptr)
-              {
-                m_logger->error("failed to create a HTTP 304 response");
-                return MHD_NO;
-              }
-
-              return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
-            }
+              return SendNotModifiedResponse(handler);
             // handle If-Unmodified-Since
             else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
                      lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
@@ -356,6 +367,10 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
       ret = CreateMemoryDownloadResponse(handler, response);
       break;
 
+    case HTTPStreamDownload:
+      ret = CreateStreamDownloadResponse(handler, response);
+      break;
+
     case HTTPError:
       ret =
           CreateErrorResponse(request.connection, responseDetails.status, request.method, response);
@@ -394,6 +409,11 @@ MHD_RESULT CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler
   if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
     handler->AddResponseHeader(MHD_HTTP_HEADER_LAST_MODIFIED, lastModified.GetAsRFC1123DateTime());
 
+  // if the request handler has set an entity tag and it hasn't been set as a header, add it
+  std::string entityTag;
+  if (handler->CanBeCached() && handler->GetEntityTag(entityTag) && !entityTag.empty())
+    handler->AddResponseHeader(MHD_HTTP_HEADER_ETAG, entityTag);
+
   // check if the request handler has set Cache-Control and add it if not
   if (!handler->HasResponseHeader(MHD_HTTP_HEADER_CACHE_CONTROL))
   {
@@ -485,6 +505,26 @@ bool CWebServer::IsRequestCacheable(const HTTPRequest& request) const
   return true;
 }
 
+bool CWebServer::MatchesEntityTag(const std::string& ifNoneMatch, const std::string& entityTag)
+{
+  if (entityTag.empty())
+    return false;
+
+  // If-None-Match uses the weak comparison so W/ prefixes are ignored
+  const std::string tag = StringUtils::StartsWith(entityTag, "W/") ? entityTag.substr(2) : entityTag;
+  for (auto value : StringUtils::Split(ifNoneMatch, ","))
+  {
+    StringUtils::Trim(value);
+    if (StringUtils::StartsWith(value, "W/"))
+      value.erase(0, 2);
+
+    if (value == "*" || value == tag)
+      return true;
+  }
+
+  return false;
+}
+
 bool CWebServer::IsRequestRanged(const HTTPRequest& request, const CDateTime& lastModified) const
 {
   // parse the Range header and store it in the request object
@@ -781,6 +821,42 @@ MHD_RESULT CWebServer::CreateRedirect(struct MHD_Connection* connection,
   return MHD_YES;
 }
 
+MHD_Response* CWebServer::CreateFileDescriptorResponse(const std::string& filePath,
+                                                       const CHttpRange& range) const
+{
+#if defined(WEBSERVER_USE_FD_RESPONSE)
+  // only plain local files, everything else has to go through the VFS
+  if (!URIUtils::IsHD(filePath) || URIUtils::IsStack(filePath))
+    return nullptr;
+
+  const std::string localPath = CSpecialProtocol::TranslatePath(filePath);
+  if (!CURL(localPath).GetProtocol().empty())
+    return nullptr;
+
+  int fd = open(localPath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat statBuffer;
+  if (fstat(fd, &statBuffer) != 0 || !S_ISREG(statBuffer.st_mode) ||
+      static_cast<uint64_t>(statBuffer.st_size) <= range.GetLastPosition())
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  // MHD takes ownership of the descriptor and closes it when the response is destroyed
+  MHD_Response* response = MHD_create_response_from_fd_at_offset64(
+      range.GetLength(), fd, range.GetFirstPosition());
+  if (response == nullptr)
+    close(fd);
+
+  return response;
+#else
+  return nullptr;
+#endif
+}
+
 MHD_RESULT CWebServer::CreateFileDownloadResponse(
     const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response*& response) const
 {
@@ -888,17 +964,31 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   context->ranges.GetFirstPosition(context->writePosition);
 
   // create the response object
-  response =
-      MHD_create_response_from_callback(totalLength, 2048, &CWebServer::ContentReaderCallback,
-                                        context.get(), &CWebServer::ContentReaderFreeCallback);
-  if (response == nullptr)
+  response = nullptr;
+  // a single range of a local file can be sent without copying it through the VFS
+  CHttpRange firstRange;
+  if (context->rangeCountTotal == 1 && context->ranges.GetFirst(firstRange))
   {
-    m_logger->error("failed to create a HTTP response for {} to be filled from{}", request.pathUrl,
-                    filePath);
-    return MHD_NO;
+    response = CreateFileDescriptorResponse(filePath, firstRange);
+    if (response != nullptr && CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+      m_logger->debug("[OUT] sending {} bytes of {} from its file descriptor",
+                      firstRange.GetLength(), filePath);
   }
 
-  context.release(); // ownership was passed to mhd
+  if (response == nullptr)
+  {
+    response =
+        MHD_create_response_from_callback(totalLength, 2048, &CWebServer::ContentReaderCallback,
+                                          context.get(), &CWebServer::ContentReaderFreeCallback);
+    if (response == nullptr)
+    {
+      m_logger->error("failed to create a HTTP response for {} to be filled from{}",
+                      request.pathUrl, filePath);
+      return MHD_NO;
+    }
+
+    context.release(); // ownership was passed to mhd
+  }
 
   // add Content-Range header
   if (ranged)
@@ -913,6 +1003,32 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   return MHD_YES;
 }
 
+MHD_RESULT CWebServer::CreateStreamDownloadResponse(
+    const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response*& response) const
+{
+  if (handler == nullptr)
+    return MHD_NO;
+
+  // keep the request handler alive until MHD is done with the response
+  std::unique_ptr<std::shared_ptr<IHTTPRequestHandler>> context =
+      std::make_unique<std::shared_ptr<IHTTPRequestHandler>>(handler);
+
+  // the length is unknown, so MHD sends the response chunked
+  response = MHD_create_response_from_callback(MHD_SIZE_UNKNOWN, STREAM_BLOCK_SIZE,
+                                               &CWebServer::StreamReaderCallback, context.get(),
+                                               &CWebServer::StreamReaderFreeCallback);
+  if (response == nullptr)
+  {
+    m_logger->error("failed to create a HTTP response for {} to be streamed",
+                    handler->GetRequest().pathUrl);
+    return MHD_NO;
+  }
+
+  context.release(); // ownership was passed to mhd
+
+  return MHD_YES;
+}
+
 MHD_RESULT CWebServer::CreateErrorResponse(struct MHD_Connection* connection,
                                            int responseType,
                                            HTTPMethod method,
@@ -974,6 +1090,19 @@ MHD_RESULT CWebServer::SendResponse(const HTTPRequest& request,
   return ret;
 }
 
+MHD_RESULT CWebServer::SendNotModifiedResponse(
+    const std::shared_ptr<IHTTPRequestHandler>& handler)
+{
+  struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
+  if (response == nullptr)
+  {
+    m_logger->error("failed to create a HTTP 304 response");
+    return MHD_NO;
+  }
+
+  return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+}
+
 MHD_RESULT CWebServer::SendErrorResponse(const HTTPRequest& request,
                                          int errorType,
                                          HTTPMethod method) const
@@ -1114,6 +1243,33 @@ void CWebServer::ContentReaderFreeCallback(void* cls)
     GetLogger()->debug("[OUT] done");
 }
 
+ssize_t CWebServer::StreamReaderCallback(void* cls, uint64_t pos, char* buf, size_t max)
+{
+  auto* handler = static_cast<std::shared_ptr<IHTTPRequestHandler>*>(cls);
+  if (handler == nullptr || *handler == nullptr)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+
+  const ssize_t written = (*handler)->ReadResponseData(buf, max);
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    GetLogger()->debug("[OUT] streamed {} bytes at {}", written, pos);
+
+  if (written < 0)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+  if (written == 0)
+    return MHD_CONTENT_READER_END_OF_STREAM;
+
+  return written;
+}
+
+void CWebServer::StreamReaderFreeCallback(void* cls)
+{
+  delete static_cast<std::shared_ptr<IHTTPRequestHandler>*>(cls);
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    GetLogger()->debug("[OUT] done");
+}
+
 static Logger GetMhdLogger()
 {
   return CServiceBroker::GetLogging().GetLogger("libmicrohttpd");
@@ -1299,6 +1455,15 @@ bool CWebServer::WebServerSupportsSSL()
   return MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES;
 }
 
+bool CWebServer::WebServerSupportsSendFile()
+{
+#if defined(WEBSERVER_USE_FD_RESPONSE)
+  return true;
+#else
+  return false;
+#endif
+}
+
 void CWebServer::SetCredentials(const std::string& username, const std::string& password)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
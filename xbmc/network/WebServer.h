@@ -32,6 +32,7 @@ public:
   bool Stop();
   bool IsStarted();
   static bool WebServerSupportsSSL();
+  static bool WebServerSupportsSendFile();
   void SetCredentials(const std::string &username, const std::string &password);
 
   void RegisterRequestHandler(IHTTPRequestHandler *handler);
@@ -62,6 +63,14 @@ protected:
   virtual MHD_RESULT HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handler);
   virtual MHD_RESULT FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int responseStatus, struct MHD_Response *response);
 
+  /*! \brief Create a response sending a range of a plain local file from its file descriptor
+   \param filePath path of the file to send
+   \param range the range of the file to send
+   \return the response, nullptr if the file has to be read through the VFS
+   */
+  virtual struct MHD_Response* CreateFileDescriptorResponse(const std::string& filePath,
+                                                            const CHttpRange& range) const;
+
 private:
   struct MHD_Daemon* StartMHD(unsigned int flags, int port);
 
@@ -72,6 +81,7 @@ private:
 
   bool IsRequestCacheable(const HTTPRequest& request) const;
   bool IsRequestRanged(const HTTPRequest& request, const CDateTime &lastModified) const;
+  static bool MatchesEntityTag(const std::string& ifNoneMatch, const std::string& entityTag);
 
   void SetupPostDataProcessing(const HTTPRequest& request, ConnectionHandler *connectionHandler, std::shared_ptr<IHTTPRequestHandler> handler, void **con_cls) const;
   bool ProcessPostData(const HTTPRequest& request, ConnectionHandler *connectionHandler, const char *upload_data, size_t *upload_data_size, void **con_cls) const;
@@ -82,10 +92,12 @@ private:
 
   MHD_RESULT CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response) const;
   MHD_RESULT CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
+  MHD_RESULT CreateStreamDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
   MHD_RESULT CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const;
   MHD_RESULT CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const;
 
   MHD_RESULT SendResponse(const HTTPRequest& request, int responseStatus, MHD_Response *response) const;
+  MHD_RESULT SendNotModifiedResponse(const std::shared_ptr<IHTTPRequestHandler>& handler);
   MHD_RESULT SendErrorResponse(const HTTPRequest& request, int errorType, HTTPMethod method) const;
 
   MHD_RESULT AddHeader(struct MHD_Response *response, const std::string &name, const std::string &value) const;
@@ -101,6 +113,9 @@ private:
   static ssize_t ContentReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
   static void ContentReaderFreeCallback(void *cls);
 
+  static ssize_t StreamReaderCallback(void* cls, uint64_t pos, char* buf, size_t max);
+  static void StreamReaderFreeCallback(void* cls);
+
   static MHD_RESULT AnswerToConnection (void *cls, struct MHD_Connection *connection,
                         const char *url, const char *method,
                         const char *version, const char *upload_data,
@@ -8,15 +8,21 @@
 
 #include "HTTPImageTransformationHandler.h"
 
+#include "ServiceBroker.h"
+#include "TextureCache.h"
 #include "TextureCacheJob.h"
+#include "TextureDatabase.h"
 #include "URL.h"
 #include "filesystem/ImageFile.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
+#include <cstdlib>
 #include <map>
 
 #define TRANSFORMATION_OPTION_WIDTH             "width"
@@ -25,6 +31,16 @@
 
 static const std::string ImageBasePath = "/image/";
 
+static unsigned int GetOptionValue(const std::map<std::string, std::string>& options,
+                                   const std::string& name)
+{
+  const auto option = options.find(name);
+  if (option == options.end() || !StringUtils::IsInteger(option->second))
+    return 0;
+
+  return strtoul(option->second.c_str(), nullptr, 0);
+}
+
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
   : m_url(),
     m_lastModified(),
@@ -64,6 +80,38 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   StringUtils::ToLower(ext);
   m_response.contentType = CMime::GetMimeType(ext);
 
+  // get the transformation options
+  std::map<std::string, std::string> options;
+  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
+
+  std::vector<std::string> urlOptions;
+  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
+
+  // the transformed image is cached in the texture cache under the wrapped URL with its options
+  const std::string originalPath = pathToUrl.IsProtocol("image") ? pathToUrl.GetHostName() : m_url;
+  m_imagePath = CTextureUtils::GetWrappedImageURL(
+      originalPath, pathToUrl.IsProtocol("image") ? pathToUrl.GetUserName() : "",
+      StringUtils::Join(urlOptions, "&"));
+
+  // the texture cache limits images to the configured image resolution, larger transformations
+  // are resized on every request as before
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const unsigned int maxHeight = advancedSettings->m_imageRes;
+  const unsigned int maxWidth = maxHeight * 16 / 9;
+  m_useTextureCache = GetOptionValue(options, TRANSFORMATION_OPTION_WIDTH) <= maxWidth &&
+                      GetOptionValue(options, TRANSFORMATION_OPTION_HEIGHT) <= maxHeight;
+
   //! @todo determine the maximum age
 
   // determine the last modified date
@@ -71,6 +119,16 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   if (imageFile.Stat(pathToUrl, &statBuffer) != 0)
     return;
 
+  // a cached transformation of an image that changed since is recached, just like the entity tag
+  // changes along with the image
+  if (m_useTextureCache)
+    m_imageHash = CTextureCacheJob::GetImageHash(originalPath, statBuffer);
+
+  // the entity tag identifies the transformation and the state of the original image
+  m_entityTag = StringUtils::Format(
+      "\"{}-{:x}-{:x}\"", URIUtils::GetFileName(CTextureCache::GetCacheFile(m_imagePath)),
+      static_cast<int64_t>(statBuffer.st_mtime), static_cast<int64_t>(statBuffer.st_size));
+
   struct tm *time;
 #ifdef HAVE_LOCALTIME_R
   struct tm result = {};
@@ -110,33 +168,25 @@ MHD_RESULT CHTTPImageTransformationHandler::HandleRequest()
   if (m_response.type == HTTPError)
     return MHD_YES;
 
-  // get the transformation options
-  std::map<std::string, std::string> options;
-  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
-
-  std::vector<std::string> urlOptions;
-  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
+  // serve the transformed image from the texture cache, caching it first if necessary. Concurrent
+  // requests for the same transformation wait for the first one to finish caching it.
+  CTextureDetails details;
+  const std::shared_ptr<CTextureCache> textureCache = CServiceBroker::GetTextureCache();
+  if (m_useTextureCache && textureCache && textureCache->CacheImage(m_imagePath, details, m_imageHash))
+  {
+    m_cachedFile = CTextureCache::GetCachedPath(details.file);
+    m_response.type = HTTPFileDownload;
 
-  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
+    std::string ext = URIUtils::GetExtension(details.file);
+    StringUtils::ToLower(ext);
+    m_response.contentType = CMime::GetMimeType(ext);
 
-  std::string imagePath = m_url;
-  if (!urlOptions.empty())
-  {
-    imagePath += "?";
-    imagePath += StringUtils::Join(urlOptions, "&");
+    return MHD_YES;
   }
 
   // resize the image into the local buffer
   size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  if (!CTextureCacheJob::ResizeTexture(m_imagePath, m_buffer, bufferSize))
   {
     m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
     m_response.type = HTTPError;
@@ -160,6 +210,15 @@ MHD_RESULT CHTTPImageTransformationHandler::HandleRequest()
   return MHD_YES;
 }
 
+bool CHTTPImageTransformationHandler::GetEntityTag(std::string& entityTag) const
+{
+  if (m_entityTag.empty())
+    return false;
+
+  entityTag = m_entityTag;
+  return true;
+}
+
 bool CHTTPImageTransformationHandler::GetLastModifiedDate(CDateTime &lastModified) const
 {
   if (!m_lastModified.IsValid())
@@ -28,8 +28,10 @@ public:
   bool CanHandleRanges() const override { return true; }
   bool CanBeCached() const override { return true; }
   bool GetLastModifiedDate(CDateTime &lastModified) const override;
+  bool GetEntityTag(std::string& entityTag) const override;
 
   HttpResponseRanges GetResponseData() const override { return m_responseData; }
+  std::string GetResponseFile() const override { return m_cachedFile; }
 
   // priority must be higher than the one of CHTTPImageHandler
   int GetPriority() const override { return 6; }
@@ -39,6 +41,11 @@ protected:
 
 private:
   std::string m_url;
+  std::string m_imagePath;
+  std::string m_entityTag;
+  std::string m_imageHash;
+  std::string m_cachedFile;
+  bool m_useTextureCache = false;
   CDateTime m_lastModified;
 
   uint8_t* m_buffer;
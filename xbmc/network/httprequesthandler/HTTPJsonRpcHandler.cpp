@@ -13,13 +13,24 @@
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "interfaces/json-rpc/JSONServiceDescription.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/FileUtils.h"
+#include "utils/JSONVariantStreamWriter.h"
 #include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
 #define MAX_HTTP_POST_SIZE 65536
 
+CHTTPJsonRpcHandler::CHTTPJsonRpcHandler() = default;
+
+CHTTPJsonRpcHandler::CHTTPJsonRpcHandler(const HTTPRequest& request) : IHTTPRequestHandler(request)
+{
+}
+
+CHTTPJsonRpcHandler::~CHTTPJsonRpcHandler() = default;
+
 bool CHTTPJsonRpcHandler::CanHandleRequest(const HTTPRequest &request) const
 {
   return (request.pathUrl.compare("/jsonrpc") == 0);
@@ -70,25 +81,22 @@ MHD_RESULT CHTTPJsonRpcHandler::HandleRequest()
       jsonpCallback = argument->second;
   }
 
+  bool streamResponse = false;
   if (isRequest)
   {
-    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
-
     if (!jsonpCallback.empty())
-      m_responseData = jsonpCallback + "(" + m_responseData + ");";
+      m_responseData = jsonpCallback + "(" +
+                       JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client) +
+                       ");";
+    else
+      streamResponse = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client,
+                                                     m_responseValue);
   }
   else if (jsonpCallback.empty())
   {
     // get the whole output of JSONRPC.Introspect
-    CVariant result;
-    JSONRPC::CJSONServiceDescription::Print(result, &m_transportLayer, &client);
-    if (!CJSONVariantWriter::Write(result, m_responseData, false))
-    {
-      m_response.type = HTTPError;
-      m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
-
-      return MHD_YES;
-    }
+    JSONRPC::CJSONServiceDescription::Print(m_responseValue, &m_transportLayer, &client);
+    streamResponse = true;
   }
   else
   {
@@ -100,11 +108,24 @@ MHD_RESULT CHTTPJsonRpcHandler::HandleRequest()
 
   m_requestData.clear();
 
+  m_response.status = MHD_HTTP_OK;
+  m_response.contentType = "application/json";
+
+  if (streamResponse)
+  {
+    // don't build the whole response in memory, serialize it while sending it
+    m_responseWriter = std::make_unique<CJSONVariantStreamWriter>(
+        m_responseValue,
+        isRequest &&
+            CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
+    m_response.type = HTTPStreamDownload;
+    return MHD_YES;
+  }
+
   m_responseRange.SetData(m_responseData.c_str(), m_responseData.size());
 
   m_response.type = HTTPMemoryDownloadNoFreeCopy;
-  m_response.status = MHD_HTTP_OK;
-  m_response.contentType = "application/json";
   m_response.totalLength = m_responseData.size();
 
   return MHD_YES;
@@ -118,6 +139,23 @@ HttpResponseRanges CHTTPJsonRpcHandler::GetResponseData() const
   return ranges;
 }
 
+ssize_t CHTTPJsonRpcHandler::ReadResponseData(char* buffer, size_t size)
+{
+  if (!m_responseWriter)
+    return -1;
+
+  const size_t written = m_responseWriter->Read(buffer, size);
+  if (m_responseWriter->HasFailed())
+  {
+    CServiceBroker::GetLogging()
+        .GetLogger("CHTTPJsonRpcHandler")
+        ->error("Failed to serialize JSON-RPC response");
+    return -1;
+  }
+
+  return static_cast<ssize_t>(written);
+}
+
 bool CHTTPJsonRpcHandler::appendPostData(const char *data, size_t size)
 {
   if (m_requestData.size() + size > MAX_HTTP_POST_SIZE)
@@ -11,14 +11,18 @@
 #include "interfaces/json-rpc/IClient.h"
 #include "interfaces/json-rpc/ITransportLayer.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "utils/Variant.h"
 
+#include <memory>
 #include <string>
 
+class CJSONVariantStreamWriter;
+
 class CHTTPJsonRpcHandler : public IHTTPRequestHandler
 {
 public:
-  CHTTPJsonRpcHandler() = default;
-  ~CHTTPJsonRpcHandler() override = default;
+  CHTTPJsonRpcHandler();
+  ~CHTTPJsonRpcHandler() override;
 
   // implementations of IHTTPRequestHandler
   IHTTPRequestHandler* Create(const HTTPRequest &request) const override { return new CHTTPJsonRpcHandler(request); }
@@ -27,13 +31,12 @@ public:
   MHD_RESULT HandleRequest() override;
 
   HttpResponseRanges GetResponseData() const override;
+  ssize_t ReadResponseData(char* buffer, size_t size) override;
 
   int GetPriority() const override { return 5; }
 
 protected:
-  explicit CHTTPJsonRpcHandler(const HTTPRequest &request)
-    : IHTTPRequestHandler(request)
-  { }
+  explicit CHTTPJsonRpcHandler(const HTTPRequest& request);
 
   bool appendPostData(const char *data, size_t size) override;
 
@@ -42,6 +45,10 @@ private:
   std::string m_responseData;
   CHttpResponseRange m_responseRange;
 
+  // large responses are serialized while being sent
+  CVariant m_responseValue;
+  std::unique_ptr<CJSONVariantStreamWriter> m_responseWriter;
+
   class CHTTPTransportLayer : public JSONRPC::ITransportLayer
   {
   public:
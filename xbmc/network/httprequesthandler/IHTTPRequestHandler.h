@@ -60,7 +60,10 @@ typedef enum HTTPResponseType
   HTTPMemoryDownloadFreeNoCopy,
   // creates a HTTP response from a buffer by copying followed by freeing the buffer
   // the buffer must have been malloc'ed and not new'ed
-  HTTPMemoryDownloadFreeCopy
+  HTTPMemoryDownloadFreeCopy,
+  // creates a HTTP response of unknown length (chunked) filled by the request handler while
+  // sending it, see IHTTPRequestHandler::ReadResponseData()
+  HTTPStreamDownload
 } HTTPResponseType;
 
 typedef struct HTTPRequest
@@ -146,6 +149,13 @@ public:
   */
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const { return false; }
 
+  /*!
+   * \brief Returns the entity tag (including the quotes) identifying the response data.
+   *
+   * \details This is only used if the response can be cached.
+   */
+  virtual bool GetEntityTag(std::string& entityTag) const { return false; }
+
   /*!
    * \brief Returns the ranges with raw data belonging to the response.
    *
@@ -153,6 +163,18 @@ public:
    */
   virtual HttpResponseRanges GetResponseData() const { return HttpResponseRanges(); }
 
+  /*!
+   * \brief Fills the given buffer with the next part of the response data.
+   *
+   * \details This is only used if the response type is HTTPStreamDownload. It is called
+   *          repeatedly while sending the response.
+   *
+   * \param buffer Buffer to write the response data to
+   * \param size Size of the buffer
+   * \return Number of bytes written, 0 if the response is complete or -1 on error
+   */
+  virtual ssize_t ReadResponseData(char* buffer, size_t size) { return -1; }
+
   /*!
   * \brief Returns the URL to which the request should be redirected.
   *
@@ -0,0 +1,272 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "interfaces/AnnouncementManager.h"
+#include "network/TCPServer.h"
+#include "utils/Variant.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono;
+
+namespace
+{
+constexpr int CLIENTS = 20;
+
+struct TestClient
+{
+  SOCKET socket = INVALID_SOCKET;
+  std::string buffer;
+};
+} // unnamed namespace
+
+class TestTCPServer : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+#if defined(TARGET_WINDOWS)
+    WSADATA wd;
+    ASSERT_EQ(0, WSAStartup(MAKEWORD(2, 2), &wd));
+#endif
+
+    if (!CServiceBroker::GetAnnouncementManager())
+    {
+      m_announcementManager = std::make_shared<ANNOUNCEMENT::CAnnouncementManager>();
+      m_announcementManager->Start();
+      CServiceBroker::RegisterAnnouncementManager(m_announcementManager);
+    }
+
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<uint16_t> dist(49152, 65535);
+    m_port = dist(mt);
+
+    ASSERT_TRUE(JSONRPC::CTCPServer::StartServer(m_port, false));
+  }
+
+  void TearDown() override
+  {
+    for (const TestClient& client : m_clients)
+      closesocket(client.socket);
+    m_clients.clear();
+
+    JSONRPC::CTCPServer::StopServer(true);
+
+    if (m_announcementManager)
+    {
+      CServiceBroker::UnregisterAnnouncementManager();
+      m_announcementManager->Deinitialize();
+      m_announcementManager.reset();
+    }
+
+#if defined(TARGET_WINDOWS)
+    WSACleanup();
+#endif
+  }
+
+  //! \brief Connect the clients and wait until the server accepted all of them
+  bool ConnectAll(int count)
+  {
+    if (!Connect(count))
+      return false;
+
+    for (int warmup = 0; warmup < 10; warmup++)
+    {
+      if (Announce("warmup" + std::to_string(warmup)) == count)
+        return true;
+    }
+    return false;
+  }
+
+  bool Connect(int count)
+  {
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(m_port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for (int i = 0; i < count; i++)
+    {
+      TestClient client;
+      client.socket = socket(AF_INET, SOCK_STREAM, 0);
+      if (client.socket == INVALID_SOCKET)
+        return false;
+
+      if (connect(client.socket, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+      {
+        closesocket(client.socket);
+        return false;
+      }
+
+      m_clients.push_back(std::move(client));
+    }
+
+    return true;
+  }
+
+  /*!
+   * \brief Announce the given marker and wait for all clients to receive it.
+   * \return The number of clients that received the announcement in time
+   */
+  int Announce(const std::string& marker)
+  {
+    for (TestClient& client : m_clients)
+      client.buffer.clear();
+
+    CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::Other, "xbmc", "TestLatency",
+                                                       CVariant(marker));
+    return Receive("\"" + marker + "\"");
+  }
+
+  /*!
+   * \brief Wait for all clients to receive the expected string.
+   * \return The number of clients that received it in time
+   */
+  int Receive(const std::string& expected)
+  {
+    std::vector<bool> waiting(m_clients.size(), true);
+    const auto timeout = steady_clock::now() + seconds(5);
+    int done = 0;
+    while (done < static_cast<int>(m_clients.size()) && steady_clock::now() < timeout)
+    {
+      fd_set readSet;
+      FD_ZERO(&readSet);
+      SOCKET maxSocket = 0;
+      for (size_t i = 0; i < m_clients.size(); i++)
+      {
+        if (waiting[i])
+        {
+          FD_SET(m_clients[i].socket, &readSet);
+          maxSocket = std::max(maxSocket, m_clients[i].socket);
+        }
+      }
+
+      struct timeval tv = {0, 100000};
+      if (select(static_cast<int>(maxSocket) + 1, &readSet, nullptr, nullptr, &tv) <= 0)
+        continue;
+
+      for (size_t i = 0; i < m_clients.size(); i++)
+      {
+        if (!waiting[i] || !FD_ISSET(m_clients[i].socket, &readSet))
+          continue;
+
+        char buffer[4096];
+        const int length = recv(m_clients[i].socket, buffer, sizeof(buffer), 0);
+        if (length <= 0)
+        {
+          waiting[i] = false;
+          continue;
+        }
+
+        TestClient& client = m_clients[i];
+        client.buffer.append(buffer, length);
+        if (client.buffer.find(expected) != std::string::npos)
+        {
+          waiting[i] = false;
+          done++;
+        }
+      }
+    }
+
+    return done;
+  }
+
+  uint16_t m_port = 0;
+  std::vector<TestClient> m_clients;
+  std::shared_ptr<ANNOUNCEMENT::CAnnouncementManager> m_announcementManager;
+};
+
+TEST_F(TestTCPServer, Notification)
+{
+  ASSERT_TRUE(ConnectAll(CLIENTS));
+
+  for (int round = 0; round < 3; round++)
+    EXPECT_EQ(CLIENTS, Announce("round" + std::to_string(round)));
+}
+
+TEST_F(TestTCPServer, LibraryScanBurst)
+{
+  ASSERT_TRUE(ConnectAll(CLIENTS));
+
+  // a scan announces every item, the marker is announced last and must arrive after all of them
+  constexpr int ANNOUNCEMENTS = 1000;
+  for (int i = 0; i < ANNOUNCEMENTS; i++)
+  {
+    CVariant data;
+    data["item"]["type"] = "movie";
+    data["item"]["id"] = i;
+    CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc",
+                                                       "OnUpdate", data);
+  }
+  ASSERT_EQ(Announce("scanfinished"), CLIENTS);
+
+  for (const TestClient& client : m_clients)
+    EXPECT_NE(client.buffer.find("\"id\":" + std::to_string(ANNOUNCEMENTS - 1)),
+              std::string::npos);
+}
+
+TEST_F(TestTCPServer, SlowClientDoesNotBlock)
+{
+  ASSERT_TRUE(Connect(2));
+  ASSERT_EQ(Announce("warmup"), 2);
+
+  // stop reading on the first client until its queue overflows, the other one must keep up
+  TestClient slow = m_clients.front();
+  m_clients.erase(m_clients.begin());
+
+  const std::string payload(64 * 1024, 'x');
+  for (int i = 0; i < 100; i++)
+    ASSERT_EQ(Announce(payload.substr(0, payload.size() - 8) + std::to_string(i)), 1);
+
+  closesocket(slow.socket);
+}
+
+TEST_F(TestTCPServer, QueuedResponses)
+{
+  ASSERT_TRUE(Connect(1));
+
+  // requests read at once are answered while the first response is still being written
+  constexpr int REQUESTS = 50;
+  for (int round = 0; round < 2; round++)
+  {
+    auto id = [round](int i) {
+      return "\"r" + std::to_string(round) + "-" + std::to_string(i) + "\"";
+    };
+
+    std::string requests;
+    for (int i = 0; i < REQUESTS; i++)
+      requests += "{\"id\":" + id(i) + "}";
+    ASSERT_EQ(static_cast<int>(requests.size()),
+              send(m_clients[0].socket, requests.data(), static_cast<int>(requests.size()), 0));
+
+    m_clients[0].buffer.clear();
+    ASSERT_EQ(1, Receive(id(REQUESTS - 1)));
+
+    // every response arrives once, in the order of the requests
+    size_t position = 0;
+    for (int i = 0; i < REQUESTS; i++)
+    {
+      const size_t found = m_clients[0].buffer.find(id(i), position);
+      ASSERT_NE(std::string::npos, found) << id(i);
+      EXPECT_EQ(std::string::npos, m_clients[0].buffer.find(id(i), found + 1));
+      position = found;
+    }
+  }
+}
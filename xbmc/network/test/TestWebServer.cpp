@@ -28,7 +28,9 @@
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
+#include <atomic>
 #include <random>
+#include <vector>
 
 using namespace XFILE;
 
@@ -40,6 +42,50 @@ using namespace XFILE;
 #define TEST_FILES_DATA_RANGES  "range1;range2;range3"
 #define TEST_FILES_HTML         TEST_FILES_DATA ".html"
 #define TEST_FILES_RANGES       TEST_FILES_DATA "-ranges.txt"
+#define TEST_ENTITY_TAG         "\"test-entity-tag\""
+
+// serves the same files as CHTTPVfsHandler but with an entity tag
+class CTestEntityTagHandler : public CHTTPVfsHandler
+{
+public:
+  CTestEntityTagHandler() = default;
+
+  IHTTPRequestHandler* Create(const HTTPRequest& request) const override
+  {
+    return new CTestEntityTagHandler(request);
+  }
+
+  int GetPriority() const override { return 6; }
+
+  bool GetEntityTag(std::string& entityTag) const override
+  {
+    entityTag = TEST_ENTITY_TAG;
+    return true;
+  }
+
+protected:
+  explicit CTestEntityTagHandler(const HTTPRequest& request) : CHTTPVfsHandler(request) {}
+};
+
+// counts the responses sent from a file descriptor
+class CTestWebServer : public CWebServer
+{
+public:
+  unsigned int GetFileDescriptorResponses() const { return m_fileDescriptorResponses; }
+
+protected:
+  struct MHD_Response* CreateFileDescriptorResponse(const std::string& filePath,
+                                                    const CHttpRange& range) const override
+  {
+    struct MHD_Response* response = CWebServer::CreateFileDescriptorResponse(filePath, range);
+    if (response != nullptr)
+      m_fileDescriptorResponses++;
+    return response;
+  }
+
+private:
+  mutable std::atomic<unsigned int> m_fileDescriptorResponses{0};
+};
 
 class TestWebServer : public testing::Test
 {
@@ -76,6 +122,7 @@ protected:
     if (webserver.IsStarted())
       webserver.Stop();
 
+    webserver.UnregisterRequestHandler(&m_entityTagHandler);
     webserver.UnregisterRequestHandler(&m_vfsHandler);
     webserver.UnregisterRequestHandler(&m_jsonRpcHandler);
 
@@ -351,9 +398,10 @@ protected:
     return StringUtils::Format("bytes={}-{}", start, end);
   }
 
-  CWebServer webserver;
+  CTestWebServer webserver;
   CHTTPJsonRpcHandler m_jsonRpcHandler;
   CHTTPVfsHandler m_vfsHandler;
+  CTestEntityTagHandler m_entityTagHandler;
   std::string baseUrl;
   std::string sourcePath;
   uint16_t webserverPort;
@@ -668,6 +716,89 @@ TEST_F(TestWebServer, CanGetCachedFileWithNewerIfModifiedSinceForcingNoCache)
   CheckRangesTestFileResponse(curl);
 }
 
+TEST_F(TestWebServer, CanGetFileWithEntityTag)
+{
+  webserver.RegisterRequestHandler(&m_entityTagHandler);
+
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  EXPECT_STREQ(TEST_FILES_DATA_RANGES, result.c_str());
+  CheckRangesTestFileResponse(curl);
+  EXPECT_STREQ(TEST_ENTITY_TAG, curl.GetHttpHeader().GetValue(MHD_HTTP_HEADER_ETAG).c_str());
+}
+
+TEST_F(TestWebServer, CanGetCachedFileWithMatchingIfNoneMatch)
+{
+  webserver.RegisterRequestHandler(&m_entityTagHandler);
+
+  // get the file with the entity tag among others, one of them must match
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_NONE_MATCH, "\"other\", W/" TEST_ENTITY_TAG);
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  ASSERT_TRUE(result.empty());
+  CheckRangesTestFileResponse(curl, MHD_HTTP_NOT_MODIFIED, true);
+  EXPECT_STREQ(TEST_ENTITY_TAG, curl.GetHttpHeader().GetValue(MHD_HTTP_HEADER_ETAG).c_str());
+}
+
+TEST_F(TestWebServer, CanGetCachedFileWithOtherIfNoneMatch)
+{
+  webserver.RegisterRequestHandler(&m_entityTagHandler);
+
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_NONE_MATCH, "\"other\"");
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  EXPECT_STREQ(TEST_FILES_DATA_RANGES, result.c_str());
+  CheckRangesTestFileResponse(curl);
+}
+
+TEST_F(TestWebServer, CanGetCachedFileWithOtherIfNoneMatchAndNewerIfModifiedSince)
+{
+  webserver.RegisterRequestHandler(&m_entityTagHandler);
+
+  // get the last modified date of the file
+  CDateTime lastModified;
+  ASSERT_TRUE(GetLastModifiedOfTestFile(TEST_FILES_RANGES, lastModified));
+  CDateTime lastModifiedNewer = lastModified + CDateTimeSpan(1, 0, 0, 0);
+
+  // If-None-Match takes precedence so the newer If-Modified-Since value is ignored
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_NONE_MATCH, "\"other\"");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_MODIFIED_SINCE,
+                        lastModifiedNewer.GetAsRFC1123DateTime());
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  EXPECT_STREQ(TEST_FILES_DATA_RANGES, result.c_str());
+  CheckRangesTestFileResponse(curl);
+}
+
+TEST_F(TestWebServer, CanGetCachedFileWithMatchingIfNoneMatchAndOlderIfModifiedSince)
+{
+  webserver.RegisterRequestHandler(&m_entityTagHandler);
+
+  // get the last modified date of the file
+  CDateTime lastModified;
+  ASSERT_TRUE(GetLastModifiedOfTestFile(TEST_FILES_RANGES, lastModified));
+  CDateTime lastModifiedOlder = lastModified - CDateTimeSpan(1, 0, 0, 0);
+
+  // If-None-Match takes precedence so the older If-Modified-Since value is ignored
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_NONE_MATCH, TEST_ENTITY_TAG);
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_MODIFIED_SINCE,
+                        lastModifiedOlder.GetAsRFC1123DateTime());
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  ASSERT_TRUE(result.empty());
+  CheckRangesTestFileResponse(curl, MHD_HTTP_NOT_MODIFIED, true);
+}
+
 TEST_F(TestWebServer, CanGetCachedFileWithOlderIfUnmodifiedSince)
 {
   // get the last modified date of the file
@@ -924,3 +1055,32 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanGetLocalFile)
+{
+  // local files are sent from their file descriptor, make sure the file and a range are intact
+  std::vector<uint8_t> buffer;
+  ASSERT_LT(0, CFile().LoadFile(URIUtils::AddFileToFolder(sourcePath, "test.png"), buffer));
+  const std::string content(buffer.begin(), buffer.end());
+
+  std::string result;
+  CCurlFile curl;
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile("test.png"), result));
+  EXPECT_TRUE(result == content);
+
+  const size_t rangeStart = 100;
+  const size_t rangeEnd = content.size() - 100;
+  std::string rangeResult;
+  CCurlFile rangeCurl;
+  rangeCurl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, GenerateRangeHeaderValue(rangeStart, rangeEnd));
+  ASSERT_TRUE(rangeCurl.Get(GetUrlOfTestFile("test.png"), rangeResult));
+  EXPECT_NE(std::string::npos, rangeCurl.GetHttpHeader().GetProtoLine().find(
+                                   StringUtils::Format(" {} ", MHD_HTTP_PARTIAL_CONTENT)));
+  EXPECT_STREQ(
+      HttpRangeUtils::GenerateContentRangeHeaderValue(rangeStart, rangeEnd, content.size()).c_str(),
+      rangeCurl.GetHttpHeader().GetValue(MHD_HTTP_HEADER_CONTENT_RANGE).c_str());
+  EXPECT_TRUE(rangeResult == content.substr(rangeStart, rangeEnd - rangeStart + 1));
+
+  EXPECT_EQ(CWebServer::WebServerSupportsSendFile() ? 2u : 0u,
+            webserver.GetFileDescriptorResponses());
+}
@@ -42,6 +42,10 @@ protected:
   void OnSlideShowRecursive(const std::string& strPicture);
   void OnSlideShowRecursive();
   void OnItemLoaded(CFileItem* pItem) override;
+  void OnViewportChanged(const std::vector<CFileItemPtr>& items) override
+  {
+    m_thumbLoader.SetPriorityItems(items);
+  }
   void LoadPlayList(const std::string& strPlayList) override;
 
   CGUIDialogProgress* m_dlgProgress;
@@ -31,6 +31,7 @@
 #include "pictures/PictureThumbLoader.h"
 #include "playlists/PlayListTypes.h"
 #include "rendering/RenderSystem.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/DisplaySettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -40,7 +41,10 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
 #include <random>
+#include <utility>
 
 using namespace XFILE;
 using namespace KODI::MESSAGING;
@@ -48,6 +52,7 @@ using namespace std::chrono_literals;
 
 #define MAX_ZOOM_FACTOR                     10
 #define MAX_PICTURE_SIZE             2048*2048
+#define PRELOAD_JOBS_AT_ONCE                 2
 
 #define IMMEDIATE_TRANSITION_TIME          1
 
@@ -64,6 +69,163 @@ using namespace std::chrono_literals;
 
 static float zoomamount[10] = { 1.0f, 1.2f, 1.5f, 2.0f, 2.8f, 4.0f, 6.0f, 9.0f, 13.5f, 20.0f };
 
+CSlideShowPreloadJob::CSlideShowPreloadJob(const std::string& file,
+                                           int maxWidth,
+                                           int maxHeight,
+                                           const SlideShowPictureLoader& loader)
+  : m_file(file), m_maxWidth(maxWidth), m_maxHeight(maxHeight), m_loader(loader)
+{
+}
+
+CSlideShowPreloadJob::~CSlideShowPreloadJob() = default;
+
+bool CSlideShowPreloadJob::DoWork()
+{
+  const auto start = std::chrono::steady_clock::now();
+  m_texture = m_loader(m_file, m_maxWidth, m_maxHeight);
+  const auto end = std::chrono::steady_clock::now();
+
+  CLog::Log(LOGDEBUG, "Preloaded {} in {} ms", m_file,
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  return m_texture != nullptr;
+}
+
+bool CSlideShowPreloadJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) != 0)
+    return false;
+
+  const CSlideShowPreloadJob* preloadJob = static_cast<const CSlideShowPreloadJob*>(job);
+  return m_file == preloadJob->m_file && m_maxWidth == preloadJob->m_maxWidth &&
+         m_maxHeight == preloadJob->m_maxHeight;
+}
+
+// decode in parallel, reading one picture from the network while decoding the other
+CSlideShowPreloader::CSlideShowPreloader(SlideShowPictureLoader loader /* = nullptr */)
+  : CJobQueue(false, PRELOAD_JOBS_AT_ONCE, CJob::PRIORITY_NORMAL), m_loader(std::move(loader))
+{
+  if (!m_loader)
+  {
+    m_loader = [](const std::string& file, int maxWidth, int maxHeight) {
+      return CTexture::LoadFromFile(file, maxWidth, maxHeight);
+    };
+  }
+}
+
+CSlideShowPreloader::~CSlideShowPreloader()
+{
+  CancelJobs();
+}
+
+std::vector<CSlideShowPreloader::Picture>::iterator CSlideShowPreloader::Find(
+    const std::string& file, int maxWidth, int maxHeight)
+{
+  return std::find_if(m_pictures.begin(), m_pictures.end(), [&](const Picture& picture) {
+    return picture.file == file && picture.maxWidth == maxWidth && picture.maxHeight == maxHeight;
+  });
+}
+
+void CSlideShowPreloader::Preload(const std::vector<std::string>& files,
+                                  int maxWidth,
+                                  int maxHeight)
+{
+  const size_t budget = static_cast<size_t>(CServiceBroker::GetSettingsComponent()
+                                                ->GetAdvancedSettings()
+                                                ->m_slideshowPreloadMemory) *
+                        1024 * 1024;
+
+  std::unique_lock<CCriticalSection> lock(m_picturesLock);
+
+  // the size is only known once decoded, assume the largest seen so far until then. Before the
+  // first one is decoded, assume a picture of the full size the pictures are restricted to
+  const size_t estimatedSize =
+      m_largestSize > 0 ? m_largestSize : static_cast<size_t>(maxWidth) * maxHeight * 4;
+
+  std::vector<Picture> pictures;
+  size_t size = 0;
+  for (const std::string& file : files)
+  {
+    if (budget == 0)
+      break;
+
+    auto it = Find(file, maxWidth, maxHeight);
+    const size_t pictureSize = it != m_pictures.end() && !it->loading ? it->size : estimatedSize;
+    if (size + pictureSize > budget)
+      break;
+    size += pictureSize;
+
+    if (it != m_pictures.end())
+    {
+      pictures.push_back(std::move(*it));
+      m_pictures.erase(it);
+    }
+    else
+    {
+      pictures.push_back({file, maxWidth, maxHeight});
+      AddJob(new CSlideShowPreloadJob(file, maxWidth, maxHeight, m_loader));
+    }
+  }
+
+  // stop decoding the pictures dropped here, their place goes to the ones coming up
+  for (const Picture& picture : m_pictures)
+  {
+    if (picture.loading)
+    {
+      const CSlideShowPreloadJob job(picture.file, picture.maxWidth, picture.maxHeight, m_loader);
+      CancelJob(&job);
+    }
+  }
+  m_pictures = std::move(pictures);
+}
+
+bool CSlideShowPreloader::Take(const std::string& file,
+                               int maxWidth,
+                               int maxHeight,
+                               std::unique_ptr<CTexture>& texture)
+{
+  std::unique_lock<CCriticalSection> lock(m_picturesLock);
+  while (true)
+  {
+    auto it = Find(file, maxWidth, maxHeight);
+    if (it == m_pictures.end())
+      return false;
+
+    if (!it->loading)
+    {
+      texture = std::move(it->texture);
+      m_pictures.erase(it);
+      return true;
+    }
+
+    // still being decoded, rather wait than decode it twice
+    lock.unlock();
+    m_pictureLoaded.Wait(100ms);
+    lock.lock();
+  }
+}
+
+void CSlideShowPreloader::OnJobComplete(unsigned int jobID, bool success, CJob* job)
+{
+  CSlideShowPreloadJob* preloadJob = static_cast<CSlideShowPreloadJob*>(job);
+  {
+    std::unique_lock<CCriticalSection> lock(m_picturesLock);
+    auto it = Find(preloadJob->m_file, preloadJob->m_maxWidth, preloadJob->m_maxHeight);
+    if (it != m_pictures.end() && it->loading)
+    {
+      it->loading = false;
+      it->texture = std::move(preloadJob->m_texture);
+      if (it->texture)
+      {
+        it->size = static_cast<size_t>(it->texture->GetPitch()) * it->texture->GetRows();
+        m_largestSize = std::max(m_largestSize, it->size);
+      }
+    }
+  }
+  m_pictureLoaded.Set();
+
+  CJobQueue::OnJobComplete(jobID, success, job);
+}
+
 CBackgroundPicLoader::CBackgroundPicLoader()
   : CThread("BgPicLoader")
   , m_iPic{0}
@@ -98,11 +260,15 @@ void CBackgroundPicLoader::Process()
       if (m_pCallback)
       {
         auto start = std::chrono::steady_clock::now();
-        std::unique_ptr<CTexture> texture =
-            CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
+        std::unique_ptr<CTexture> texture;
+        const bool preloaded = m_preloader.Take(m_strFileName, m_maxWidth, m_maxHeight, texture);
+        if (!preloaded)
+          texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
 
         auto end = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        CLog::Log(LOGDEBUG, "{} slide {} in {} ms", preloaded ? "Got preloaded" : "Decoded",
+                  m_iSlideNumber, duration.count());
 
         totalTime += duration;
         count++;
@@ -413,6 +579,7 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
   {
     m_pBackgroundLoader.reset(new CBackgroundPicLoader());
     m_pBackgroundLoader->Create(this);
+    m_preloadPath.clear();
   }
 
   bool bSlideShow = m_bSlideShow && !m_bPause && !m_bPlayingVideo;
@@ -512,6 +679,14 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     }
   }
 
+  // decode the next pictures while showing this one
+  if (m_slides.at(m_iNextSlide)->GetPath() != m_preloadPath || m_iDirection != m_iPreloadDirection)
+  {
+    m_preloadPath = m_slides.at(m_iNextSlide)->GetPath();
+    m_iPreloadDirection = m_iDirection;
+    PreloadSlides();
+  }
+
   // check if we should discard an already loaded next slide
   if (m_Image[1 - m_iCurrentPic]->IsLoaded() &&
       m_Image[1 - m_iCurrentPic]->SlideNumber() != m_iNextSlide)
@@ -724,6 +899,29 @@ void CGUIWindowSlideShow::RenderEx()
   CGUIWindow::RenderEx();
 }
 
+void CGUIWindowSlideShow::PreloadSlides()
+{
+  const int count =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_slideshowPreloadCount;
+  const int numSlides = static_cast<int>(m_slides.size());
+  const int step = m_iDirection >= 0 ? 1 : -1;
+
+  // the slides coming up in play order, skipping the ones we won't show
+  std::vector<std::string> files;
+  for (int slide = m_iNextSlide; slide != m_iCurrentSlide && static_cast<int>(files.size()) < count;
+       slide = (slide + step + numSlides) % numSlides)
+  {
+    CFileItem* item = m_slides.at(slide).get();
+    if (!item->IsVideo() && !item->HasProperty("unplayable"))
+      files.push_back(GetPicturePath(item));
+  }
+
+  const RESOLUTION_INFO res = CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo();
+  int maxWidth, maxHeight;
+  GetCheckedSize((float)res.iWidth, (float)res.iHeight, maxWidth, maxHeight);
+  m_pBackgroundLoader->Preload(files, maxWidth, maxHeight);
+}
+
 int CGUIWindowSlideShow::GetNextSlide()
 {
   if (m_slides.size() <= 1)
@@ -12,16 +12,100 @@
 #include "guilib/GUIDialog.h"
 #include "threads/Event.h"
 #include "threads/Thread.h"
+#include "utils/Job.h"
+#include "utils/JobManager.h"
 #include "utils/SortUtils.h"
 
+#include <functional>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 class CFileItemList;
 class CVariant;
 
 class CGUIWindowSlideShow;
 
+/*!
+ \brief Decodes a picture for the slideshow, restricting it to the given size
+ */
+using SlideShowPictureLoader = std::function<std::unique_ptr<CTexture>(
+    const std::string& file, int maxWidth, int maxHeight)>;
+
+class CSlideShowPreloadJob : public CJob
+{
+public:
+  CSlideShowPreloadJob(const std::string& file,
+                       int maxWidth,
+                       int maxHeight,
+                       const SlideShowPictureLoader& loader);
+  ~CSlideShowPreloadJob() override;
+
+  bool DoWork() override;
+  const char* GetType() const override { return "slideshowpreload"; }
+  bool operator==(const CJob* job) const override;
+
+  std::string m_file;
+  int m_maxWidth;
+  int m_maxHeight;
+  std::unique_ptr<CTexture> m_texture;
+
+private:
+  SlideShowPictureLoader m_loader;
+};
+
+/*!
+ \brief Decodes the pictures coming up in the slideshow ahead of time
+ Several pictures are decoded in parallel, as long as the decoded pictures fit into the
+ memory budget set by the advanced setting slideshow/preloadmemory.
+ */
+class CSlideShowPreloader : public CJobQueue
+{
+public:
+  /*!
+   \param loader decodes the pictures, CTexture::LoadFromFile if not given
+   */
+  explicit CSlideShowPreloader(SlideShowPictureLoader loader = nullptr);
+  ~CSlideShowPreloader() override;
+
+  /*!
+   \brief Set the pictures to decode ahead of time
+   Pictures not in the list any more are dropped, and their decoding is cancelled.
+   \param files the pictures in the order they will be shown
+   */
+  void Preload(const std::vector<std::string>& files, int maxWidth, int maxHeight);
+
+  /*!
+   \brief Take a preloaded picture, waiting for it if it is still being decoded
+   \param texture [out] the decoded picture, empty if it failed to decode
+   \return true if the picture was preloaded, false otherwise
+   */
+  bool Take(const std::string& file, int maxWidth, int maxHeight,
+            std::unique_ptr<CTexture>& texture);
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+
+private:
+  struct Picture
+  {
+    std::string file;
+    int maxWidth;
+    int maxHeight;
+    bool loading = true;
+    size_t size = 0;
+    std::unique_ptr<CTexture> texture;
+  };
+
+  std::vector<Picture>::iterator Find(const std::string& file, int maxWidth, int maxHeight);
+
+  SlideShowPictureLoader m_loader;
+  CCriticalSection m_picturesLock;
+  std::vector<Picture> m_pictures;
+  size_t m_largestSize = 0;
+  CEvent m_pictureLoaded;
+};
+
 class CBackgroundPicLoader : public CThread
 {
 public:
@@ -33,6 +117,10 @@ public:
   bool IsLoading() { return m_isLoading; }
   int SlideNumber() const { return m_iSlideNumber; }
   int Pic() const { return m_iPic; }
+  void Preload(const std::vector<std::string>& files, int maxWidth, int maxHeight)
+  {
+    m_preloader.Preload(files, maxWidth, maxHeight);
+  }
 
 private:
   void Process() override;
@@ -46,6 +134,7 @@ private:
   bool m_isLoading;
 
   CGUIWindowSlideShow *m_pCallback;
+  CSlideShowPreloader m_preloader;
 };
 
 class CGUIWindowSlideShow : public CGUIDialog
@@ -117,6 +206,7 @@ private:
   void GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight);
   std::string GetPicturePath(CFileItem *item);
   int  GetNextSlide();
+  void PreloadSlides();
 
   void AnnouncePlayerPlay(const CFileItemPtr& item);
   void AnnouncePlayerPause(const CFileItemPtr& item);
@@ -150,6 +240,8 @@ private:
   std::unique_ptr<CBackgroundPicLoader> m_pBackgroundLoader;
   int m_iLastFailedNextSlide;
   bool m_bLoadNextPic;
+  std::string m_preloadPath;
+  int m_iPreloadDirection = 0;
   RESOLUTION m_Resolution;
   CPoint m_firstGesturePoint;
 };
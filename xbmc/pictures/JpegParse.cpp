@@ -33,6 +33,10 @@ typedef unsigned char BYTE;
 #define min(a,b) (a)>(b)?(b):(a)
 #endif
 
+// The headers are parsed in many small reads, so fetch them from the file in large blocks. Most
+// headers fit into the first block, which makes a single request on network file systems.
+#define HEADER_BLOCK_SIZE 65536
+
 using namespace XFILE;
 
 //--------------------------------------------------------------------------
@@ -67,6 +71,37 @@ CJpegParse::CJpegParse():
   memset(&m_IPTCInfo, 0, sizeof(m_IPTCInfo));
 }
 
+//--------------------------------------------------------------------------
+// Read from the headers, fetching them from the file as needed
+//--------------------------------------------------------------------------
+size_t CJpegParse::Read(CFile& infile, void* buffer, size_t size)
+{
+  if (m_headerPos + size > m_header.size() && !m_headerEnd)
+  {
+    size_t length = m_header.size();
+    const size_t missing = m_headerPos + size - length;
+    m_header.resize(length + (missing > HEADER_BLOCK_SIZE ? missing : HEADER_BLOCK_SIZE));
+    while (length < m_header.size())
+    {
+      const ssize_t bytesRead = infile.Read(m_header.data() + length, m_header.size() - length);
+      if (bytesRead <= 0)
+      {
+        m_headerEnd = true;
+        break;
+      }
+      length += bytesRead;
+    }
+    m_header.resize(length);
+  }
+
+  const size_t available = m_header.size() > m_headerPos ? m_header.size() - m_headerPos : 0;
+  if (size > available)
+    size = available;
+  memcpy(buffer, m_header.data() + m_headerPos, size);
+  m_headerPos += size;
+  return size;
+}
+
 //--------------------------------------------------------------------------
 // Process a SOFn marker.  This is useful for the image dimensions
 //--------------------------------------------------------------------------
@@ -111,7 +146,7 @@ bool CJpegParse::GetSection (CFile& infile, const unsigned short sectionLength)
 
   unsigned int len = (unsigned int)sectionLength;
 
-  size_t bytesRead = infile.Read(m_SectionBuffer+sizeof(sectionLength), len-sizeof(sectionLength));
+  size_t bytesRead = Read(infile, m_SectionBuffer+sizeof(sectionLength), len-sizeof(sectionLength));
   if (bytesRead != sectionLength-sizeof(sectionLength))
   {
     printf("JpgParse: premature end of file?");
@@ -139,12 +174,12 @@ bool CJpegParse::ExtractInfo (CFile& infile)
 {
   // Get file marker (two bytes - must be 0xFFD8 for JPEG files
   BYTE a;
-  size_t bytesRead = infile.Read(&a, sizeof(BYTE));
+  size_t bytesRead = Read(infile, &a, sizeof(BYTE));
   if ((bytesRead != sizeof(BYTE)) || (a != 0xFF))
   {
     return false;
   }
-  bytesRead = infile.Read(&a, sizeof(BYTE));
+  bytesRead = Read(infile, &a, sizeof(BYTE));
   if ((bytesRead != sizeof(BYTE)) || (a != M_SOI))
   {
     return false;
@@ -154,7 +189,7 @@ bool CJpegParse::ExtractInfo (CFile& infile)
   {
     BYTE marker = 0;
     for (a=0; a<7; a++) {
-      bytesRead = infile.Read(&marker, sizeof(BYTE));
+      bytesRead = Read(infile, &marker, sizeof(BYTE));
       if (marker != 0xFF)
         break;
 
@@ -168,7 +203,7 @@ bool CJpegParse::ExtractInfo (CFile& infile)
 
     // Read the length of the section.
     unsigned short itemlen = 0;
-    bytesRead = infile.Read(&itemlen, sizeof(itemlen));
+    bytesRead = Read(infile, &itemlen, sizeof(itemlen));
     itemlen = CExifParse::Get16(&itemlen);
 
     if ((bytesRead != sizeof(itemlen)) || (itemlen < sizeof(itemlen)))
@@ -266,9 +301,13 @@ bool CJpegParse::Process (const char *picFileName)
 {
   CFile file;
 
-  if (!file.Open(picFileName))
+  if (!file.Open(picFileName, READ_TRUNCATED | READ_CHUNKED))
     return false;
 
+  m_header.clear();
+  m_headerPos = 0;
+  m_headerEnd = false;
+
   // File exists and successfully opened. Start processing
   // Gather all information about the file
 
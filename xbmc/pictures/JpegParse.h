@@ -4,6 +4,7 @@
 #include "IptcParse.h"
 
 #include <stdio.h>
+#include <vector>
 
 //--------------------------------------------------------------------------
 // JPEG markers consist of one or more 0xFF bytes, followed by a marker
@@ -51,6 +52,7 @@ class CJpegParse
     const IPTCInfo_t* GetIptcInfo() const { return &m_IPTCInfo; }
 
   private:
+    size_t Read(XFILE::CFile& infile, void* buffer, size_t size);
     bool ExtractInfo(XFILE::CFile& infile);
     bool GetSection(XFILE::CFile& infile, const unsigned short sectionLength);
     void ReleaseSection(void);
@@ -59,5 +61,9 @@ class CJpegParse
     unsigned char* m_SectionBuffer;
     ExifInfo_t m_ExifInfo;
     IPTCInfo_t m_IPTCInfo;
+
+    std::vector<unsigned char> m_header;
+    size_t m_headerPos = 0;
+    bool m_headerEnd = false;
 };
 
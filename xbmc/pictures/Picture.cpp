@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "Picture.h"
+#include "PictureScaler.h"
 #include "URL.h"
 #include "ServiceBroker.h"
 #include "settings/AdvancedSettings.h"
@@ -21,10 +22,6 @@
 #include "guilib/Texture.h"
 #include "guilib/imagefactory.h"
 
-extern "C" {
-#include <libswscale/swscale.h>
-}
-
 using namespace XFILE;
 
 bool CPicture::GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size)
@@ -361,22 +358,21 @@ bool CPicture::ScaleImage(uint8_t* in_pixels,
                           CPictureScalingAlgorithm::Algorithm
                               scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  struct SwsContext* context =
-      sws_getContext(in_width, in_height, in_format, out_width, out_height, out_format,
-                     CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), NULL, NULL, NULL);
+  static CPictureScalerPool pool;
+  std::unique_ptr<CPictureScaler> scaler = pool.Acquire();
 
   uint8_t *src[] = { in_pixels, 0, 0, 0 };
   int     srcStride[] = { (int)in_pitch, 0, 0, 0 };
   uint8_t *dst[] = { out_pixels , 0, 0, 0 };
   int     dstStride[] = { (int)out_pitch, 0, 0, 0 };
 
-  if (context)
-  {
-    sws_scale(context, src, srcStride, 0, in_height, dst, dstStride);
-    sws_freeContext(context);
-    return true;
-  }
-  return false;
+  const bool ret = scaler->Configure(in_width, in_height, in_format, out_width, out_height,
+                                     out_format,
+                                     CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm)) &&
+                   scaler->Scale(src, srcStride, dst, dstStride);
+
+  pool.Release(std::move(scaler));
+  return ret;
 }
 
 bool CPicture::OrientateImage(uint32_t *&pixels, unsigned int &width, unsigned int &height, int orientation)
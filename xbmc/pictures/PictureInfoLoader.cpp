@@ -11,27 +11,39 @@
 #include "FileItem.h"
 #include "PictureInfoTag.h"
 #include "ServiceBroker.h"
+#include "URL.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <stdexcept>
+
+#define CACHE_VERSION 2
+#define CACHE_PATH "special://temp/pictureinfo/"
+
+// reading the headers mostly waits for the file system, so read several at once
+#define PARALLEL_TAG_READS 4
 
 CPictureInfoLoader::CPictureInfoLoader()
+  : m_tagReader(false, PARALLEL_TAG_READS, CJob::PRIORITY_NORMAL)
 {
-  m_mapFileItems = new CFileItemList;
   m_tagReads = 0;
 }
 
 CPictureInfoLoader::~CPictureInfoLoader()
 {
   StopThread();
-  delete m_mapFileItems;
 }
 
 void CPictureInfoLoader::OnLoaderStart()
 {
-  // Load previously cached items from HD
-  m_mapFileItems->SetPath(m_pVecItems->GetPath());
-  m_mapFileItems->Load();
-  m_mapFileItems->SetFastLookup(true);
+  // Load previously read tags from HD
+  LoadCache();
 
   m_tagReads = 0;
   m_loadTags = CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_PICTURES_USETAGS);
@@ -56,15 +68,29 @@ bool CPictureInfoLoader::LoadItemCached(CFileItem* pItem)
   if (pItem->HasPictureInfoTag())
     return true;
 
-  // Check the cached item
-  CFileItemPtr mapItem = (*m_mapFileItems)[pItem->GetPath()];
-  if (mapItem && mapItem->m_dateTime==pItem->m_dateTime && mapItem->HasPictureInfoTag())
-  { // Query map if we previously cached the file on HD
-    *pItem->GetPictureInfoTag() = *mapItem->GetPictureInfoTag();
-    pItem->SetArt("thumb", mapItem->GetArt("thumb"));
+  // Check the cached tag, the file must not have changed since it was read
+  const auto it = m_cache.find(pItem->GetPath());
+  if (it != m_cache.end() && it->second.dateTime == pItem->m_dateTime &&
+      it->second.size == pItem->m_dwSize)
+  {
+    *pItem->GetPictureInfoTag() = *it->second.tag;
+    pItem->SetArt("thumb", it->second.thumb);
     return true;
   }
 
+  // Start reading the tag, LoadItemLookup picks it up
+  if (m_loadTags && m_pendingTags.find(pItem->GetPath()) == m_pendingTags.end())
+  {
+    auto promise = std::make_shared<std::promise<CPictureInfoTag>>();
+    m_pendingTags.emplace(pItem->GetPath(), promise->get_future());
+
+    m_tagReader.Submit([promise, path = pItem->GetPath()]() {
+      CPictureInfoTag tag;
+      tag.Load(path);
+      promise->set_value(tag);
+    });
+  }
+
   return true;
 }
 
@@ -81,7 +107,14 @@ bool CPictureInfoLoader::LoadItemLookup(CFileItem* pItem)
 
   if (m_loadTags)
   { // Nothing found, load tag from file
-    pItem->GetPictureInfoTag()->Load(pItem->GetPath());
+    const auto it = m_pendingTags.find(pItem->GetPath());
+    if (it != m_pendingTags.end())
+    {
+      *pItem->GetPictureInfoTag() = it->second.get();
+      m_pendingTags.erase(it);
+    }
+    else
+      pItem->GetPictureInfoTag()->Load(pItem->GetPath());
     m_tagReads++;
   }
 
@@ -90,10 +123,96 @@ bool CPictureInfoLoader::LoadItemLookup(CFileItem* pItem)
 
 void CPictureInfoLoader::OnLoaderFinish()
 {
-  // cleanup cache loaded from HD
-  m_mapFileItems->Clear();
+  // drop the reads we didn't get to
+  m_tagReader.CancelJobs();
+  m_pendingTags.clear();
 
   // Save loaded items to HD
   if (!m_bStop && m_tagReads > 0)
+  {
+    SaveCache();
     m_pVecItems->Save();
+  }
+
+  // cleanup cache loaded from HD
+  m_cache.clear();
+}
+
+std::string CPictureInfoLoader::GetCacheFile() const
+{
+  return StringUtils::Format(CACHE_PATH "{:08x}.fi",
+                             Crc32::ComputeFromLowerCase(m_pVecItems->GetPath()));
+}
+
+void CPictureInfoLoader::LoadCache()
+{
+  m_cache.clear();
+
+  XFILE::CFile file;
+  if (!file.Open(GetCacheFile()))
+    return;
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+    int version;
+    ar >> version;
+    if (version == CACHE_VERSION)
+    {
+      int count;
+      ar >> count;
+      for (int i = 0; i < count; i++)
+      {
+        std::string path;
+        CachedTag cached;
+        cached.tag = std::make_shared<CPictureInfoTag>();
+        ar >> path;
+        ar >> cached.dateTime;
+        ar >> cached.size;
+        ar >> *cached.tag;
+        ar >> cached.thumb;
+        m_cache.emplace(std::move(path), std::move(cached));
+      }
+    }
+    ar.Close();
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "{} - corrupt picture info cache for {}", __FUNCTION__,
+              CURL::GetRedacted(m_pVecItems->GetPath()));
+    m_cache.clear();
+  }
+  file.Close();
+}
+
+void CPictureInfoLoader::SaveCache()
+{
+  std::vector<CFileItemPtr> items;
+  for (int i = 0; i < m_pVecItems->Size(); i++)
+  {
+    const CFileItemPtr& item = m_pVecItems->Get(i);
+    if (!item->m_bIsFolder && item->HasPictureInfoTag())
+      items.push_back(item);
+  }
+
+  if (!XFILE::CDirectory::Exists(CACHE_PATH))
+    XFILE::CDirectory::Create(CACHE_PATH);
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(GetCacheFile(), true))
+    return;
+
+  CArchive ar(&file, CArchive::store);
+  ar << CACHE_VERSION;
+  ar << static_cast<int>(items.size());
+  for (const CFileItemPtr& item : items)
+  {
+    ar << item->GetPath();
+    ar << item->m_dateTime;
+    ar << item->m_dwSize;
+    ar << *item->GetPictureInfoTag();
+    ar << item->GetArt("thumb");
+  }
+  ar.Close();
+  file.Close();
 }
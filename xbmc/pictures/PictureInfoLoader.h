@@ -9,8 +9,15 @@
 #pragma once
 
 #include "BackgroundInfoLoader.h"
+#include "XBDateTime.h"
+#include "utils/JobManager.h"
 
+#include <future>
+#include <memory>
 #include <string>
+#include <unordered_map>
+
+class CPictureInfoTag;
 
 class CPictureInfoLoader : public CBackgroundInfoLoader
 {
@@ -27,8 +34,27 @@ protected:
   void OnLoaderStart() override;
   void OnLoaderFinish() override;
 
-  CFileItemList* m_mapFileItems;
   unsigned int m_tagReads;
   bool m_loadTags;
+
+private:
+  struct CachedTag
+  {
+    CDateTime dateTime;
+    int64_t size;
+    std::shared_ptr<CPictureInfoTag> tag;
+    std::string thumb;
+  };
+
+  std::string GetCacheFile() const;
+  void LoadCache();
+  void SaveCache();
+
+  // tags read before, kept across restarts
+  std::unordered_map<std::string, CachedTag> m_cache;
+
+  // tags are read in parallel, while the items are handed out one by one
+  CJobQueue m_tagReader;
+  std::unordered_map<std::string, std::future<CPictureInfoTag>> m_pendingTags;
 };
 
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PictureScaler.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/opt.h>
+#include <libswscale/swscale.h>
+}
+
+namespace
+{
+// below this output size the cost of waking the slice threads exceeds the gain
+constexpr int MIN_PIXELS_PER_THREAD = 128 * 1024;
+constexpr int MAX_THREADS = 8;
+
+void NoopFree(void* opaque, uint8_t* data)
+{
+}
+
+bool WrapPlanes(AVFrame* frame,
+                uint8_t* const planes[],
+                const int strides[],
+                int width,
+                int height,
+                AVPixelFormat format)
+{
+  // swscale's frame api only takes reference counted frames, wrap the caller's
+  // memory into a buffer that is never freed so nothing gets copied
+  frame->buf[0] = av_buffer_create(planes[0], 1, NoopFree, nullptr, 0);
+  if (!frame->buf[0])
+    return false;
+
+  for (int i = 0; i < 4 && planes[i]; i++)
+  {
+    frame->data[i] = planes[i];
+    frame->linesize[i] = strides[i];
+  }
+  frame->width = width;
+  frame->height = height;
+  frame->format = format;
+  return true;
+}
+} // namespace
+
+CPictureScaler::CPictureScaler(int threads /* = 0 */) : m_requestedThreads(threads)
+{
+  m_srcFrame = av_frame_alloc();
+  m_dstFrame = av_frame_alloc();
+}
+
+CPictureScaler::~CPictureScaler()
+{
+  Reset();
+  av_frame_free(&m_srcFrame);
+  av_frame_free(&m_dstFrame);
+}
+
+int CPictureScaler::GetDefaultThreads()
+{
+  return std::clamp(CServiceBroker::GetCPUInfo()->GetCPUCount(), 1, MAX_THREADS);
+}
+
+void CPictureScaler::Reset()
+{
+  sws_freeContext(m_context);
+  m_context = nullptr;
+}
+
+bool CPictureScaler::Configure(int srcWidth,
+                               int srcHeight,
+                               AVPixelFormat srcFormat,
+                               int dstWidth,
+                               int dstHeight,
+                               AVPixelFormat dstFormat,
+                               int flags)
+{
+  if (m_context && srcWidth == m_srcWidth && srcHeight == m_srcHeight &&
+      srcFormat == m_srcFormat && dstWidth == m_dstWidth && dstHeight == m_dstHeight &&
+      dstFormat == m_dstFormat && flags == m_flags)
+    return true;
+
+  Reset();
+
+  int threads = m_requestedThreads > 0 ? m_requestedThreads : GetDefaultThreads();
+  threads = std::clamp(dstWidth * dstHeight / MIN_PIXELS_PER_THREAD, 1, threads);
+
+  m_context = sws_alloc_context();
+  if (!m_context)
+    return false;
+
+  av_opt_set_int(m_context, "srcw", srcWidth, 0);
+  av_opt_set_int(m_context, "srch", srcHeight, 0);
+  av_opt_set_int(m_context, "src_format", srcFormat, 0);
+  av_opt_set_int(m_context, "dstw", dstWidth, 0);
+  av_opt_set_int(m_context, "dsth", dstHeight, 0);
+  av_opt_set_int(m_context, "dst_format", dstFormat, 0);
+  av_opt_set_int(m_context, "sws_flags", flags, 0);
+  av_opt_set_int(m_context, "threads", threads, 0);
+
+  if (sws_init_context(m_context, nullptr, nullptr) < 0)
+  {
+    CLog::Log(LOGERROR, "CPictureScaler::{} - failed to create scaler {}x{} -> {}x{}",
+              __FUNCTION__, srcWidth, srcHeight, dstWidth, dstHeight);
+    Reset();
+    return false;
+  }
+
+  m_threads = threads;
+  m_srcWidth = srcWidth;
+  m_srcHeight = srcHeight;
+  m_srcFormat = srcFormat;
+  m_dstWidth = dstWidth;
+  m_dstHeight = dstHeight;
+  m_dstFormat = dstFormat;
+  m_flags = flags;
+  return true;
+}
+
+bool CPictureScaler::Scale(uint8_t* const src[],
+                           const int srcStride[],
+                           uint8_t* const dst[],
+                           const int dstStride[])
+{
+  if (!m_context)
+    return false;
+
+  bool ret = false;
+  if (WrapPlanes(m_srcFrame, src, srcStride, m_srcWidth, m_srcHeight, m_srcFormat) &&
+      WrapPlanes(m_dstFrame, dst, dstStride, m_dstWidth, m_dstHeight, m_dstFormat))
+    ret = sws_scale_frame(m_context, m_dstFrame, m_srcFrame) >= 0;
+
+  av_frame_unref(m_srcFrame);
+  av_frame_unref(m_dstFrame);
+  return ret;
+}
+
+std::unique_ptr<CPictureScaler> CPictureScalerPool::Acquire()
+{
+  const int threads = dynamic_cast<CJobWorker*>(CThread::GetCurrentThread()) ? 1 : 0;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  // the most recently used scaler is the most likely to have the right geometry
+  for (auto it = m_idle.rbegin(); it != m_idle.rend(); ++it)
+  {
+    if ((*it)->GetRequestedThreads() == threads)
+    {
+      std::unique_ptr<CPictureScaler> scaler = std::move(*it);
+      m_idle.erase(std::next(it).base());
+      return scaler;
+    }
+  }
+  lock.unlock();
+
+  return std::make_unique<CPictureScaler>(threads);
+}
+
+void CPictureScalerPool::Release(std::unique_ptr<CPictureScaler> scaler)
+{
+  std::unique_ptr<CPictureScaler> oldest;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (m_idle.size() >= m_maxIdle)
+    {
+      oldest = std::move(m_idle.front());
+      m_idle.erase(m_idle.begin());
+    }
+    m_idle.push_back(std::move(scaler));
+  }
+  // the oldest context and its slice threads are freed outside the lock
+}
+
+size_t CPictureScalerPool::GetIdle() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_idle.size();
+}
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+struct AVFrame;
+struct SwsContext;
+
+/*!
+ * \brief Software colour conversion and scaling, split into horizontal slices
+ * that are processed in parallel by the worker threads of libswscale.
+ *
+ * The swscale context is kept between calls to Scale() as long as the
+ * source and destination geometry don't change, so repeated conversions
+ * (e.g. thumbnail extraction of several frames) don't pay for the filter
+ * setup each time.
+ */
+class CPictureScaler
+{
+public:
+  /*!
+   * \param threads number of slice threads, 0 selects a count based on the CPU
+   */
+  explicit CPictureScaler(int threads = 0);
+  ~CPictureScaler();
+
+  CPictureScaler(const CPictureScaler&) = delete;
+  CPictureScaler& operator=(const CPictureScaler&) = delete;
+
+  bool Configure(int srcWidth,
+                 int srcHeight,
+                 AVPixelFormat srcFormat,
+                 int dstWidth,
+                 int dstHeight,
+                 AVPixelFormat dstFormat,
+                 int flags);
+
+  bool Scale(uint8_t* const src[], const int srcStride[], uint8_t* const dst[], const int dstStride[]);
+
+  int GetThreads() const { return m_threads; }
+  int GetRequestedThreads() const { return m_requestedThreads; }
+
+  /*!
+   * \brief Number of slice threads used when none is requested explicitly
+   */
+  static int GetDefaultThreads();
+
+private:
+  void Reset();
+
+  SwsContext* m_context = nullptr;
+  AVFrame* m_srcFrame = nullptr;
+  AVFrame* m_dstFrame = nullptr;
+  int m_requestedThreads;
+  int m_threads = 1;
+
+  int m_srcWidth = 0;
+  int m_srcHeight = 0;
+  AVPixelFormat m_srcFormat = AV_PIX_FMT_NONE;
+  int m_dstWidth = 0;
+  int m_dstHeight = 0;
+  AVPixelFormat m_dstFormat = AV_PIX_FMT_NONE;
+  int m_flags = 0;
+};
+
+/*!
+ * \brief Scalers kept for reuse, so that their swscale contexts and slice
+ * threads survive between images of the same geometry, e.g. while the
+ * thumbnails of a folder of photos from the same camera are created.
+ *
+ * At most maxIdle scalers are kept, callers that find none of them idle get
+ * a new scaler. Job workers get single threaded scalers, as the job manager
+ * already runs several of them in parallel.
+ */
+class CPictureScalerPool
+{
+public:
+  explicit CPictureScalerPool(size_t maxIdle = 4) : m_maxIdle(maxIdle) {}
+
+  std::unique_ptr<CPictureScaler> Acquire();
+  void Release(std::unique_ptr<CPictureScaler> scaler);
+
+  size_t GetIdle() const;
+
+private:
+  mutable CCriticalSection m_critSection;
+  std::vector<std::unique_ptr<CPictureScaler>> m_idle; ///< least recently used first
+  const size_t m_maxIdle;
+};
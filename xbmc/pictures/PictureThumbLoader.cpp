@@ -231,13 +231,14 @@ void CPictureThumbLoader::ProcessFoldersAndArchives(CFileItem *pItem)
           files.push_back(items[thumb]->GetPath());
         std::string thumb = CTextureUtils::GetWrappedImageURL(pItem->GetPath(), "picturefolder");
         std::string relativeCacheFile = CTextureCache::GetCacheFile(thumb) + ".png";
+        const uint64_t replacedSize = CTextureCache::GetCachedFileSize(relativeCacheFile);
         if (CPicture::CreateTiledThumb(files, CTextureCache::GetCachedPath(relativeCacheFile)))
         {
           CTextureDetails details;
           details.file = relativeCacheFile;
           details.width = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes;
           details.height = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes;
-          CServiceBroker::GetTextureCache()->AddCachedTexture(thumb, details);
+          CServiceBroker::GetTextureCache()->AddCachedTexture(thumb, details, replacedSize);
           db.SetTextureForPath(pItem->GetPath(), "thumb", thumb);
           pItem->SetArt("thumb", CTextureCache::GetCachedPath(relativeCacheFile));
         }
@@ -13,9 +13,11 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <chrono>
 #include <mutex>
 
 #ifndef _USE_MATH_DEFINES
@@ -104,6 +106,7 @@ void CSlideShowPic::SetTexture_Internal(int iSlideNumber,
 
   m_bIsDirty = true;
   m_pImage = std::move(pTexture);
+  m_bUploaded = false;
   m_fWidth = static_cast<float>(m_pImage->GetWidth());
   m_fHeight = static_cast<float>(m_pImage->GetHeight());
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_SLIDESHOW_HIGHQUALITYDOWNSCALING))
@@ -729,6 +732,19 @@ void CSlideShowPic::Render()
 {
   std::unique_lock<CCriticalSection> lock(m_textureAccess);
 
+  if (m_pImage && !m_bUploaded)
+  {
+    // upload ahead of rendering to tell how long large pictures take
+    const auto start = std::chrono::steady_clock::now();
+    m_pImage->LoadToGPU();
+    const auto end = std::chrono::steady_clock::now();
+    m_bUploaded = true;
+
+    CLog::Log(LOGDEBUG, "Uploaded slide {} ({}x{}) in {} ms", m_iSlideNumber,
+              m_pImage->GetWidth(), m_pImage->GetHeight(),
+              std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+  }
+
   Render(m_ax, m_ay, m_pImage.get(), (m_alpha << 24) | 0xFFFFFF);
 
   // now render the image in the top right corner if we're zooming
@@ -90,6 +90,7 @@ private:
   void UpdateVertices(float cur_x[4], float cur_y[4], const float new_x[4], const float new_y[4], CDirtyRegionList &dirtyregions);
 
   std::unique_ptr<CTexture> m_pImage;
+  bool m_bUploaded = false;
 
   int m_iOriginalWidth;
   int m_iOriginalHeight;
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "pictures/JpegParse.h"
+#include "test/TestUtils.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+void AddSection(std::vector<unsigned char>& data,
+                unsigned char marker,
+                const std::vector<unsigned char>& payload)
+{
+  const size_t length = payload.size() + 2;
+  data.push_back(0xFF);
+  data.push_back(marker);
+  data.push_back(static_cast<unsigned char>(length >> 8));
+  data.push_back(static_cast<unsigned char>(length & 0xFF));
+  data.insert(data.end(), payload.begin(), payload.end());
+}
+
+/*!
+ * \brief Create the marker stream of a 640x480 JPEG. The large application section moves the
+ * comment and the frame header past the parser's first read block.
+ */
+std::vector<unsigned char> CreateJpeg(const std::string& comment)
+{
+  std::vector<unsigned char> data = {0xFF, 0xD8};
+  AddSection(data, 0xE2, std::vector<unsigned char>(65533, 0));
+  AddSection(data, 0xFE, std::vector<unsigned char>(comment.begin(), comment.end()));
+  AddSection(data, 0xC0, {8, 0x01, 0xE0, 0x02, 0x80, 3, 1, 0x22, 0, 2, 0x11, 1, 3, 0x11, 1});
+  AddSection(data, 0xDA, {1, 1, 0, 0, 0x3F, 0});
+  data.insert(data.end(), 1024, 0x55);
+  data.push_back(0xFF);
+  data.push_back(0xD9);
+  return data;
+}
+
+XFILE::CFile* WriteTempFile(const std::vector<unsigned char>& data)
+{
+  XFILE::CFile* file = XBMC_CREATETEMPFILE(".jpg");
+  if (!file)
+    return nullptr;
+
+  file->Close();
+  if (!file->OpenForWrite(XBMC_TEMPFILEPATH(file), true) ||
+      file->Write(data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    XBMC_DELETETEMPFILE(file);
+    return nullptr;
+  }
+  file->Close();
+  return file;
+}
+} // unnamed namespace
+
+TEST(TestJpegParse, ReadsAcrossBlocks)
+{
+  XFILE::CFile* file = WriteTempFile(CreateJpeg("Kodi"));
+  ASSERT_NE(nullptr, file);
+
+  CJpegParse parser;
+  EXPECT_TRUE(parser.Process(XBMC_TEMPFILEPATH(file).c_str()));
+  EXPECT_EQ(640, parser.GetExifInfo()->Width);
+  EXPECT_EQ(480, parser.GetExifInfo()->Height);
+  EXPECT_STREQ("Kodi", parser.GetExifInfo()->FileComment);
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestJpegParse, Truncated)
+{
+  // the file ends after the marker of the comment section in the second block
+  std::vector<unsigned char> data = CreateJpeg("Kodi");
+  data.resize(65536 + 4);
+
+  XFILE::CFile* file = WriteTempFile(data);
+  ASSERT_NE(nullptr, file);
+
+  CJpegParse parser;
+  EXPECT_FALSE(parser.Process(XBMC_TEMPFILEPATH(file).c_str()));
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestJpegParse, NotAJpeg)
+{
+  XFILE::CFile* file = WriteTempFile({'G', 'I', 'F', '8', '9', 'a'});
+  ASSERT_NE(nullptr, file);
+
+  CJpegParse parser;
+  EXPECT_FALSE(parser.Process(XBMC_TEMPFILEPATH(file).c_str()));
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
@@ -0,0 +1,190 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "pictures/Picture.h"
+#include "pictures/PictureScaler.h"
+#include "pictures/PictureScalingAlgorithm.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+struct Image
+{
+  Image(int width, int height) : width(width), height(height), pixels(width * height * 4) {}
+
+  int width;
+  int height;
+  std::vector<uint8_t> pixels;
+};
+
+// gradients with some detail, so that every filter tap makes a difference
+Image CreateImage(int width, int height)
+{
+  Image image(width, height);
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      uint8_t* pixel = &image.pixels[(y * width + x) * 4];
+      pixel[0] = static_cast<uint8_t>(x * 255 / width);
+      pixel[1] = static_cast<uint8_t>(y * 255 / height);
+      pixel[2] = static_cast<uint8_t>((x ^ y) & 0xff);
+      pixel[3] = 0xff;
+    }
+  }
+  return image;
+}
+
+bool Scale(CPictureScaler& scaler, const Image& in, Image& out)
+{
+  const int flags = CPictureScalingAlgorithm::ToSwscale(CPictureScalingAlgorithm::Default);
+  if (!scaler.Configure(in.width, in.height, AV_PIX_FMT_BGRA, out.width, out.height,
+                        AV_PIX_FMT_BGRA, flags))
+    return false;
+
+  uint8_t* src[] = {const_cast<uint8_t*>(in.pixels.data()), nullptr, nullptr, nullptr};
+  int srcStride[] = {in.width * 4, 0, 0, 0};
+  uint8_t* dst[] = {out.pixels.data(), nullptr, nullptr, nullptr};
+  int dstStride[] = {out.width * 4, 0, 0, 0};
+  return scaler.Scale(src, srcStride, dst, dstStride);
+}
+
+bool ScaleImage(const Image& in, Image& out)
+{
+  return CPicture::ScaleImage(const_cast<uint8_t*>(in.pixels.data()), in.width, in.height,
+                              in.width * 4, AV_PIX_FMT_BGRA, out.pixels.data(), out.width,
+                              out.height, out.width * 4, AV_PIX_FMT_BGRA,
+                              CPictureScalingAlgorithm::Default);
+}
+
+// the single threaded result every other path has to match
+Image ScaleSingleThreaded(const Image& in, int width, int height)
+{
+  CPictureScaler scaler(1);
+  Image out(width, height);
+  EXPECT_TRUE(Scale(scaler, in, out));
+  EXPECT_EQ(1, scaler.GetThreads());
+  return out;
+}
+} // unnamed namespace
+
+class TestPictureScaler : public testing::Test
+{
+protected:
+  TestPictureScaler() { CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo()); }
+  ~TestPictureScaler() override { CServiceBroker::UnregisterCPUInfo(); }
+};
+
+TEST_F(TestPictureScaler, SliceThreadsMatchSingleThreaded)
+{
+  const Image in = CreateImage(1920, 1080);
+  const Image expected = ScaleSingleThreaded(in, 1280, 720);
+
+  for (int threads : {2, 3, 4, 8})
+  {
+    CPictureScaler scaler(threads);
+    Image out(1280, 720);
+    ASSERT_TRUE(Scale(scaler, in, out)) << threads << " threads";
+    EXPECT_LT(1, scaler.GetThreads());
+    EXPECT_EQ(expected.pixels, out.pixels) << threads << " threads";
+
+    // the kept context gives the same result again
+    std::fill(out.pixels.begin(), out.pixels.end(), 0);
+    ASSERT_TRUE(Scale(scaler, in, out)) << threads << " threads";
+    EXPECT_EQ(expected.pixels, out.pixels) << threads << " threads";
+  }
+}
+
+TEST_F(TestPictureScaler, SmallOutputIsSingleThreaded)
+{
+  const Image in = CreateImage(1920, 1080);
+  const Image expected = ScaleSingleThreaded(in, 320, 180);
+
+  CPictureScaler scaler(8);
+  Image out(320, 180);
+  ASSERT_TRUE(Scale(scaler, in, out));
+  EXPECT_EQ(1, scaler.GetThreads());
+  EXPECT_EQ(expected.pixels, out.pixels);
+}
+
+TEST_F(TestPictureScaler, ScaleImageChangingGeometry)
+{
+  // the scaler kept by ScaleImage has to follow every change of the geometry
+  const Image large = CreateImage(1920, 1080);
+  const Image small = CreateImage(640, 480);
+  const struct
+  {
+    const Image& in;
+    int width;
+    int height;
+  } steps[] = {{large, 1280, 720}, {large, 1280, 720}, {large, 960, 540},
+               {small, 320, 240},  {large, 1280, 720}, {small, 1280, 960}};
+
+  for (const auto& step : steps)
+  {
+    const Image expected = ScaleSingleThreaded(step.in, step.width, step.height);
+    Image out(step.width, step.height);
+    ASSERT_TRUE(ScaleImage(step.in, out));
+    EXPECT_EQ(expected.pixels, out.pixels) << step.in.width << "x" << step.in.height << " -> "
+                                           << step.width << "x" << step.height;
+  }
+}
+
+TEST_F(TestPictureScaler, PoolKeepsRecentlyUsed)
+{
+  CPictureScalerPool pool(2);
+  std::unique_ptr<CPictureScaler> scalers[] = {pool.Acquire(), pool.Acquire(), pool.Acquire()};
+  EXPECT_EQ(0u, pool.GetIdle());
+  const CPictureScaler* last = scalers[2].get();
+  for (auto& scaler : scalers)
+    pool.Release(std::move(scaler));
+
+  // the least recently used one was freed
+  EXPECT_EQ(2u, pool.GetIdle());
+  std::unique_ptr<CPictureScaler> scaler = pool.Acquire();
+  EXPECT_EQ(last, scaler.get());
+  EXPECT_EQ(0, scaler->GetRequestedThreads());
+  EXPECT_EQ(1u, pool.GetIdle());
+}
+
+TEST_F(TestPictureScaler, PoolSingleThreadedOnJobWorker)
+{
+  CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+  CPictureScalerPool pool;
+  pool.Release(pool.Acquire());
+
+  CEvent done;
+  int threads = -1;
+  size_t idle = 0;
+  CServiceBroker::GetJobManager()->Submit([&]() {
+    // the idle scaler with slice threads is left to the others
+    std::unique_ptr<CPictureScaler> scaler = pool.Acquire();
+    threads = scaler->GetRequestedThreads();
+    idle = pool.GetIdle();
+    pool.Release(std::move(scaler));
+    done.Set();
+  });
+
+  ASSERT_TRUE(done.Wait(5000ms));
+  EXPECT_EQ(1, threads);
+  EXPECT_EQ(1u, idle);
+  EXPECT_EQ(2u, pool.GetIdle());
+  CServiceBroker::UnregisterJobManager();
+}
@@ -0,0 +1,264 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "guilib/Texture.h"
+#include "pictures/GUIWindowSlideShow.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "test/MtTestUtils.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// 4 MB decoded
+constexpr unsigned int PICTURE_SIZE = 1024;
+
+class CTestTexture : public CTexture
+{
+public:
+  CTestTexture(unsigned int width, unsigned int height) : CTexture(width, height) {}
+
+  void CreateTextureObject() override {}
+  void DestroyTextureObject() override {}
+  void LoadToGPU() override {}
+  void BindToUnit(unsigned int unit) override {}
+};
+
+/*!
+ * \brief Decodes pictures without touching any file, keeping track of what it decoded.
+ * Pictures can be held back to keep them in flight.
+ */
+class CTestPictureLoader
+{
+public:
+  std::unique_ptr<CTexture> Load(const std::string& file, int maxWidth, int maxHeight)
+  {
+    m_running++;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      m_loaded.push_back(file);
+    }
+
+    if (std::find(m_heldBack.begin(), m_heldBack.end(), file) != m_heldBack.end())
+    {
+      m_started++;
+      m_release.Wait();
+    }
+    auto texture = std::make_unique<CTestTexture>(PICTURE_SIZE, PICTURE_SIZE);
+    m_running--;
+    return texture;
+  }
+
+  // the decodes of these pictures wait for Release()
+  void HoldBack(const std::string& file) { m_heldBack.push_back(file); }
+  bool WaitForStart(int count = 1)
+  {
+    return ConditionPoll::poll([this, count]() { return m_started >= count; });
+  }
+  void Release() { m_release.Set(); }
+  // dropped pictures may still be decoded after the test
+  bool WaitForIdle()
+  {
+    return ConditionPoll::poll([this]() { return m_running == 0; });
+  }
+
+  int GetLoadCount(const std::string& file)
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    return static_cast<int>(std::count(m_loaded.begin(), m_loaded.end(), file));
+  }
+
+private:
+  CCriticalSection m_critSection;
+  std::vector<std::string> m_loaded;
+  std::atomic<int> m_running{0};
+  std::vector<std::string> m_heldBack;
+  std::atomic<int> m_started{0};
+  CEvent m_release{true};
+};
+} // unnamed namespace
+
+class TestSlideShowPreloader : public testing::Test
+{
+protected:
+  TestSlideShowPreloader()
+  {
+    CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+    m_preloader = std::make_unique<CSlideShowPreloader>(
+        [this](const std::string& file, int maxWidth, int maxHeight) {
+          return m_loader.Load(file, maxWidth, maxHeight);
+        });
+  }
+
+  ~TestSlideShowPreloader() override
+  {
+    m_loader.Release();
+    EXPECT_TRUE(m_loader.WaitForIdle());
+    m_preloader.reset();
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  void SetUp() override { m_memory = Memory(); }
+  void TearDown() override { Memory() = m_memory; }
+
+  static int& Memory()
+  {
+    return CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_slideshowPreloadMemory;
+  }
+
+  bool Take(const std::string& file)
+  {
+    std::unique_ptr<CTexture> texture;
+    if (!m_preloader->Take(file, PICTURE_SIZE, PICTURE_SIZE, texture))
+      return false;
+
+    EXPECT_NE(nullptr, texture) << file;
+    return true;
+  }
+
+  CTestPictureLoader m_loader;
+  std::unique_ptr<CSlideShowPreloader> m_preloader;
+  int m_memory = 0;
+};
+
+TEST_F(TestSlideShowPreloader, Budget)
+{
+  Memory() = 10;
+
+  // the size of the pictures is known once the first one is decoded
+  m_preloader->Preload({"a.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  ASSERT_TRUE(Take("a.jpg"));
+
+  // only two more pictures of 4 MB fit into 10 MB
+  m_preloader->Preload({"b.jpg", "c.jpg", "d.jpg", "e.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  EXPECT_TRUE(Take("b.jpg"));
+  EXPECT_TRUE(Take("c.jpg"));
+  EXPECT_FALSE(Take("d.jpg"));
+  EXPECT_FALSE(Take("e.jpg"));
+
+  EXPECT_EQ(0, m_loader.GetLoadCount("d.jpg"));
+  EXPECT_EQ(0, m_loader.GetLoadCount("e.jpg"));
+}
+
+TEST_F(TestSlideShowPreloader, NoBudget)
+{
+  Memory() = 0;
+
+  m_preloader->Preload({"a.jpg", "b.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  EXPECT_FALSE(Take("a.jpg"));
+  EXPECT_FALSE(Take("b.jpg"));
+  EXPECT_EQ(0, m_loader.GetLoadCount("a.jpg"));
+}
+
+TEST_F(TestSlideShowPreloader, TakeWaitsForDecode)
+{
+  Memory() = 256;
+  m_loader.HoldBack("a.jpg");
+
+  m_preloader->Preload({"a.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  ASSERT_TRUE(m_loader.WaitForStart());
+
+  std::atomic<bool> released{false};
+  std::thread release([&]() {
+    std::this_thread::sleep_for(200ms);
+    released = true;
+    m_loader.Release();
+  });
+
+  // rather wait for the decode in flight than decode it a second time
+  EXPECT_TRUE(Take("a.jpg"));
+  EXPECT_TRUE(released);
+  release.join();
+
+  EXPECT_EQ(1, m_loader.GetLoadCount("a.jpg"));
+}
+
+TEST_F(TestSlideShowPreloader, DropsPicturesNoLongerComingUp)
+{
+  Memory() = 256;
+  m_loader.HoldBack("a.jpg");
+
+  m_preloader->Preload({"a.jpg", "b.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  ASSERT_TRUE(m_loader.WaitForStart());
+
+  // the slideshow went the other way, a.jpg is dropped while it is still being decoded
+  m_preloader->Preload({"b.jpg", "c.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  EXPECT_FALSE(Take("a.jpg"));
+  m_loader.Release();
+
+  EXPECT_TRUE(Take("b.jpg"));
+  EXPECT_TRUE(Take("c.jpg"));
+  EXPECT_EQ(1, m_loader.GetLoadCount("b.jpg"));
+
+  // pictures are handed out only once
+  EXPECT_FALSE(Take("b.jpg"));
+}
+
+TEST_F(TestSlideShowPreloader, EstimatesSizeBeforeFirstDecode)
+{
+  Memory() = 10;
+  m_loader.HoldBack("a.jpg");
+
+  // nothing decoded yet, the pictures are assumed to be of the full 4 MB
+  m_preloader->Preload({"a.jpg", "b.jpg", "c.jpg", "d.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  ASSERT_TRUE(m_loader.WaitForStart());
+  m_loader.Release();
+
+  EXPECT_TRUE(Take("a.jpg"));
+  EXPECT_TRUE(Take("b.jpg"));
+  EXPECT_FALSE(Take("c.jpg"));
+  EXPECT_EQ(0, m_loader.GetLoadCount("c.jpg"));
+  EXPECT_EQ(0, m_loader.GetLoadCount("d.jpg"));
+}
+
+TEST_F(TestSlideShowPreloader, CancelsDroppedPictures)
+{
+  Memory() = 256;
+  m_loader.HoldBack("a.jpg");
+  m_loader.HoldBack("b.jpg");
+  m_loader.HoldBack("c.jpg");
+
+  // two pictures are decoded at once, c.jpg is queued. The job manager adds workers for jobs
+  // submitted while all of them are busy
+  m_preloader->Preload({"a.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  ASSERT_TRUE(m_loader.WaitForStart());
+  m_preloader->Preload({"a.jpg", "b.jpg", "c.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  ASSERT_TRUE(m_loader.WaitForStart(2));
+
+  // dropping a.jpg while it is decoded hands its place to c.jpg, d.jpg is queued
+  m_preloader->Preload({"b.jpg", "c.jpg", "d.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  EXPECT_TRUE(ConditionPoll::poll([this]() { return m_loader.GetLoadCount("c.jpg") == 1; }));
+
+  // d.jpg is dropped before it is decoded
+  m_preloader->Preload({"b.jpg", "c.jpg"}, PICTURE_SIZE, PICTURE_SIZE);
+  m_loader.Release();
+
+  EXPECT_TRUE(Take("b.jpg"));
+  EXPECT_TRUE(Take("c.jpg"));
+  EXPECT_FALSE(Take("a.jpg"));
+  EXPECT_FALSE(Take("d.jpg"));
+  EXPECT_TRUE(m_loader.WaitForIdle());
+  EXPECT_EQ(0, m_loader.GetLoadCount("d.jpg"));
+}
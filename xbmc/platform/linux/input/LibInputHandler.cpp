@@ -98,7 +98,7 @@ CLibInputHandler::CLibInputHandler() : CThread("libinput")
   m_touch.reset(new CLibInputTouch());
   m_settings.reset(new CLibInputSettings(this));
 
-  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
+  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this, ANNOUNCEMENT::System);
 }
 
 CLibInputHandler::~CLibInputHandler()
@@ -22,6 +22,10 @@ public:
   virtual void OnItemInfo(int iItem);
 protected:
   void OnItemLoaded(CFileItem* pItem) override {};
+  void OnViewportChanged(const std::vector<CFileItemPtr>& items) override
+  {
+    m_thumbLoader.SetPriorityItems(items);
+  }
   bool Update(const std::string& strDirectory, bool updateFilterPath = true) override;
   bool OnPlayMedia(int iItem, const std::string& = "") override;
   void GetContextButtons(int itemNumber, CContextButtons &buttons) override;
@@ -167,13 +167,16 @@ bool CPVREpg::UpdateEntries(const CPVREpg& epg)
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
   /* copy over tags */
-  m_tags.UpdateEntries(epg.m_tags);
+  const bool bChanged = m_tags.UpdateEntries(epg.m_tags);
 
   /* update the last scan time of this table */
   m_lastScanTime = CDateTime::GetUTCDateTime();
   m_bUpdateLastScanTime = true;
 
-  m_events.Publish(PVREvent::Epg);
+  /* no need to let the guide refresh if the client delivered the same data again */
+  if (bChanged)
+    m_events.Publish(PVREvent::Epg);
+
   return true;
 }
 
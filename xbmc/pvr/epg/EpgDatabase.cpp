@@ -14,6 +14,7 @@
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgSearchData.h"
 #include "pvr/epg/EpgSearchFilter.h"
+#include "pvr/epg/EpgTimeIndex.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/StringUtils.h"
@@ -27,6 +28,16 @@
 using namespace dbiplus;
 using namespace PVR;
 
+namespace
+{
+const CDatabase::FullTextIndex EPG_TAGS_FULLTEXT_INDEX = {
+    "ft_epgtags",
+    "epgtags",
+    "idBroadcast",
+    {"sTitle", "sPlotOutline", "sPlot"},
+    {{"sTitle", "sPlotOutline"}}};
+} // unnamed namespace
+
 bool CPVREpgDatabase::Open()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -140,6 +151,14 @@ void CPVREpgDatabase::CreateAnalytics()
   std::unique_lock<CCriticalSection> lock(m_critSection);
   m_pDS->exec("CREATE UNIQUE INDEX idx_epg_idEpg_iStartTime on epgtags(idEpg, iStartTime desc);");
   m_pDS->exec("CREATE INDEX idx_epg_iEndTime on epgtags(iEndTime);");
+
+  if (CreateFullTextIndex(EPG_TAGS_FULLTEXT_INDEX) && m_sqlite)
+  {
+    // REPLACE INTO epgtags removes the conflicting row without firing delete triggers
+    m_pDS->exec("CREATE TRIGGER ft_epgtags_replace BEFORE INSERT ON epgtags FOR EACH ROW BEGIN "
+                "DELETE FROM ft_epgtags WHERE rowid IN (SELECT idBroadcast FROM epgtags "
+                "WHERE idEpg = new.idEpg AND iStartTime = new.iStartTime); END");
+  }
 }
 
 void CPVREpgDatabase::UpdateTables(int iVersion)
@@ -469,6 +488,38 @@ bool CPVREpgDatabase::HasTags(int iEpgID)
   return !strValue.empty();
 }
 
+bool CPVREpgDatabase::GetEpgTimeIndex(int iEpgID, CPVREpgTimeIndex& index)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const std::string strQuery = PrepareSQL("SELECT iStartTime, iEndTime "
+                                          "FROM epgtags "
+                                          "WHERE idEpg = %u ORDER BY iStartTime;",
+                                          iEpgID);
+
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      index.Reserve(m_pDS->num_rows());
+      while (!m_pDS->eof())
+      {
+        index.Add(static_cast<time_t>(m_pDS->fv(0).get_asInt()),
+                  static_cast<time_t>(m_pDS->fv(1).get_asInt()));
+        m_pDS->next();
+      }
+      m_pDS->close();
+      index.Finalize();
+      return true;
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load time index for EPG ({})", iEpgID);
+    }
+  }
+
+  return false;
+}
+
 CDateTime CPVREpgDatabase::GetLastEndTime(int iEpgID)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -565,6 +616,17 @@ public:
     return result;
   }
 
+  bool ToFullTextQuery(CDatabase::FullTextQuery& query) const
+  {
+    // full text queries can not express NOT or mixed AND/OR
+    if (m_terms.empty() || m_bHasNot || (m_bHasAnd && m_bHasOr))
+      return false;
+
+    query.terms = m_terms;
+    query.matchAll = m_bHasAnd;
+    return true;
+  }
+
 private:
   void Parse(const std::string& strSearchTerm)
   {
@@ -585,6 +647,7 @@ private:
         GetAndCutNextTerm(strParsedSearchTerm, strDummy);
         strFragment += " NOT ";
         bNextOR = false;
+        m_bHasNot = true;
       }
       else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
                StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
@@ -593,6 +656,7 @@ private:
         GetAndCutNextTerm(strParsedSearchTerm, strDummy);
         strFragment += " AND ";
         bNextOR = false;
+        m_bHasAnd = true;
       }
       else if (StringUtils::StartsWith(strParsedSearchTerm, "|") ||
                StringUtils::StartsWithNoCase(strParsedSearchTerm, "or"))
@@ -601,6 +665,7 @@ private:
         GetAndCutNextTerm(strParsedSearchTerm, strDummy);
         strFragment += " OR ";
         bNextOR = false;
+        m_bHasOr = true;
       }
       else
       {
@@ -608,8 +673,13 @@ private:
         GetAndCutNextTerm(strParsedSearchTerm, strTerm);
         if (!strTerm.empty())
         {
+          m_terms.emplace_back(strTerm);
+
           if (bNextOR && !m_fragments.empty())
+          {
             strFragment += " OR "; // default operator
+            m_bHasOr = true;
+          }
 
           strFragment += "(UPPER(";
 
@@ -660,16 +730,56 @@ private:
   }
 
   std::vector<std::string> m_fragments;
+  std::vector<std::string> m_terms;
+  bool m_bHasAnd = false;
+  bool m_bHasOr = false;
+  bool m_bHasNot = false;
 };
 
 } // unnamed namespace
 
+void CPVREpgDatabase::AppendSearchTermFilter(Filter& filter, const PVREpgSearchData& searchData)
+{
+  const CSearchTermConverter conv(searchData.m_strSearchTerm);
+
+  // use the full text index if the search term can be expressed with it, else scan the table
+  FullTextQuery query;
+  bool bFullText = false;
+  if (conv.ToFullTextQuery(query))
+  {
+    if (!searchData.m_bSearchInDescription)
+      query.columns = {"sTitle", "sPlotOutline"};
+
+    bFullText =
+        AppendFullTextFilter(filter, EPG_TAGS_FULLTEXT_INDEX, "epgtags.idBroadcast", query);
+  }
+
+  if (!bFullText)
+  {
+    // title
+    std::string strWhere = conv.ToSQL("sTitle");
+
+    // plot outline
+    strWhere += " OR ";
+    strWhere += conv.ToSQL("sPlotOutline");
+
+    if (searchData.m_bSearchInDescription)
+    {
+      // plot
+      strWhere += " OR ";
+      strWhere += conv.ToSQL("sPlot");
+    }
+
+    filter.AppendWhere(strWhere);
+  }
+}
+
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
     const PVREpgSearchData& searchData)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
-  std::string strQuery = PrepareSQL("SELECT * FROM epgtags");
+  std::string strQuery = PrepareSQL("SELECT epgtags.* FROM epgtags");
 
   Filter filter;
 
@@ -740,25 +850,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   /////////////////////////////////////////////////////////////////////////////////////////////
 
   if (!searchData.m_strSearchTerm.empty())
-  {
-    const CSearchTermConverter conv(searchData.m_strSearchTerm);
-
-    // title
-    std::string strWhere = conv.ToSQL("sTitle");
-
-    // plot outline
-    strWhere += " OR ";
-    strWhere += conv.ToSQL("sPlotOutline");
-
-    if (searchData.m_bSearchInDescription)
-    {
-      // plot
-      strWhere += " OR ";
-      strWhere += conv.ToSQL("sPlot");
-    }
-
-    filter.AppendWhere(strWhere);
-  }
+    AppendSearchTermFilter(filter, searchData);
 
   if (BuildSQL(strQuery, filter, strQuery))
   {
@@ -20,6 +20,7 @@ namespace PVR
 {
   class CPVREpg;
   class CPVREpgInfoTag;
+  class CPVREpgTimeIndex;
   class CPVREpgSearchFilter;
 
   struct PVREpgSearchData;
@@ -66,7 +67,7 @@ namespace PVR
      * @brief Get the minimal database version that is required to operate correctly.
      * @return The minimal database version.
      */
-    int GetSchemaVersion() const override { return 16; }
+    int GetSchemaVersion() const override { return 17; }
 
     /*!
      * @brief Get the default sqlite database filename.
@@ -124,6 +125,14 @@ namespace PVR
      */
     bool HasTags(int iEpgID);
 
+    /*!
+     * @brief Load start and end times of all tags of this EPG into the given index.
+     * @param iEpgID The ID of the EPG.
+     * @param index The index to fill.
+     * @return True on success, false otherwise.
+     */
+    bool GetEpgTimeIndex(int iEpgID, CPVREpgTimeIndex& index);
+
     /*!
      * @brief Get the end time of the last tag in this EPG.
      * @param iEpgID The ID of the EPG.
@@ -348,6 +357,15 @@ namespace PVR
 
     //@}
 
+  protected:
+    /*!
+     * @brief Restrict a filter to the EPG tags matching the search term of a search, using the
+     * full text index if the search term can be expressed with it.
+     * @param filter The filter.
+     * @param searchData The search.
+     */
+    void AppendSearchTermFilter(Filter& filter, const PVREpgSearchData& searchData);
+
   private:
     /*!
      * @brief Create the EPG database tables.
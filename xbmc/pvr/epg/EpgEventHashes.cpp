@@ -0,0 +1,44 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgEventHashes.h"
+
+#include <algorithm>
+
+using namespace PVR;
+
+void CPVREpgEventHashes::Assign(std::vector<Entry>&& entries)
+{
+  m_entries = std::move(entries);
+  m_entries.shrink_to_fit();
+}
+
+std::vector<CPVREpgEventHashes::Entry>::const_iterator CPVREpgEventHashes::Find(time_t start) const
+{
+  const auto it = std::lower_bound(m_entries.cbegin(), m_entries.cend(), start,
+                                   [](const Entry& entry, time_t t) { return entry.first < t; });
+  return (it != m_entries.cend() && it->first == start) ? it : m_entries.cend();
+}
+
+bool CPVREpgEventHashes::Contains(time_t start, size_t hash) const
+{
+  const auto it = Find(start);
+  return it != m_entries.cend() && it->second == hash;
+}
+
+void CPVREpgEventHashes::Erase(time_t start)
+{
+  const auto it = Find(start);
+  if (it != m_entries.cend())
+    m_entries.erase(it);
+}
+
+void CPVREpgEventHashes::Clear()
+{
+  m_entries.clear();
+}
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <ctime>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+
+/*!
+ * @brief Content hashes of the events of one EPG as last delivered by the client.
+ *
+ * Used to detect events that did not change since the previous update, so that
+ * these neither have to be loaded from nor written to the database again.
+ */
+class CPVREpgEventHashes
+{
+public:
+  using Entry = std::pair<time_t, size_t>; // start time, content hash
+
+  CPVREpgEventHashes() = default;
+
+  /*!
+   * @brief Replace all hashes.
+   * @param entries The new hashes, ordered by start time.
+   */
+  void Assign(std::vector<Entry>&& entries);
+
+  /*!
+   * @brief Check whether the event starting at the given time has the given hash.
+   * @param start The start time of the event.
+   * @param hash The content hash of the event.
+   * @return True if the hash matches, false otherwise.
+   */
+  bool Contains(time_t start, size_t hash) const;
+
+  /*!
+   * @brief Forget the hash of the event starting at the given time.
+   * @param start The start time of the event.
+   */
+  void Erase(time_t start);
+
+  /*!
+   * @brief Forget all hashes.
+   */
+  void Clear();
+
+  /*!
+   * @brief Get the number of hashes.
+   * @return The number of hashes.
+   */
+  size_t Size() const { return m_entries.size(); }
+
+private:
+  std::vector<Entry>::const_iterator Find(time_t start) const;
+
+  std::vector<Entry> m_entries;
+};
+
+} // namespace PVR
@@ -21,6 +21,7 @@
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -495,6 +496,63 @@ std::string CPVREpgInfoTag::Path() const
   return StringUtils::Format("pvr://guide/{:04}/{}.epg", EpgID(), m_startTime.GetAsDBDateTime());
 }
 
+namespace
+{
+template<typename T>
+void HashCombine(size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+void HashCombine(size_t& seed, const std::vector<std::string>& values)
+{
+  HashCombine(seed, values.size());
+  for (const auto& value : values)
+    HashCombine(seed, value);
+}
+
+void HashCombine(size_t& seed, const CDateTime& dateTime)
+{
+  time_t time = 0;
+  if (dateTime.IsValid())
+    dateTime.GetAsTime(time);
+  HashCombine(seed, time);
+}
+} // unnamed namespace
+
+size_t CPVREpgInfoTag::GetContentHash() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  size_t hash = 0;
+  HashCombine(hash, m_strTitle);
+  HashCombine(hash, m_strPlotOutline);
+  HashCombine(hash, m_strPlot);
+  HashCombine(hash, m_strOriginalTitle);
+  HashCombine(hash, m_cast);
+  HashCombine(hash, m_directors);
+  HashCombine(hash, m_writers);
+  HashCombine(hash, m_iYear);
+  HashCombine(hash, m_strIMDBNumber);
+  HashCombine(hash, m_startTime);
+  HashCombine(hash, m_endTime);
+  HashCombine(hash, m_iGenreType);
+  HashCombine(hash, m_iGenreSubType);
+  HashCombine(hash, m_strGenreDescription);
+  HashCombine(hash, m_firstAired);
+  HashCombine(hash, m_iParentalRating);
+  HashCombine(hash, m_strParentalRatingCode);
+  HashCombine(hash, m_iStarRating);
+  HashCombine(hash, m_iEpisodeNumber);
+  HashCombine(hash, m_iEpisodePart);
+  HashCombine(hash, m_iSeriesNumber);
+  HashCombine(hash, m_strEpisodeName);
+  HashCombine(hash, m_iUniqueBroadcastID);
+  HashCombine(hash, m_iconPath.GetClientImage());
+  HashCombine(hash, m_iFlags);
+  HashCombine(hash, m_strSeriesLink);
+  return hash;
+}
+
 bool CPVREpgInfoTag::Update(const CPVREpgInfoTag& tag, bool bUpdateBroadcastId /* = true */)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
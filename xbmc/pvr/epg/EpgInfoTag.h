@@ -387,6 +387,13 @@ public:
    */
   bool Update(const CPVREpgInfoTag& tag, bool bUpdateBroadcastId = true);
 
+  /*!
+   * @brief Get a hash over the event data of this tag, as compared by Update().
+   * @note Database id, EPG id and channel data are not part of the hash.
+   * @return The hash.
+   */
+  size_t GetContentHash() const;
+
   /*!
    * @brief Retrieve the edit decision list (EDL) of an EPG tag.
    * @return The edit decision list (empty on error)
@@ -12,6 +12,7 @@
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgTagsCache.h"
+#include "pvr/epg/EpgTimeIndex.h"
 #include "utils/log.h"
 
 #include <algorithm>
@@ -22,7 +23,19 @@ using namespace PVR;
 namespace
 {
 const CDateTimeSpan ONE_SECOND(0, 0, 0, 1);
+
+time_t ToTime(const CDateTime& dateTime)
+{
+  time_t t;
+  dateTime.GetAsTime(t);
+  return t;
+}
+
+CDateTime ToDateTime(const std::pair<bool, time_t>& time)
+{
+  return time.first ? CDateTime(time.second) : CDateTime();
 }
+} // unnamed namespace
 
 CPVREpgTagsContainer::CPVREpgTagsContainer(int iEpgID,
                                            const std::shared_ptr<CPVREpgChannelData>& channelData,
@@ -39,6 +52,7 @@ CPVREpgTagsContainer::~CPVREpgTagsContainer() = default;
 void CPVREpgTagsContainer::SetEpgID(int iEpgID)
 {
   m_iEpgID = iEpgID;
+  m_timeIndex.reset();
   for (const auto& tag : m_changedTags)
     tag.second->SetEpgID(iEpgID);
 }
@@ -138,8 +152,38 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
 
   if (m_database)
   {
-    const CDateTime minEventEnd = (*tags.m_changedTags.cbegin()).second->StartAsUTC() + ONE_SECOND;
-    const CDateTime maxEventStart = (*tags.m_changedTags.crbegin()).second->EndAsUTC();
+    // Skip events the client delivered unchanged last time, as long as they are still stored
+    const CPVREpgTimeIndex* index = GetTimeIndex();
+    std::vector<CPVREpgEventHashes::Entry> hashes;
+    hashes.reserve(tags.m_changedTags.size());
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> updatedTags;
+
+    for (const auto& tagsEntry : tags.m_changedTags)
+    {
+      const auto& tag = tagsEntry.second;
+      const time_t start = ToTime(tagsEntry.first);
+      const size_t hash = tag->GetContentHash();
+      hashes.emplace_back(start, hash);
+
+      if (m_eventHashes.Contains(start, hash) &&
+          m_deletedTags.find(tagsEntry.first) == m_deletedTags.cend() &&
+          (m_changedTags.find(tagsEntry.first) != m_changedTags.cend() ||
+           (index && index->HasStart(start))))
+        continue;
+
+      updatedTags.emplace_back(tag);
+    }
+
+    m_eventHashes.Assign(std::move(hashes));
+
+    CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Tags Container: {} of {} events changed for epg id {}",
+                updatedTags.size(), tags.m_changedTags.size(), m_iEpgID);
+
+    if (updatedTags.empty())
+      return false;
+
+    const CDateTime minEventEnd = updatedTags.front()->StartAsUTC() + ONE_SECOND;
+    const CDateTime maxEventStart = updatedTags.back()->EndAsUTC();
 
     std::vector<std::shared_ptr<CPVREpgInfoTag>> existingTags =
         m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
@@ -160,10 +204,8 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
     }
 
     bool bResetCache = false;
-    for (const auto& tagsEntry : tags.m_changedTags)
+    for (const auto& tag : updatedTags)
     {
-      const auto& tag = tagsEntry.second;
-
       tag->SetChannelData(m_channelData);
       tag->SetEpgID(m_iEpgID);
 
@@ -195,6 +237,8 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
 
     if (bResetCache)
       m_tagsCache->Reset();
+
+    return bResetCache;
   }
   else
   {
@@ -279,6 +323,7 @@ bool CPVREpgTagsContainer::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
 {
   tag->SetChannelData(m_channelData);
   tag->SetEpgID(m_iEpgID);
+  m_eventHashes.Erase(ToTime(tag->StartAsUTC()));
 
   std::shared_ptr<CPVREpgInfoTag> existingTag = GetTag(tag->StartAsUTC());
   if (existingTag)
@@ -304,6 +349,7 @@ bool CPVREpgTagsContainer::DeleteEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
 {
   m_changedTags.erase(tag->StartAsUTC());
   m_deletedTags.insert({tag->StartAsUTC(), tag});
+  m_eventHashes.Erase(ToTime(tag->StartAsUTC()));
   m_tagsCache->Reset();
   return true;
 }
@@ -332,13 +378,30 @@ void CPVREpgTagsContainer::Cleanup(const CDateTime& time)
     m_tagsCache->Reset();
 
   if (m_database)
+  {
     m_database->DeleteEpgTags(m_iEpgID, time);
+    m_timeIndex.reset();
+  }
 }
 
 void CPVREpgTagsContainer::Clear()
 {
   m_changedTags.clear();
   m_tagsCache->Reset();
+
+  // called after queueing database changes, reload the index once they are committed
+  m_timeIndex.reset();
+}
+
+const CPVREpgTimeIndex* CPVREpgTagsContainer::GetTimeIndex() const
+{
+  if (!m_timeIndex && m_database)
+  {
+    auto index = std::make_unique<CPVREpgTimeIndex>();
+    if (m_database->GetEpgTimeIndex(m_iEpgID, *index))
+      m_timeIndex = std::move(index);
+  }
+  return m_timeIndex.get();
 }
 
 bool CPVREpgTagsContainer::IsEmpty() const
@@ -347,7 +410,10 @@ bool CPVREpgTagsContainer::IsEmpty() const
     return false;
 
   if (m_database)
-    return !m_database->HasTags(m_iEpgID);
+  {
+    const CPVREpgTimeIndex* index = GetTimeIndex();
+    return index ? index->IsEmpty() : !m_database->HasTags(m_iEpgID);
+  }
 
   return true;
 }
@@ -359,7 +425,13 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpgTagsContainer::GetTag(const CDateTime& st
     return (*it).second;
 
   if (m_database)
+  {
+    const CPVREpgTimeIndex* index = GetTimeIndex();
+    if (index && !index->HasStart(ToTime(startTime)))
+      return {};
+
     return CreateEntry(m_database->GetEpgTagByStartTime(m_iEpgID, startTime));
+  }
 
   return {};
 }
@@ -474,6 +546,24 @@ void CPVREpgTagsContainer::MergeTags(const CDateTime& minEventEnd,
     FixOverlappingEvents(tags);
 }
 
+CDateTime CPVREpgTagsContainer::GetMaxEndTime(const CPVREpgTimeIndex* index,
+                                              const CDateTime& maxEnd) const
+{
+  if (index)
+    return ToDateTime(index->GetMaxEndTime(ToTime(maxEnd)));
+
+  return m_database->GetMaxEndTime(m_iEpgID, maxEnd);
+}
+
+CDateTime CPVREpgTagsContainer::GetMinStartTime(const CPVREpgTimeIndex* index,
+                                                const CDateTime& minStart) const
+{
+  if (index)
+    return ToDateTime(index->GetMinStartTime(ToTime(minStart)));
+
+  return m_database->GetMinStartTime(m_iEpgID, minStart);
+}
+
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     const CDateTime& timelineStart,
     const CDateTime& timelineEnd,
@@ -484,10 +574,14 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
   {
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
 
+    const CPVREpgTimeIndex* index = GetTimeIndex();
+
     bool loadFromDb = true;
     if (!m_changedTags.empty())
     {
-      const CDateTime lastEnd = m_database->GetLastEndTime(m_iEpgID);
+      const CDateTime lastEnd =
+          index ? (index->IsEmpty() ? CDateTime() : CDateTime(index->GetLastEnd()))
+                : m_database->GetLastEndTime(m_iEpgID);
       if (!lastEnd.IsValid() || lastEnd < minEventEnd)
       {
         // nothing in the db yet. take what we have in memory.
@@ -498,7 +592,9 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
 
     if (loadFromDb)
     {
-      tags = m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
+      // only materialize tags if the index knows of any in the requested range
+      if (!index || index->HasEventsBetween(ToTime(minEventEnd), ToTime(maxEventStart)))
+        tags = m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
 
       if (!m_changedTags.empty())
       {
@@ -542,11 +638,11 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
     if (result.empty())
     {
       // create single gap tag
-      CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+      CDateTime maxEnd = GetMaxEndTime(index, minEventEnd);
       if (!maxEnd.IsValid() || maxEnd < timelineStart)
         maxEnd = timelineStart;
 
-      CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+      CDateTime minStart = GetMinStartTime(index, maxEventStart);
       if (!minStart.IsValid() || minStart > timelineEnd)
         minStart = timelineEnd;
 
@@ -557,7 +653,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.front()->StartAsUTC() > minEventEnd)
       {
         // prepend gap tag
-        CDateTime maxEnd = m_database->GetMaxEndTime(m_iEpgID, minEventEnd);
+        CDateTime maxEnd = GetMaxEndTime(index, minEventEnd);
         if (!maxEnd.IsValid() || maxEnd < timelineStart)
           maxEnd = timelineStart;
 
@@ -567,7 +663,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetTimeline(
       if (result.back()->EndAsUTC() < maxEventStart)
       {
         // append gap tag
-        CDateTime minStart = m_database->GetMinStartTime(m_iEpgID, maxEventStart);
+        CDateTime minStart = GetMinStartTime(index, maxEventStart);
         if (!minStart.IsValid() || minStart > timelineEnd)
           minStart = timelineEnd;
 
@@ -586,7 +682,9 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTagsContainer::GetAllTags()
   if (m_database)
   {
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
-    if (!m_changedTags.empty() && !m_database->HasTags(m_iEpgID))
+    const CPVREpgTimeIndex* index = GetTimeIndex();
+    if (!m_changedTags.empty() &&
+        (index ? index->IsEmpty() : !m_database->HasTags(m_iEpgID)))
     {
       // nothing in the db yet. take what we have in memory.
       std::transform(m_changedTags.cbegin(), m_changedTags.cend(), std::back_inserter(tags),
@@ -664,5 +762,6 @@ void CPVREpgTagsContainer::QueueDelete()
   if (m_database)
     m_database->QueueDeleteEpgTags(m_iEpgID);
 
+  m_eventHashes.Clear();
   Clear();
 }
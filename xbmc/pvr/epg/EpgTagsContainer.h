@@ -9,6 +9,7 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "pvr/epg/EpgEventHashes.h"
 
 #include <map>
 #include <memory>
@@ -20,6 +21,7 @@ class CPVREpgTagsCache;
 class CPVREpgChannelData;
 class CPVREpgDatabase;
 class CPVREpgInfoTag;
+class CPVREpgTimeIndex;
 
 class CPVREpgTagsContainer
 {
@@ -57,9 +59,10 @@ public:
   bool DeleteEntry(const std::shared_ptr<CPVREpgInfoTag>& tag);
 
   /*!
-   * @brief Update all entries with the provided tags.
+   * @brief Update all entries with the provided tags. Tags unchanged since the last update are
+   * skipped.
    * @param tags The  updated tags.
-   * @return True if the update was successful, false otherwise.
+   * @return True if any entry was added or changed, false otherwise.
    */
   bool UpdateEntries(const CPVREpgTagsContainer& tags);
 
@@ -215,6 +218,28 @@ private:
   void FixOverlappingEvents(std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
   void FixOverlappingEvents(std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>>& tags) const;
 
+  /*!
+   * @brief Get the time index of the events stored in the database, loading it if needed.
+   * @return The index or nullptr if it could not be loaded.
+   */
+  const CPVREpgTimeIndex* GetTimeIndex() const;
+
+  /*!
+   * @brief Get the end time of the last database event ending at or before the given time.
+   * @param index The time index or nullptr to query the database.
+   * @param maxEnd The max end time.
+   * @return The time, invalid if no event was found.
+   */
+  CDateTime GetMaxEndTime(const CPVREpgTimeIndex* index, const CDateTime& maxEnd) const;
+
+  /*!
+   * @brief Get the start time of the first database event starting after the given time.
+   * @param index The time index or nullptr to query the database.
+   * @param minStart The min start time.
+   * @return The time, invalid if no event was found.
+   */
+  CDateTime GetMinStartTime(const CPVREpgTimeIndex* index, const CDateTime& minStart) const;
+
   int m_iEpgID = 0;
   std::shared_ptr<CPVREpgChannelData> m_channelData;
   const std::shared_ptr<CPVREpgDatabase> m_database;
@@ -222,6 +247,8 @@ private:
 
   std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_changedTags;
   std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_deletedTags;
+  mutable std::unique_ptr<CPVREpgTimeIndex> m_timeIndex;
+  CPVREpgEventHashes m_eventHashes;
 };
 
 } // namespace PVR
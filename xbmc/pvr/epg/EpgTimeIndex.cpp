@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgTimeIndex.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace PVR;
+
+void CPVREpgTimeIndex::Reserve(size_t iCount)
+{
+  m_starts.reserve(iCount);
+  m_ends.reserve(iCount);
+}
+
+void CPVREpgTimeIndex::Add(time_t start, time_t end)
+{
+  m_starts.emplace_back(start);
+  m_ends.emplace_back(end);
+}
+
+void CPVREpgTimeIndex::Finalize()
+{
+  if (!std::is_sorted(m_starts.cbegin(), m_starts.cend()))
+  {
+    std::vector<size_t> order(m_starts.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [this](size_t a, size_t b) { return m_starts[a] < m_starts[b]; });
+
+    std::vector<time_t> starts, ends;
+    starts.reserve(order.size());
+    ends.reserve(order.size());
+    for (size_t i : order)
+    {
+      starts.emplace_back(m_starts[i]);
+      ends.emplace_back(m_ends[i]);
+    }
+    m_starts = std::move(starts);
+    m_ends = std::move(ends);
+  }
+
+  m_maxEnds.resize(m_ends.size());
+  time_t maxEnd = 0;
+  for (size_t i = 0; i < m_ends.size(); ++i)
+  {
+    maxEnd = std::max(maxEnd, m_ends[i]);
+    m_maxEnds[i] = maxEnd;
+  }
+
+  m_starts.shrink_to_fit();
+  m_ends.shrink_to_fit();
+}
+
+time_t CPVREpgTimeIndex::GetLastEnd() const
+{
+  return m_maxEnds.empty() ? 0 : m_maxEnds.back();
+}
+
+bool CPVREpgTimeIndex::HasStart(time_t start) const
+{
+  return std::binary_search(m_starts.cbegin(), m_starts.cend(), start);
+}
+
+std::pair<size_t, size_t> CPVREpgTimeIndex::GetRange(time_t minEnd, time_t maxStart) const
+{
+  // all events before first end before minEnd, all events from last on start after maxStart
+  const size_t first =
+      std::lower_bound(m_maxEnds.cbegin(), m_maxEnds.cend(), minEnd) - m_maxEnds.cbegin();
+  const size_t last =
+      std::upper_bound(m_starts.cbegin(), m_starts.cend(), maxStart) - m_starts.cbegin();
+  return {first, std::max(first, last)};
+}
+
+bool CPVREpgTimeIndex::HasEventsBetween(time_t minEnd, time_t maxStart) const
+{
+  const auto range = GetRange(minEnd, maxStart);
+  for (size_t i = range.first; i < range.second; ++i)
+  {
+    if (m_ends[i] >= minEnd)
+      return true;
+  }
+  return false;
+}
+
+std::pair<bool, time_t> CPVREpgTimeIndex::GetMaxEndTime(time_t maxEnd) const
+{
+  // only events starting at or before maxEnd can end at or before it
+  size_t i = std::upper_bound(m_starts.cbegin(), m_starts.cend(), maxEnd) - m_starts.cbegin();
+
+  bool bFound = false;
+  time_t result = 0;
+  while (i > 0)
+  {
+    --i;
+    // no earlier event can end later than this
+    if (bFound && m_maxEnds[i] <= result)
+      break;
+
+    if (m_ends[i] <= maxEnd && (!bFound || m_ends[i] > result))
+    {
+      result = m_ends[i];
+      bFound = true;
+    }
+  }
+  return {bFound, result};
+}
+
+std::pair<bool, time_t> CPVREpgTimeIndex::GetMinStartTime(time_t minStart) const
+{
+  const auto it = std::upper_bound(m_starts.cbegin(), m_starts.cend(), minStart);
+  if (it == m_starts.cend())
+    return {false, 0};
+
+  return {true, *it};
+}
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <ctime>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+
+/*!
+ * @brief Compact, read-only time index of the events of one EPG.
+ *
+ * Stores start and end time of every event in separate sorted arrays
+ * (24 bytes per event) so that timeline boundaries and lookups can be
+ * answered without a database round trip and without materializing
+ * CPVREpgInfoTag instances. Events are ordered by start time; a running maximum
+ * of the end times keeps interval queries correct even for overlapping events.
+ */
+class CPVREpgTimeIndex
+{
+public:
+  CPVREpgTimeIndex() = default;
+
+  /*!
+   * @brief Reserve memory for the given number of events.
+   * @param iCount The number of events.
+   */
+  void Reserve(size_t iCount);
+
+  /*!
+   * @brief Add an event. Events should be added in ascending start time order.
+   * @param start The start time of the event.
+   * @param end The end time of the event.
+   */
+  void Add(time_t start, time_t end);
+
+  /*!
+   * @brief Finish building the index. Must be called after the last call to Add.
+   */
+  void Finalize();
+
+  /*!
+   * @brief Check whether the index contains any events.
+   * @return True if empty, false otherwise.
+   */
+  bool IsEmpty() const { return m_starts.empty(); }
+
+  /*!
+   * @brief Get the number of events in this index.
+   * @return The number of events.
+   */
+  size_t Size() const { return m_starts.size(); }
+
+  /*!
+   * @brief Get the latest end time of all events.
+   * @return The end time or 0 if the index is empty.
+   */
+  time_t GetLastEnd() const;
+
+  /*!
+   * @brief Check whether an event with the given start time exists.
+   * @param start The start time.
+   * @return True if such an event exists, false otherwise.
+   */
+  bool HasStart(time_t start) const;
+
+  /*!
+   * @brief Check whether any event ends at or after minEnd and starts at or before maxStart.
+   * @param minEnd The minimum end time.
+   * @param maxStart The maximum start time.
+   * @return True if at least one event matches, false otherwise.
+   */
+  bool HasEventsBetween(time_t minEnd, time_t maxStart) const;
+
+  /*!
+   * @brief Get the latest end time of all events ending at or before the given time.
+   * @param maxEnd The maximum end time.
+   * @return first: true if an event was found, second: its end time.
+   */
+  std::pair<bool, time_t> GetMaxEndTime(time_t maxEnd) const;
+
+  /*!
+   * @brief Get the earliest start time of all events starting after the given time.
+   * @param minStart The time the event must start after.
+   * @return first: true if an event was found, second: its start time.
+   */
+  std::pair<bool, time_t> GetMinStartTime(time_t minStart) const;
+
+private:
+  std::pair<size_t, size_t> GetRange(time_t minEnd, time_t maxStart) const;
+
+  std::vector<time_t> m_starts;
+  std::vector<time_t> m_ends;
+  std::vector<time_t> m_maxEnds; // running maximum of m_ends
+};
+
+} // namespace PVR
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgSearchData.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/StringUtils.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+class CTestEpgDatabase : public CPVREpgDatabase
+{
+public:
+  void SetMySQL() { m_sqlite = false; }
+
+  void DropFullTextIndex() { m_pDS->exec("DROP TABLE ft_epgtags"); }
+
+  Filter GetSearchTermFilter(const std::string& searchTerm, bool searchInDescription)
+  {
+    PVREpgSearchData searchData;
+    searchData.m_strSearchTerm = searchTerm;
+    searchData.m_bSearchInDescription = searchInDescription;
+
+    Filter filter;
+    AppendSearchTermFilter(filter, searchData);
+    return filter;
+  }
+};
+
+// the LIKE fallback on title and plot outline, plus the plot if searched in the description
+std::string Like(const std::string& fieldTemplate, bool searchInDescription)
+{
+  std::string where;
+  for (const std::string field : {"sTitle", "sPlotOutline", "sPlot"})
+  {
+    if (field == "sPlot" && !searchInDescription)
+      break;
+
+    if (!where.empty())
+      where += " OR ";
+    std::string condition = fieldTemplate;
+    StringUtils::Replace(condition, "FIELD", field);
+    where += condition;
+  }
+  return where;
+}
+
+const std::string FOO_OR_BAR =
+    "((UPPER(FIELD) LIKE UPPER('%foo%'))  OR (UPPER(FIELD) LIKE UPPER('%bar%')))";
+const std::string FOO_AND_NOT_BAR =
+    "((UPPER(FIELD) LIKE UPPER('%foo%'))  AND  NOT (UPPER(FIELD) LIKE UPPER('%bar%')))";
+const std::string FOO_AND_BAR_OR_BAZ =
+    "((UPPER(FIELD) LIKE UPPER('%foo%'))  AND (UPPER(FIELD) LIKE UPPER('%bar%'))  "
+    "OR (UPPER(FIELD) LIKE UPPER('%baz%')))";
+} // unnamed namespace
+
+class TestEpgDatabase : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_settings.type = "sqlite3";
+    m_settings.name = "epgtest";
+    m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db");
+  }
+
+  void TearDown() override
+  {
+    m_database->Close();
+    XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db");
+  }
+
+  bool Connect() { return m_database->Connect(m_settings.name, m_settings, true); }
+
+  DatabaseSettings m_settings;
+  std::shared_ptr<CTestEpgDatabase> m_database = std::make_shared<CTestEpgDatabase>();
+};
+
+TEST_F(TestEpgDatabase, SqliteFullText)
+{
+  ASSERT_TRUE(Connect());
+
+  // terms are combined with OR by default
+  CDatabase::Filter filter = m_database->GetSearchTermFilter("foo bar", false);
+  EXPECT_EQ(" JOIN (SELECT rowid AS ftId, rank AS ftScore FROM ft_epgtags WHERE ft_epgtags MATCH "
+            "'{sTitle sPlotOutline} : (\"foo\" * OR \"bar\" *)') AS ft_epgtags "
+            "ON ft_epgtags.ftId = epgtags.idBroadcast",
+            filter.join);
+  EXPECT_EQ("", filter.where);
+  EXPECT_EQ("ft_epgtags.ftScore", filter.order);
+
+  filter = m_database->GetSearchTermFilter("foo and bar", true);
+  EXPECT_EQ(" JOIN (SELECT rowid AS ftId, rank AS ftScore FROM ft_epgtags WHERE ft_epgtags MATCH "
+            "'\"foo\" * AND \"bar\" *') AS ft_epgtags ON ft_epgtags.ftId = epgtags.idBroadcast",
+            filter.join);
+  EXPECT_EQ("", filter.where);
+
+  filter = m_database->GetSearchTermFilter("it's + bar", true);
+  EXPECT_EQ(" JOIN (SELECT rowid AS ftId, rank AS ftScore FROM ft_epgtags WHERE ft_epgtags MATCH "
+            "'\"it''s\" * AND \"bar\" *') AS ft_epgtags ON ft_epgtags.ftId = epgtags.idBroadcast",
+            filter.join);
+}
+
+TEST_F(TestEpgDatabase, SqliteNotAndMixedOperators)
+{
+  ASSERT_TRUE(Connect());
+
+  // full text queries can't express these, the table is scanned
+  CDatabase::Filter filter = m_database->GetSearchTermFilter("foo and not bar", false);
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ(Like(FOO_AND_NOT_BAR, false), filter.where);
+  EXPECT_EQ("", filter.order);
+
+  filter = m_database->GetSearchTermFilter("foo and bar or baz", true);
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ(Like(FOO_AND_BAR_OR_BAZ, true), filter.where);
+  EXPECT_EQ("", filter.order);
+}
+
+TEST_F(TestEpgDatabase, SqliteMissingIndex)
+{
+  // e.g. created with a sqlite library without fts5
+  ASSERT_TRUE(Connect());
+  m_database->DropFullTextIndex();
+  m_database->Close();
+
+  ASSERT_TRUE(Connect());
+  const CDatabase::Filter filter = m_database->GetSearchTermFilter("foo bar", true);
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ(Like(FOO_OR_BAR, true), filter.where);
+  EXPECT_EQ("", filter.order);
+}
+
+TEST_F(TestEpgDatabase, MySQLMissingIndex)
+{
+  // MySQL escapes through the connection, without a server there is no index to find
+  m_database->SetMySQL();
+
+  CDatabase::Filter filter = m_database->GetSearchTermFilter("foo bar", false);
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ(Like(FOO_OR_BAR, false), filter.where);
+  EXPECT_EQ("", filter.order);
+
+  filter = m_database->GetSearchTermFilter("foo bar", true);
+  EXPECT_EQ(Like(FOO_OR_BAR, true), filter.where);
+}
+
+TEST_F(TestEpgDatabase, MySQLNotAndMixedOperators)
+{
+  m_database->SetMySQL();
+
+  CDatabase::Filter filter = m_database->GetSearchTermFilter("foo and not bar", true);
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ(Like(FOO_AND_NOT_BAR, true), filter.where);
+
+  filter = m_database->GetSearchTermFilter("foo and bar or baz", false);
+  EXPECT_EQ("", filter.join);
+  EXPECT_EQ(Like(FOO_AND_BAR_OR_BAZ, false), filter.where);
+}
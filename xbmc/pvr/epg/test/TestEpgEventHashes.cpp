@@ -0,0 +1,177 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgEventHashes.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgTagsContainer.h"
+#include "settings/AdvancedSettings.h"
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr int CLIENT_ID = 1;
+constexpr int CHANNEL_UID = 2;
+constexpr int EPG_ID = 3;
+constexpr time_t START = 1700000000;
+constexpr time_t DURATION = 30 * 60;
+constexpr int EVENTS = 5;
+
+class CTestEpgDatabase : public CPVREpgDatabase
+{
+public:
+  void Execute(const std::string& sql) { m_pDS->exec(sql); }
+};
+
+std::shared_ptr<CPVREpgInfoTag> CreateTag(int event,
+                                          const std::string& title,
+                                          const std::shared_ptr<CPVREpgChannelData>& channelData,
+                                          int epgID = EPG_ID,
+                                          int genre = EPG_EVENT_CONTENTMASK_MOVIEDRAMA)
+{
+  EPG_TAG data = {};
+  data.iUniqueBroadcastId = event + 1;
+  data.iUniqueChannelId = CHANNEL_UID;
+  data.strTitle = title.c_str();
+  data.strPlot = "plot";
+  data.startTime = START + event * DURATION;
+  data.endTime = data.startTime + DURATION;
+  data.iGenreType = genre;
+  return std::make_shared<CPVREpgInfoTag>(data, CLIENT_ID, channelData, epgID);
+}
+} // unnamed namespace
+
+class TestEpgEventHashes : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_settings.type = "sqlite3";
+    m_settings.name = "epghashtest";
+    m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db");
+    ASSERT_TRUE(m_database->Connect(m_settings.name, m_settings, true));
+  }
+
+  void TearDown() override
+  {
+    m_database->Close();
+    XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db");
+  }
+
+  //! deliver the events as the client would, the given one with a different title
+  bool Update(int changedEvent = -1)
+  {
+    CPVREpgTagsContainer update(EPG_ID, m_channelData, nullptr);
+    for (int event = 0; event < EVENTS; event++)
+      update.UpdateEntry(
+          CreateTag(event, event == changedEvent ? "changed" : "title", m_channelData));
+
+    const bool changed = m_tags.UpdateEntries(update);
+    m_tags.QueuePersistQuery();
+    m_database->CommitDeleteQueries();
+    m_database->CommitInsertQueries();
+    return changed;
+  }
+
+  std::string GetStoredTitle(int event)
+  {
+    const auto tag = m_database->GetEpgTagByStartTime(EPG_ID, CDateTime(START + event * DURATION));
+    return tag ? tag->Title() : "";
+  }
+
+  void SetStoredTitle(int event, const std::string& title)
+  {
+    m_database->Execute(m_database->PrepareSQL(
+        "UPDATE epgtags SET sTitle='%s' WHERE iStartTime=%i", title.c_str(),
+        static_cast<int>(START + event * DURATION)));
+  }
+
+  DatabaseSettings m_settings;
+  std::shared_ptr<CTestEpgDatabase> m_database = std::make_shared<CTestEpgDatabase>();
+  std::shared_ptr<CPVREpgChannelData> m_channelData =
+      std::make_shared<CPVREpgChannelData>(CLIENT_ID, CHANNEL_UID);
+  CPVREpgTagsContainer m_tags{EPG_ID, m_channelData, m_database};
+};
+
+TEST(TestEpgEventHashesEntries, ContainsAndErase)
+{
+  CPVREpgEventHashes hashes;
+  hashes.Assign({{100, 1}, {200, 2}, {300, 3}});
+
+  EXPECT_EQ(hashes.Size(), 3u);
+  EXPECT_TRUE(hashes.Contains(200, 2));
+  EXPECT_FALSE(hashes.Contains(200, 3));
+  EXPECT_FALSE(hashes.Contains(250, 2));
+
+  hashes.Erase(200);
+  EXPECT_FALSE(hashes.Contains(200, 2));
+  EXPECT_TRUE(hashes.Contains(300, 3));
+
+  hashes.Clear();
+  EXPECT_FALSE(hashes.Contains(100, 1));
+  EXPECT_EQ(hashes.Size(), 0u);
+}
+
+TEST(TestEpgEventHashesEntries, ContentHash)
+{
+  const auto channelData = std::make_shared<CPVREpgChannelData>(CLIENT_ID, CHANNEL_UID);
+  const size_t hash = CreateTag(0, "title", channelData)->GetContentHash();
+
+  // only the content delivered by the client counts
+  EXPECT_EQ(hash, CreateTag(0, "title", channelData)->GetContentHash());
+  EXPECT_EQ(hash, CreateTag(0, "title", channelData, EPG_ID + 1)->GetContentHash());
+
+  EXPECT_NE(hash, CreateTag(0, "other title", channelData)->GetContentHash());
+  EXPECT_NE(hash, CreateTag(1, "title", channelData)->GetContentHash());
+  EXPECT_NE(hash, CreateTag(0, "title", channelData, EPG_ID, EPG_EVENT_CONTENTMASK_SPORTS)
+                      ->GetContentHash());
+}
+
+TEST_F(TestEpgEventHashes, UnchangedEventsAreSkipped)
+{
+  ASSERT_TRUE(Update());
+  for (int event = 0; event < EVENTS; event++)
+    EXPECT_EQ("title", GetStoredTitle(event));
+
+  // the same guide again is neither compared with nor written to the database
+  SetStoredTitle(1, "stored");
+  EXPECT_FALSE(Update());
+  EXPECT_EQ("stored", GetStoredTitle(1));
+
+  // only the changed event is
+  SetStoredTitle(2, "stored");
+  EXPECT_TRUE(Update(2));
+  EXPECT_EQ("changed", GetStoredTitle(2));
+  EXPECT_EQ("stored", GetStoredTitle(1));
+}
+
+TEST_F(TestEpgEventHashes, UnchangedEventsMissingFromDatabase)
+{
+  ASSERT_TRUE(Update());
+
+  // e.g. removed by the cleanup of the guide, the event is written again
+  m_database->Execute(m_database->PrepareSQL("DELETE FROM epgtags WHERE iStartTime=%i",
+                                             static_cast<int>(START + 3 * DURATION)));
+  EXPECT_TRUE(Update());
+  EXPECT_EQ("title", GetStoredTitle(3));
+}
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgTimeIndex.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+CPVREpgTimeIndex CreateIndex(const std::vector<std::pair<time_t, time_t>>& events)
+{
+  CPVREpgTimeIndex index;
+  index.Reserve(events.size());
+  for (const auto& event : events)
+    index.Add(event.first, event.second);
+  index.Finalize();
+  return index;
+}
+} // unnamed namespace
+
+TEST(TestEpgTimeIndex, Empty)
+{
+  const CPVREpgTimeIndex index = CreateIndex({});
+
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_EQ(index.GetLastEnd(), 0);
+  EXPECT_FALSE(index.HasStart(0));
+  EXPECT_FALSE(index.HasEventsBetween(0, 1000));
+  EXPECT_FALSE(index.GetMaxEndTime(1000).first);
+  EXPECT_FALSE(index.GetMinStartTime(0).first);
+}
+
+TEST(TestEpgTimeIndex, Boundaries)
+{
+  const CPVREpgTimeIndex index = CreateIndex({{100, 200}, {200, 300}, {400, 500}});
+
+  EXPECT_EQ(index.Size(), 3u);
+  EXPECT_EQ(index.GetLastEnd(), 500);
+
+  EXPECT_TRUE(index.HasStart(200));
+  EXPECT_FALSE(index.HasStart(300));
+
+  EXPECT_TRUE(index.HasEventsBetween(300, 300));
+  EXPECT_FALSE(index.HasEventsBetween(301, 399));
+  EXPECT_TRUE(index.HasEventsBetween(0, 100));
+  EXPECT_FALSE(index.HasEventsBetween(501, 1000));
+
+  EXPECT_EQ(index.GetMaxEndTime(399), std::make_pair(true, time_t(300)));
+  EXPECT_EQ(index.GetMaxEndTime(300), std::make_pair(true, time_t(300)));
+  EXPECT_FALSE(index.GetMaxEndTime(199).first);
+
+  EXPECT_EQ(index.GetMinStartTime(300), std::make_pair(true, time_t(400)));
+  EXPECT_EQ(index.GetMinStartTime(99), std::make_pair(true, time_t(100)));
+  EXPECT_FALSE(index.GetMinStartTime(400).first);
+}
+
+TEST(TestEpgTimeIndex, Overlapping)
+{
+  // a long event spanning shorter ones
+  const CPVREpgTimeIndex index = CreateIndex({{0, 1000}, {100, 200}, {300, 400}});
+
+  EXPECT_TRUE(index.HasEventsBetween(500, 600));
+  EXPECT_TRUE(index.HasEventsBetween(1000, 2000));
+  EXPECT_FALSE(index.HasEventsBetween(1001, 2000));
+
+  EXPECT_EQ(index.GetMaxEndTime(999), std::make_pair(true, time_t(400)));
+  EXPECT_EQ(index.GetMaxEndTime(1000), std::make_pair(true, time_t(1000)));
+  EXPECT_EQ(index.GetLastEnd(), 1000);
+}
+
+TEST(TestEpgTimeIndex, Unsorted)
+{
+  const CPVREpgTimeIndex index = CreateIndex({{400, 500}, {100, 200}, {200, 300}});
+
+  EXPECT_TRUE(index.HasStart(100));
+  EXPECT_EQ(index.GetMinStartTime(150), std::make_pair(true, time_t(200)));
+  EXPECT_EQ(index.GetMaxEndTime(450), std::make_pair(true, time_t(300)));
+  EXPECT_FALSE(index.HasEventsBetween(301, 399));
+}
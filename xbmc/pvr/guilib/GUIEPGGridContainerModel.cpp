@@ -36,7 +36,10 @@ void CGUIEPGGridContainerModel::SetInvalid()
   for (const auto& channel : m_channelItems)
     channel->SetInvalid();
   for (const auto& ruler : m_rulerItems)
-    ruler->SetInvalid();
+  {
+    if (ruler)
+      ruler->SetInvalid();
+  }
 }
 
 std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateGapItem(int iChannel) const
@@ -79,6 +82,7 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
   }
 
   m_fBlockSize = fBlockSize;
+  m_iBlocksPerPage = iBlocksPerPage;
 
   ////////////////////////////////////////////////////////////////////////
   // Create channel items
@@ -120,22 +124,10 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
   }
 
   ////////////////////////////////////////////////////////////////////////
-  // Create ruler items
-  CDateTime ruler;
-  ruler.SetFromUTCDateTime(m_gridStart);
-  CDateTime rulerEnd;
-  rulerEnd.SetFromUTCDateTime(m_gridEnd);
-  CFileItemPtr rulerItem(new CFileItem(ruler.GetAsLocalizedDate(true)));
-  rulerItem->SetProperty("DateLabel", true);
-  m_rulerItems.emplace_back(rulerItem);
-
-  const CDateTimeSpan unit(0, 0, iRulerUnit * MINSPERBLOCK, 0);
-  for (; ruler < rulerEnd; ruler += unit)
-  {
-    rulerItem.reset(new CFileItem(ruler.GetAsLocalizedTime("", false)));
-    rulerItem->SetLabel2(ruler.GetAsLocalizedDate(true));
-    m_rulerItems.emplace_back(rulerItem);
-  }
+  // Reserve ruler items. They get created on demand, see GetRulerItem.
+  m_iRulerUnit = iRulerUnit;
+  const int iRulerBlocks = m_blocks - 1; // the last block starts at grid end
+  m_rulerItems.resize(1 + (iRulerBlocks + iRulerUnit - 1) / iRulerUnit);
 
   m_firstActiveChannel = iFirstChannel;
   m_lastActiveChannel = iFirstChannel + iChannelsPerPage - 1;
@@ -218,15 +210,20 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags&
   if (lastBlock < 0)
     lastBlock = 0;
 
+  // fetch a page ahead of the requested block, so that not every scroll step needs a query
+  int firstBlock = iBlock - m_iBlocksPerPage;
+  if (firstBlock < 0)
+    firstBlock = 0;
+
   const auto tags =
-      GetEPGTimeline(iChannel, GetStartTimeForBlock(iBlock), GetStartTimeForBlock(lastBlock));
+      GetEPGTimeline(iChannel, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(lastBlock));
 
   if (epgTags.lastBlock == -1)
     epgTags.lastBlock = lastBlock;
 
   if (tags.empty())
   {
-    epgTags.firstBlock = iBlock;
+    epgTags.firstBlock = firstBlock;
   }
   else
   {
@@ -280,15 +277,20 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& e
   if (firstBlock >= GetLastBlock())
     firstBlock = GetLastBlock();
 
+  // fetch a page ahead of the requested block, so that not every scroll step needs a query
+  int lastBlock = iBlock + m_iBlocksPerPage;
+  if (lastBlock > GetLastBlock())
+    lastBlock = GetLastBlock();
+
   const auto tags =
-      GetEPGTimeline(iChannel, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(iBlock));
+      GetEPGTimeline(iChannel, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(lastBlock));
 
   if (epgTags.firstBlock == -1)
     epgTags.firstBlock = firstBlock;
 
   if (tags.empty())
   {
-    epgTags.lastBlock = iBlock;
+    epgTags.lastBlock = lastBlock;
   }
   else
   {
@@ -512,68 +514,78 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
   // clear the grid. it will be recreated on-demand.
   m_gridIndex.clear();
 
-  bool newChannels = false;
-
-  if (channelsChanged)
+  // Keep the epg tags of active channels, as far as they are within the active blocks plus a
+  // page of prefetch margin. Everything else gets purged. Missing tags get fetched on demand,
+  // in chunks of a page, while scrolling.
+  const int minBlock = firstBlock - m_iBlocksPerPage;
+  const int maxBlock = lastBlock + m_iBlocksPerPage;
+  for (auto it = m_epgItems.begin(); it != m_epgItems.end();)
   {
-    // purge epg tags for inactive channels
-    for (auto it = m_epgItems.begin(); it != m_epgItems.end();)
+    if ((*it).first < firstChannel || (*it).first > lastChannel ||
+        (blocksChanged && !TrimEpgTags((*it).second, minBlock, maxBlock)))
     {
-      if ((*it).first < firstChannel || (*it).first > lastChannel)
-      {
-        it = m_epgItems.erase(it);
-        continue; // next channel
-      }
-      ++it;
+      it = m_epgItems.erase(it);
+      continue; // next channel
     }
-
-    newChannels = (firstChannel < m_firstActiveChannel) || (lastChannel > m_lastActiveChannel);
+    ++it;
   }
 
-  if (blocksChanged || newChannels)
-  {
-    // clear and refetch epg tags for active channels
-    const CDateTime maxEnd = GetStartTimeForBlock(firstBlock);
-    const CDateTime minStart = GetStartTimeForBlock(lastBlock);
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
-    for (int i = firstChannel; i <= lastChannel; ++i)
-    {
-      auto it = m_epgItems.find(i);
-      if (it == m_epgItems.end())
-        it = m_epgItems.insert({i, EpgTags()}).first;
+  m_firstActiveChannel = firstChannel;
+  m_lastActiveChannel = lastChannel;
+  m_firstActiveBlock = firstBlock;
+  m_lastActiveBlock = lastBlock;
 
-      if (blocksChanged || i < m_firstActiveChannel || i > m_lastActiveChannel)
-      {
-        EpgTags& epgTags = (*it).second;
+  return true;
+}
 
-        (*it).second.tags.clear();
+bool CGUIEPGGridContainerModel::TrimEpgTags(EpgTags& epgTags, int minBlock, int maxBlock) const
+{
+  auto& tags = epgTags.tags;
 
-        tags = GetEPGTimeline(i, maxEnd, minStart);
-        const int firstResultBlock = GetFirstEventBlock(tags.front());
-        const int lastResultBlock = GetLastEventBlock(tags.back());
-        if (firstResultBlock > lastResultBlock)
-          continue;
+  const auto first = std::find_if(tags.begin(), tags.end(), [this, minBlock](const auto& item) {
+    return GetLastEventBlock(item->GetEPGInfoTag()) >= minBlock;
+  });
+  if (first != tags.begin())
+  {
+    tags.erase(tags.begin(), first);
+    if (!tags.empty())
+      epgTags.firstBlock = GetFirstEventBlock(tags.front()->GetEPGInfoTag());
+  }
 
-        epgTags.firstBlock = firstResultBlock;
-        epgTags.lastBlock = lastResultBlock;
+  const auto last = std::find_if(tags.begin(), tags.end(), [this, maxBlock](const auto& item) {
+    return GetFirstEventBlock(item->GetEPGInfoTag()) > maxBlock;
+  });
+  if (last != tags.end())
+  {
+    tags.erase(last, tags.end());
+    if (!tags.empty())
+      epgTags.lastBlock = GetLastEventBlock(tags.back()->GetEPGInfoTag());
+  }
 
-        for (const auto& tag : tags)
-        {
-          if (GetFirstEventBlock(tag) > GetLastEventBlock(tag))
-            continue;
+  return !tags.empty();
+}
 
-          epgTags.tags.emplace_back(std::make_shared<CFileItem>(tag));
-        }
-      }
+std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetRulerItem(int iIndex) const
+{
+  std::shared_ptr<CFileItem>& rulerItem = m_rulerItems[iIndex];
+  if (!rulerItem)
+  {
+    CDateTime ruler;
+    if (iIndex == 0)
+    {
+      ruler.SetFromUTCDateTime(m_gridStart);
+      rulerItem = std::make_shared<CFileItem>(ruler.GetAsLocalizedDate(true));
+      rulerItem->SetProperty("DateLabel", true);
+    }
+    else
+    {
+      ruler.SetFromUTCDateTime(m_gridStart +
+                               CDateTimeSpan(0, 0, (iIndex - 1) * m_iRulerUnit * MINSPERBLOCK, 0));
+      rulerItem = std::make_shared<CFileItem>(ruler.GetAsLocalizedTime("", false));
+      rulerItem->SetLabel2(ruler.GetAsLocalizedDate(true));
     }
   }
-
-  m_firstActiveChannel = firstChannel;
-  m_lastActiveChannel = lastChannel;
-  m_firstActiveBlock = firstBlock;
-  m_lastActiveBlock = lastBlock;
-
-  return true;
+  return rulerItem;
 }
 
 void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
@@ -582,9 +594,9 @@ void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
   {
     // remove before keepStart and after keepEnd
     for (int i = 1; i < keepStart && i < RulerItemsSize(); ++i)
-      m_rulerItems[i]->FreeMemory();
+      m_rulerItems[i].reset();
     for (int i = keepEnd + 1; i < RulerItemsSize(); ++i)
-      m_rulerItems[i]->FreeMemory();
+      m_rulerItems[i].reset();
   }
   else
   {
@@ -594,7 +606,7 @@ void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
       if (i == 0)
         continue;
 
-      m_rulerItems[i]->FreeMemory();
+      m_rulerItems[i].reset();
     }
   }
 }
@@ -39,6 +39,10 @@ protected:
   std::string GetDirectoryPath() override;
   void OnPrepareFileItems(CFileItemList& items) override;
   bool GetFilteredItems(const std::string& filter, CFileItemList& items) override;
+  void OnViewportChanged(const std::vector<CFileItemPtr>& items) override
+  {
+    m_thumbLoader.SetPriorityItems(items);
+  }
 
   bool m_bShowDeletedRecordings{false};
 
@@ -184,6 +184,8 @@ void CAdvancedSettings::Initialize()
   m_slideshowPanAmount = 2.5f;
   m_slideshowZoomAmount = 5.0f;
   m_slideshowBlackBarCompensation = 20.0f;
+  m_slideshowPreloadCount = 3;
+  m_slideshowPreloadMemory = 256;
 
   m_songInfoDuration = 10;
 
@@ -285,6 +287,8 @@ void CAdvancedSettings::Initialize()
   m_imageRes = 720;
   m_imageScalingAlgorithm = CPictureScalingAlgorithm::Default;
   m_imageQualityJpeg = 4;
+  m_useDDSThumbnails = false;
+  m_thumbnailCacheSize = 0;
 
   m_sambaclienttimeout = 30;
   m_sambadoscodepage = "";
@@ -408,6 +412,7 @@ void CAdvancedSettings::Initialize()
 
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
+  m_jsonAnnouncementWindow = 100;
 
   m_enableMultimediaKeys = false;
 
@@ -415,6 +420,8 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiTextureAtlas = true;
+  m_guiFontCacheSize = 8;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -834,6 +841,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "panamount", m_slideshowPanAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "zoomamount", m_slideshowZoomAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "blackbarcompensation", m_slideshowBlackBarCompensation, 0.0f, 50.0f);
+    XMLUtils::GetInt(pElement, "preloadcount", m_slideshowPreloadCount, 0, 20);
+    XMLUtils::GetInt(pElement, "preloadmemory", m_slideshowPreloadMemory, 0, 4096);
   }
 
   pElement = pRootElement->FirstChildElement("network");
@@ -862,6 +871,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   {
     XMLUtils::GetBoolean(pElement, "compactoutput", m_jsonOutputCompact);
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
+    XMLUtils::GetUInt(pElement, "announcementwindow", m_jsonAnnouncementWindow, 0, 10000);
   }
 
   pElement = pRootElement->FirstChildElement("samba");
@@ -1067,6 +1077,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (XMLUtils::GetString(pRootElement, "imagescalingalgorithm", tmp))
     m_imageScalingAlgorithm = CPictureScalingAlgorithm::FromString(tmp);
   XMLUtils::GetUInt(pRootElement, "imagequalityjpeg", m_imageQualityJpeg, 0, 21);
+  XMLUtils::GetBoolean(pRootElement, "useddsthumbnails", m_useDDSThumbnails);
+  XMLUtils::GetUInt(pRootElement, "thumbnailcachesize", m_thumbnailCacheSize);
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
   XMLUtils::GetBoolean(pRootElement, "uselocalecollation", m_useLocaleCollation);
   XMLUtils::GetBoolean(pRootElement, "detectasudf", m_detectAsUdf);
@@ -1224,6 +1236,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "textureatlas", m_guiTextureAtlas);
+    XMLUtils::GetUInt(pElement, "fontcachesize", m_guiFontCacheSize, 1, 256);
   }
 
   std::string seekSteps;
@@ -180,6 +180,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_slideshowBlackBarCompensation;
     float m_slideshowZoomAmount;
     float m_slideshowPanAmount;
+    int m_slideshowPreloadCount;
+    int m_slideshowPreloadMemory;
 
     int m_songInfoDuration;
     int m_logLevel;
@@ -231,6 +233,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
     unsigned int
         m_imageQualityJpeg; ///< \brief the stored jpeg quality the lower the better (default: 4)
+    bool m_useDDSThumbnails; ///< \brief keep decoded .dds versions of cached images for faster loading
+    unsigned int m_thumbnailCacheSize; ///< \brief maximum size of the image cache in MiB, 0 for unlimited
 
     int m_sambaclienttimeout;
     std::string m_sambadoscodepage;
@@ -333,6 +337,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiTextureAtlas; ///< pack the small textures of the skin into shared textures
+    unsigned int m_guiFontCacheSize; ///< memory for the vertices cached by all fonts in MB
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
@@ -342,6 +348,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
+    unsigned int m_jsonAnnouncementWindow; //!< ms to coalesce library announcements
 
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
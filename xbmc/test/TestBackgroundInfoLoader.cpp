@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BackgroundInfoLoader.h"
+#include "FileItem.h"
+#include "threads/Event.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+class CTestLoader : public CBackgroundInfoLoader
+{
+public:
+  bool LoadItemCached(CFileItem* pItem) override
+  {
+    if (m_blockFirst)
+    {
+      m_blockFirst = false;
+      m_started.Set();
+      m_continue.Wait();
+    }
+    return Record(pItem, "cached");
+  }
+
+  bool LoadItemLookup(CFileItem* pItem) override { return Record(pItem, "lookup"); }
+
+  bool Record(const CFileItem* pItem, const std::string& stage)
+  {
+    std::unique_lock<CCriticalSection> lock(m_lock);
+    m_loaded.push_back(stage + ":" + pItem->GetPath());
+    return false;
+  }
+
+  void WaitForLoader()
+  {
+    while (IsLoading())
+      std::this_thread::sleep_for(1ms);
+  }
+
+  bool m_blockFirst = false;
+  CEvent m_started;
+  CEvent m_continue;
+  std::vector<std::string> m_loaded;
+};
+
+void CreateItems(CFileItemList& items, int count)
+{
+  for (int i = 0; i < count; i++)
+    items.Add(std::make_shared<CFileItem>(std::to_string(i), false));
+}
+} // unnamed namespace
+
+TEST(TestBackgroundInfoLoader, ListOrder)
+{
+  CFileItemList items;
+  CreateItems(items, 3);
+
+  CTestLoader loader;
+  loader.Load(items);
+  loader.WaitForLoader();
+
+  const std::vector<std::string> expected = {"cached:0", "cached:1", "cached:2",
+                                             "lookup:0", "lookup:1", "lookup:2"};
+  EXPECT_EQ(loader.m_loaded, expected);
+}
+
+TEST(TestBackgroundInfoLoader, PriorityItemsFirst)
+{
+  CFileItemList items;
+  CreateItems(items, 4);
+
+  CTestLoader loader;
+  loader.SetPriorityItems({items[2], items[3]});
+  loader.Load(items);
+  loader.WaitForLoader();
+
+  const std::vector<std::string> expected = {"cached:2", "cached:3", "lookup:2", "lookup:3",
+                                             "cached:0", "cached:1", "lookup:0", "lookup:1"};
+  EXPECT_EQ(loader.m_loaded, expected);
+}
+
+TEST(TestBackgroundInfoLoader, PriorityItemsReplaced)
+{
+  CFileItemList items;
+  CreateItems(items, 4);
+
+  CTestLoader loader;
+  loader.m_blockFirst = true;
+  loader.SetPriorityItems({items[0], items[1]});
+  loader.Load(items);
+
+  // scroll away while the first item is loading, item 1 is no longer shown
+  ASSERT_TRUE(loader.m_started.Wait(5s));
+  loader.SetPriorityItems({items[3]});
+  loader.m_continue.Set();
+  loader.WaitForLoader();
+
+  const std::vector<std::string> expected = {"cached:0", "cached:3", "lookup:3", "cached:1",
+                                             "cached:2", "lookup:0", "lookup:1", "lookup:2"};
+  EXPECT_EQ(loader.m_loaded, expected);
+}
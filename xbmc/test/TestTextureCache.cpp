@@ -0,0 +1,295 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureCache.h"
+#include "TextureDatabase.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class TestTextureCacheHelper
+{
+public:
+  explicit TestTextureCacheHelper(CTextureCache& cache) : m_cache(cache) {}
+
+  bool Connect(const DatabaseSettings& settings)
+  {
+    return m_cache.m_database.Connect(settings.name, settings, true);
+  }
+
+  void LoadIndex(unsigned int pageSize = 1000) { m_cache.LoadIndex(pageSize); }
+  bool IsIndexLoaded() const { return m_cache.m_indexLoaded; }
+
+  // looks the image up the same way the texture cache does, i.e. in the index once it is loaded
+  bool GetCachedTexture(const std::string& url, CTextureDetails& details)
+  {
+    return m_cache.GetCachedTexture(url, details);
+  }
+
+  bool GetDatabaseTexture(const std::string& url, CTextureDetails& details)
+  {
+    std::unique_lock<CCriticalSection> lock(m_cache.m_databaseSection);
+    return m_cache.m_database.GetCachedTexture(url, details);
+  }
+
+  bool SetCachedTextureValid(const std::string& url, bool updateable)
+  {
+    return m_cache.SetCachedTextureValid(url, updateable);
+  }
+
+  bool ClearCachedTexture(const std::string& url)
+  {
+    std::string cacheFile;
+    return m_cache.ClearCachedTexture(url, cacheFile);
+  }
+
+  bool ClearCachedTexture(int id)
+  {
+    std::string cacheFile;
+    return m_cache.ClearCachedTexture(id, cacheFile);
+  }
+
+  std::vector<CTextureUsage> GetTextureUsage()
+  {
+    std::vector<CTextureUsage> textures;
+    EXPECT_TRUE(m_cache.GetTextureUsage(textures));
+    return textures;
+  }
+
+  void SetCachedImageSizes(const std::vector<CTextureUsage>& textures)
+  {
+    m_cache.SetCachedImageSizes(textures);
+  }
+
+  void Execute(const std::string& sql)
+  {
+    std::unique_lock<CCriticalSection> lock(m_cache.m_databaseSection);
+    m_cache.m_database.ExecuteQuery(sql);
+  }
+
+private:
+  CTextureCache& m_cache;
+};
+
+class TestTextureCache : public testing::Test
+{
+protected:
+  TestTextureCache() : m_helper(m_cache) {}
+
+  void SetUp() override
+  {
+    m_settings.type = "sqlite3";
+    m_settings.name = "texturecachetest";
+    m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db");
+
+    ASSERT_TRUE(m_helper.Connect(m_settings));
+  }
+
+  void TearDown() override
+  {
+    m_cache.Deinitialize();
+    XFILE::CFile::Delete(m_settings.host + m_settings.name + ".db");
+  }
+
+  CTextureDetails AddTexture(const std::string& url)
+  {
+    CTextureDetails details;
+    details.file = CTextureCache::GetCacheFile(url) + ".jpg";
+    details.hash = "hash of " + url;
+    details.width = 640;
+    details.height = 480;
+    details.updateable = true;
+    EXPECT_TRUE(m_cache.AddCachedTexture(url, details));
+    return details;
+  }
+
+  // the index and the database have to agree on every image
+  void ExpectCoherent(const std::vector<std::string>& urls)
+  {
+    ASSERT_TRUE(m_helper.IsIndexLoaded());
+    for (const std::string& url : urls)
+    {
+      CTextureDetails indexed;
+      CTextureDetails stored;
+      const bool isIndexed = m_helper.GetCachedTexture(url, indexed);
+      const bool isStored = m_helper.GetDatabaseTexture(url, stored);
+      EXPECT_EQ(isStored, isIndexed) << url;
+      if (!isIndexed || !isStored)
+        continue;
+
+      EXPECT_EQ(stored.id, indexed.id) << url;
+      EXPECT_EQ(stored.file, indexed.file) << url;
+      EXPECT_EQ(stored.hash, indexed.hash) << url;
+      EXPECT_EQ(stored.width, indexed.width) << url;
+      EXPECT_EQ(stored.height, indexed.height) << url;
+      EXPECT_EQ(stored.updateable, indexed.updateable) << url;
+    }
+  }
+
+  DatabaseSettings m_settings;
+  CTextureCache m_cache;
+  TestTextureCacheHelper m_helper;
+};
+
+TEST_F(TestTextureCache, LoadIndex)
+{
+  AddTexture("http://example.com/a.jpg");
+  AddTexture("http://example.com/b.jpg");
+  EXPECT_FALSE(m_helper.IsIndexLoaded());
+
+  m_helper.LoadIndex();
+  ExpectCoherent({"http://example.com/a.jpg", "http://example.com/b.jpg", "http://example.com/c.jpg"});
+}
+
+TEST_F(TestTextureCache, LoadIndexInPages)
+{
+  const std::vector<std::string> urls = {"http://example.com/a.jpg", "http://example.com/b.jpg",
+                                         "http://example.com/c.jpg", "http://example.com/d.jpg",
+                                         "http://example.com/e.jpg"};
+  for (const std::string& url : urls)
+    AddTexture(url);
+
+  m_helper.LoadIndex(2);
+  ExpectCoherent(urls);
+
+  // the loaded textures can be found by id
+  CTextureDetails details;
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/e.jpg", details));
+  EXPECT_TRUE(m_helper.ClearCachedTexture(details.id));
+  ExpectCoherent(urls);
+  EXPECT_FALSE(m_cache.HasCachedImage("http://example.com/e.jpg"));
+}
+
+TEST_F(TestTextureCache, AddCachedTexture)
+{
+  m_helper.LoadIndex();
+  const CTextureDetails details = AddTexture("http://example.com/a.jpg");
+  ExpectCoherent({"http://example.com/a.jpg"});
+
+  CTextureDetails indexed;
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/a.jpg", indexed));
+  EXPECT_EQ(details.file, indexed.file);
+  EXPECT_LT(0, indexed.id);
+
+  // adding it again replaces the texture
+  AddTexture("http://example.com/a.jpg");
+  ExpectCoherent({"http://example.com/a.jpg"});
+}
+
+TEST_F(TestTextureCache, SetCachedTextureValid)
+{
+  m_helper.LoadIndex();
+  AddTexture("http://example.com/a.jpg");
+  AddTexture("http://example.com/b.jpg");
+
+  EXPECT_TRUE(m_helper.SetCachedTextureValid("http://example.com/a.jpg", false));
+  ExpectCoherent({"http://example.com/a.jpg", "http://example.com/b.jpg"});
+
+  CTextureDetails indexed;
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/a.jpg", indexed));
+  EXPECT_FALSE(indexed.updateable);
+}
+
+TEST_F(TestTextureCache, ClearCachedTextureByUrl)
+{
+  m_helper.LoadIndex();
+  AddTexture("http://example.com/a.jpg");
+  AddTexture("http://example.com/b.jpg");
+
+  EXPECT_TRUE(m_helper.ClearCachedTexture("http://example.com/a.jpg"));
+  ExpectCoherent({"http://example.com/a.jpg", "http://example.com/b.jpg"});
+  EXPECT_FALSE(m_cache.HasCachedImage("http://example.com/a.jpg"));
+  EXPECT_TRUE(m_cache.HasCachedImage("http://example.com/b.jpg"));
+}
+
+TEST_F(TestTextureCache, ClearCachedTextureById)
+{
+  m_helper.LoadIndex();
+  AddTexture("http://example.com/a.jpg");
+  AddTexture("http://example.com/b.jpg");
+
+  CTextureDetails details;
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/b.jpg", details));
+  EXPECT_TRUE(m_helper.ClearCachedTexture(details.id));
+  ExpectCoherent({"http://example.com/a.jpg", "http://example.com/b.jpg"});
+  EXPECT_TRUE(m_cache.HasCachedImage("http://example.com/a.jpg"));
+  EXPECT_FALSE(m_cache.HasCachedImage("http://example.com/b.jpg"));
+}
+
+TEST_F(TestTextureCache, InvalidateCachedImage)
+{
+  m_helper.LoadIndex();
+  AddTexture("http://example.com/a.jpg");
+
+  // the hash of a texture is only handed out once it is due for a check
+  CTextureDetails details;
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/a.jpg", details));
+  EXPECT_TRUE(details.hash.empty());
+
+  m_cache.InvalidateCachedImage("http://example.com/a.jpg");
+  ExpectCoherent({"http://example.com/a.jpg"});
+
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/a.jpg", details));
+  EXPECT_EQ("hash of http://example.com/a.jpg", details.hash);
+}
+
+TEST_F(TestTextureCache, InvalidateCachedImages)
+{
+  m_helper.LoadIndex();
+  AddTexture("http://example.com/a.jpg");
+  AddTexture("http://example.com/b.jpg");
+  AddTexture("http://example.com/c.jpg");
+
+  // images that aren't cached are skipped
+  m_cache.InvalidateCachedImages(
+      {"http://example.com/a.jpg", "", "http://example.com/d.jpg", "http://example.com/c.jpg"});
+  ExpectCoherent({"http://example.com/a.jpg", "http://example.com/b.jpg", "http://example.com/c.jpg",
+                  "http://example.com/d.jpg"});
+
+  CTextureDetails details;
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/a.jpg", details));
+  EXPECT_FALSE(details.hash.empty());
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/b.jpg", details));
+  EXPECT_TRUE(details.hash.empty());
+  ASSERT_TRUE(m_helper.GetCachedTexture("http://example.com/c.jpg", details));
+  EXPECT_FALSE(details.hash.empty());
+}
+
+TEST_F(TestTextureCache, FileSizes)
+{
+  // the cached files don't exist
+  AddTexture("http://example.com/a.jpg");
+  AddTexture("http://example.com/b.jpg");
+
+  std::vector<CTextureUsage> textures = m_helper.GetTextureUsage();
+  ASSERT_EQ(2u, textures.size());
+  EXPECT_EQ(0, textures[0].size);
+  EXPECT_EQ(0, textures[1].size);
+
+  textures[0].size = 1000;
+  m_helper.SetCachedImageSizes({textures[0]});
+  textures = m_helper.GetTextureUsage();
+  ASSERT_EQ(2u, textures.size());
+  EXPECT_EQ(1000, textures[0].size + textures[1].size);
+
+  // without a size limit the statistics take the size from the database
+  EXPECT_EQ(1000u, m_cache.GetStatistics().size);
+
+  // as if cached before the sizes were stored
+  m_helper.Execute("UPDATE texture SET filesize=NULL");
+  for (const CTextureUsage& texture : m_helper.GetTextureUsage())
+    EXPECT_EQ(-1, texture.size);
+  EXPECT_EQ(0u, m_cache.GetStatistics().size);
+}
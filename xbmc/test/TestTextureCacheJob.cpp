@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureCacheJob.h"
+#include "TextureDatabase.h"
+#include "XBDateTime.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const CDateTime now(2023, 6, 1, 12, 0, 0);
+
+CTextureUsage CreateUsage(int daysSinceLastUse, unsigned int useCount)
+{
+  CTextureUsage texture;
+  texture.useCount = useCount;
+  if (daysSinceLastUse >= 0)
+    texture.lastUsed = now - CDateTimeSpan(daysSinceLastUse, 0, 0, 0);
+  return texture;
+}
+} // unnamed namespace
+
+TEST(TestTextureCacheJob, NoEvictionWithinLimit)
+{
+  const std::vector<CTextureUsage> textures{CreateUsage(10, 1), CreateUsage(20, 1)};
+  const std::vector<uint64_t> sizes{500, 500};
+
+  EXPECT_TRUE(CTextureCacheMaintenanceJob::SelectEvictions(textures, sizes, 1000, now).empty());
+  // no limit
+  EXPECT_TRUE(CTextureCacheMaintenanceJob::SelectEvictions(textures, sizes, 0, now).empty());
+}
+
+TEST(TestTextureCacheJob, EvictsOldestBelowNinetyPercent)
+{
+  std::vector<CTextureUsage> textures;
+  for (int i = 0; i < 10; i++)
+    textures.push_back(CreateUsage(i + 1, 1));
+  const std::vector<uint64_t> sizes(textures.size(), 100);
+
+  // 1000 bytes with a limit of 800 must go down to 720 bytes or less
+  const std::vector<size_t> expected{9, 8, 7};
+  EXPECT_EQ(expected, CTextureCacheMaintenanceJob::SelectEvictions(textures, sizes, 800, now));
+}
+
+TEST(TestTextureCacheJob, EvictsLeastUsed)
+{
+  const std::vector<CTextureUsage> textures{CreateUsage(10, 100), CreateUsage(10, 0),
+                                            CreateUsage(10, 5)};
+  const std::vector<uint64_t> sizes(textures.size(), 100);
+
+  const std::vector<size_t> expected{1, 2};
+  EXPECT_EQ(expected, CTextureCacheMaintenanceJob::SelectEvictions(textures, sizes, 150, now));
+}
+
+TEST(TestTextureCacheJob, UseCountWeighsAge)
+{
+  // an image used once two days ago goes before one used very often ten days ago
+  const std::vector<CTextureUsage> textures{CreateUsage(10, 1000), CreateUsage(2, 0)};
+  const std::vector<uint64_t> sizes(textures.size(), 100);
+
+  const std::vector<size_t> expected{1};
+  EXPECT_EQ(expected, CTextureCacheMaintenanceJob::SelectEvictions(textures, sizes, 150, now));
+}
+
+TEST(TestTextureCacheJob, EvictsNeverUsedFirst)
+{
+  const std::vector<CTextureUsage> textures{CreateUsage(365, 0), CreateUsage(-1, 0),
+                                            CreateUsage(1, 0)};
+  const std::vector<uint64_t> sizes{100, 10, 100};
+
+  // the never used image alone doesn't free enough space
+  const std::vector<size_t> expected{1, 0};
+  EXPECT_EQ(expected, CTextureCacheMaintenanceJob::SelectEvictions(textures, sizes, 150, now));
+}
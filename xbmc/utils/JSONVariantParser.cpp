@@ -8,6 +8,10 @@
 
 #include "JSONVariantParser.h"
 
+#include <cassert>
+#include <utility>
+#include <vector>
+
 #include <rapidjson/reader.h>
 
 class CJSONVariantParserHandler
@@ -34,40 +38,29 @@ private:
   template <typename... TArgs>
   bool Primitive(TArgs... args)
   {
-    PushObject(CVariant(std::forward<TArgs>(args)...));
-    PopObject();
+    Add(CVariant(std::forward<TArgs>(args)...));
 
     return true;
   }
 
-  void PushObject(CVariant variant);
-  void PopObject();
+  CVariant& Add(CVariant&& variant);
+  void PopContainer();
 
   CVariant& m_parsedObject;
-  std::vector<CVariant *> m_parse;
+  std::vector<CVariant*> m_parse; // the currently open objects and arrays
   std::string m_key;
   CVariant m_root;
-
-  enum class PARSE_STATUS
-  {
-    Variable,
-    Array,
-    Object
-  };
-  PARSE_STATUS m_status;
 };
 
 CJSONVariantParserHandler::CJSONVariantParserHandler(CVariant& parsedObject)
-  : m_parsedObject(parsedObject),
-    m_parse(),
-    m_key(),
-    m_status(PARSE_STATUS::Variable)
-{ }
+  : m_parsedObject(parsedObject)
+{
+  m_parse.reserve(16);
+}
 
 bool CJSONVariantParserHandler::Null()
 {
-  PushObject(CVariant::ConstNullVariant);
-  PopObject();
+  Add(CVariant::VariantTypeConstNull);
 
   return true;
 }
@@ -114,89 +107,73 @@ bool CJSONVariantParserHandler::String(const char* str, rapidjson::SizeType leng
 
 bool CJSONVariantParserHandler::StartObject()
 {
-  PushObject(CVariant::VariantTypeObject);
+  m_parse.push_back(&Add(CVariant::VariantTypeObject));
 
   return true;
 }
 
 bool CJSONVariantParserHandler::Key(const char* str, rapidjson::SizeType length, bool copy)
 {
-  m_key = std::string(str, 0, length);
+  // reuses the key's buffer
+  m_key.assign(str, length);
 
   return true;
 }
 
 bool CJSONVariantParserHandler::EndObject(rapidjson::SizeType memberCount)
 {
-  PopObject();
+  PopContainer();
 
   return true;
 }
 
 bool CJSONVariantParserHandler::StartArray()
 {
-  PushObject(CVariant::VariantTypeArray);
+  m_parse.push_back(&Add(CVariant::VariantTypeArray));
 
   return true;
 }
 
 bool CJSONVariantParserHandler::EndArray(rapidjson::SizeType elementCount)
 {
-  PopObject();
+  PopContainer();
 
   return true;
 }
 
-void CJSONVariantParserHandler::PushObject(CVariant variant)
+CVariant& CJSONVariantParserHandler::Add(CVariant&& variant)
 {
-  const auto variant_type = variant.type();
-
-  if (m_status == PARSE_STATUS::Object)
-  {
-    (*m_parse.back())[m_key] = std::move(variant);
-    m_parse.push_back(&((*m_parse.back())[m_key]));
-  }
-  else if (m_status == PARSE_STATUS::Array)
+  // values are moved straight to their final place in the tree
+  if (m_parse.empty())
   {
-    CVariant *temp = m_parse[m_parse.size() - 1];
-    temp->push_back(std::move(variant));
-    m_parse.push_back(&(*temp)[temp->size() - 1]);
+    m_root = std::move(variant);
+
+    // a scalar is a complete document
+    if (!m_root.isObject() && !m_root.isArray())
+      m_parsedObject = std::move(m_root);
+
+    return m_root;
   }
-  else if (m_parse.empty())
+
+  CVariant& parent = *m_parse.back();
+  if (parent.isObject())
   {
-    m_root = std::move(variant);
-    m_parse.push_back(&m_root);
+    CVariant& member = parent[m_key];
+    member = std::move(variant);
+    return member;
   }
 
-  if (variant_type == CVariant::VariantTypeObject)
-    m_status = PARSE_STATUS::Object;
-  else if (variant_type == CVariant::VariantTypeArray)
-    m_status = PARSE_STATUS::Array;
-  else
-    m_status = PARSE_STATUS::Variable;
+  parent.push_back(std::move(variant));
+  return parent[parent.size() - 1];
 }
 
-void CJSONVariantParserHandler::PopObject()
+void CJSONVariantParserHandler::PopContainer()
 {
   assert(!m_parse.empty());
-  CVariant* variant = m_parse.back();
   m_parse.pop_back();
 
-  if (!m_parse.empty())
-  {
-    variant = m_parse[m_parse.size() - 1];
-    if (variant->isObject())
-      m_status = PARSE_STATUS::Object;
-    else if (variant->isArray())
-      m_status = PARSE_STATUS::Array;
-    else
-      m_status = PARSE_STATUS::Variable;
-  }
-  else
-  {
-    m_parsedObject = *variant;
-    m_status = PARSE_STATUS::Variable;
-  }
+  if (m_parse.empty())
+    m_parsedObject = std::move(m_root);
 }
 
 bool CJSONVariantParser::Parse(const char* json, CVariant& data)
@@ -0,0 +1,214 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "JSONVariantStreamWriter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+// Formats single scalars and keys the same way CJSONVariantWriter does
+class CJSONVariantStreamWriter::CScalarWriter
+{
+public:
+  CScalarWriter() : m_writer(m_buffer) {}
+
+  bool Write(const CVariant& value, std::string& output)
+  {
+    Reset();
+
+    bool result;
+    switch (value.type())
+    {
+      case CVariant::VariantTypeInteger:
+        result = m_writer.Int64(value.asInteger());
+        break;
+
+      case CVariant::VariantTypeUnsignedInteger:
+        result = m_writer.Uint64(value.asUnsignedInteger());
+        break;
+
+      case CVariant::VariantTypeDouble:
+        result = m_writer.Double(value.asDouble());
+        break;
+
+      case CVariant::VariantTypeBoolean:
+        result = m_writer.Bool(value.asBoolean());
+        break;
+
+      case CVariant::VariantTypeString:
+        result = m_writer.String(value.c_str(), value.size());
+        break;
+
+      case CVariant::VariantTypeConstNull:
+      case CVariant::VariantTypeNull:
+      default:
+        result = m_writer.Null();
+        break;
+    }
+
+    if (result)
+      output.append(m_buffer.GetString(), m_buffer.GetSize());
+
+    return result;
+  }
+
+  bool WriteKey(const std::string& key, std::string& output)
+  {
+    Reset();
+
+    if (!m_writer.String(key.c_str()))
+      return false;
+
+    output.append(m_buffer.GetString(), m_buffer.GetSize());
+    return true;
+  }
+
+private:
+  void Reset()
+  {
+    m_buffer.Clear();
+    m_writer.Reset(m_buffer);
+  }
+
+  rapidjson::StringBuffer m_buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> m_writer;
+};
+
+CJSONVariantStreamWriter::CJSONVariantStreamWriter(const CVariant& value, bool compact)
+  : m_scalarWriter(std::make_unique<CScalarWriter>()), m_compact(compact)
+{
+  if (!WriteValue(value))
+    m_failed = true;
+}
+
+CJSONVariantStreamWriter::~CJSONVariantStreamWriter() = default;
+
+size_t CJSONVariantStreamWriter::Read(char* buffer, size_t size)
+{
+  // serialize until there is enough to fill the buffer or nothing is left
+  while (m_pending.size() < size && Next())
+    ;
+
+  if (m_failed)
+    return 0;
+
+  const size_t length = std::min(size, m_pending.size());
+  std::memcpy(buffer, m_pending.data(), length);
+  m_pending.erase(0, length);
+
+  return length;
+}
+
+bool CJSONVariantStreamWriter::ReadAll(std::string& output)
+{
+  while (Next())
+    ;
+
+  if (m_failed)
+    return false;
+
+  output.append(m_pending);
+  m_pending.clear();
+  return true;
+}
+
+bool CJSONVariantStreamWriter::Next()
+{
+  if (m_failed || m_stack.empty())
+    return false;
+
+  // note: WriteValue may push to the stack, so don't use frame after calling it
+  Frame& frame = m_stack.back();
+  const bool first = frame.first;
+
+  if (frame.value->isArray())
+  {
+    if (frame.itArray == frame.value->end_array())
+    {
+      WriteSuffix(frame);
+      m_stack.pop_back();
+      return true;
+    }
+
+    const CVariant& value = *frame.itArray++;
+    frame.first = false;
+
+    WritePrefix(first);
+    if (!WriteValue(value))
+      m_failed = true;
+  }
+  else
+  {
+    if (frame.itMap == frame.value->end_map())
+    {
+      WriteSuffix(frame);
+      m_stack.pop_back();
+      return true;
+    }
+
+    const auto& entry = *frame.itMap++;
+    frame.first = false;
+
+    WritePrefix(first);
+    if (!m_scalarWriter->WriteKey(entry.first, m_pending))
+      m_failed = true;
+    else
+    {
+      m_pending.append(m_compact ? ":" : ": ");
+      if (!WriteValue(entry.second))
+        m_failed = true;
+    }
+  }
+
+  return !m_failed;
+}
+
+bool CJSONVariantStreamWriter::WriteValue(const CVariant& value)
+{
+  if (value.isArray())
+  {
+    m_pending.push_back('[');
+    m_stack.push_back({&value, value.begin_array(), {}});
+    return true;
+  }
+  else if (value.isObject())
+  {
+    m_pending.push_back('{');
+    m_stack.push_back({&value, {}, value.begin_map()});
+    return true;
+  }
+
+  return m_scalarWriter->Write(value, m_pending);
+}
+
+void CJSONVariantStreamWriter::WritePrefix(bool first)
+{
+  if (!first)
+    m_pending.push_back(',');
+
+  if (!m_compact)
+  {
+    m_pending.push_back('\n');
+    m_pending.append(m_stack.size(), '\t');
+  }
+}
+
+void CJSONVariantStreamWriter::WriteSuffix(const Frame& frame)
+{
+  // like rapidjson's PrettyWriter, empty containers stay on one line
+  if (!m_compact && !frame.first)
+  {
+    m_pending.push_back('\n');
+    m_pending.append(m_stack.size() - 1, '\t');
+  }
+
+  m_pending.push_back(frame.value->isArray() ? ']' : '}');
+}
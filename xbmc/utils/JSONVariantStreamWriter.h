@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/Variant.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Serializes a CVariant to JSON piece by piece.
+ *
+ * Produces the same output as CJSONVariantWriter, but hands it out in chunks of
+ * the caller's choice instead of building the whole document in one string. This
+ * allows to send large responses while serializing them, keeping only a small
+ * buffer in memory. The given value must outlive the writer and must not be
+ * modified while writing.
+ */
+class CJSONVariantStreamWriter
+{
+public:
+  CJSONVariantStreamWriter(const CVariant& value, bool compact);
+  ~CJSONVariantStreamWriter();
+
+  /*!
+   * \brief Serialize the next part of the value.
+   * \param buffer The buffer to write to
+   * \param size The size of the buffer
+   * \return The number of bytes written, 0 if everything has been written or an error occurred
+   */
+  size_t Read(char* buffer, size_t size);
+
+  /*!
+   * \brief Serialize the whole remaining value, appending it to the given string.
+   * \return False if the value could not be serialized, true otherwise
+   */
+  bool ReadAll(std::string& output);
+
+  bool IsDone() const { return m_stack.empty() && m_pending.empty(); }
+  bool HasFailed() const { return m_failed; }
+
+private:
+  struct Frame
+  {
+    const CVariant* value;
+    CVariant::const_iterator_array itArray;
+    CVariant::const_iterator_map itMap;
+    bool first = true;
+  };
+
+  bool Next();
+  bool WriteValue(const CVariant& value);
+  void WritePrefix(bool first);
+  void WriteSuffix(const Frame& frame);
+
+  class CScalarWriter;
+  std::unique_ptr<CScalarWriter> m_scalarWriter;
+
+  bool m_compact;
+  bool m_failed = false;
+  std::vector<Frame> m_stack;
+  std::string m_pending;
+};
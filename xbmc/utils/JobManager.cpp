@@ -96,6 +96,8 @@ void CJobQueue::CancelJob(const CJob *job)
   {
     i->CancelJob();
     m_processing.erase(i);
+    // the cancelled job doesn't report back, hand its place to the next one
+    QueueNextJob();
     return;
   }
   Queue::iterator j = find(m_jobQueue.begin(), m_jobQueue.end(), job);
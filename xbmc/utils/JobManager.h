@@ -124,8 +124,9 @@ public:
   /*!
    \brief Cancel a job in the queue
    Cancels a job in the queue. Any job currently being processed may complete after this
-   call has completed, but OnJobComplete will not be performed. If the job is only queued
-   then it will be removed from the queue and deleted.
+   call has completed, but OnJobComplete will not be performed, and the next job in the queue
+   is started in its place. If the job is only queued then it will be removed from the queue
+   and deleted.
    \param job a pointer to the job to cancel. The job should be subclassed from CJob.
    \sa CJob
    */
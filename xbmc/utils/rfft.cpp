@@ -14,53 +14,64 @@
 #include <math.h>
 
 RFFT::RFFT(int size, bool windowed) :
-  m_size(size), m_windowed(windowed)
+  m_size(size), m_windowed(windowed), m_input(size), m_output(size)
 {
-  m_cfg = kiss_fftr_alloc(m_size,0,nullptr,nullptr);
+  m_cfg = kiss_fft_alloc(m_size,0,nullptr,nullptr);
+
+  if (m_windowed)
+  {
+    m_window.assign(m_size, 1.0f);
+    hann(m_window);
+  }
 }
 
 RFFT::~RFFT()
 {
-  // we don' use kiss_fftr_free here because
+  // we don' use kiss_fft_free here because
   // its hardcoded to free and doesn't pay attention
-  // to SIMD (which might be used during kiss_fftr_alloc
+  // to SIMD (which might be used during kiss_fft_alloc
   //in the C'tor).
   KISS_FFT_FREE(m_cfg);
 }
 
 void RFFT::calc(const float* input, float* output)
 {
-  // temporary buffers
-  std::vector<kiss_fft_scalar> linput(m_size), rinput(m_size);
-  std::vector<kiss_fft_cpx> loutput(m_size), routput(m_size);
-
-  for (size_t i=0;i<m_size;++i)
+  // pack the left channel into the real and the right channel into the
+  // imaginary part, the channels are separated again after the transform
+  if (m_windowed)
   {
-    linput[i] = input[2*i];
-    rinput[i] = input[2*i+1];
+    for (size_t i=0;i<m_size;++i)
+    {
+      m_input[i].r = input[2*i] * m_window[i];
+      m_input[i].i = input[2*i+1] * m_window[i];
+    }
   }
-
-  if (m_windowed)
+  else
   {
-    hann(linput);
-    hann(rinput);
+    for (size_t i=0;i<m_size;++i)
+    {
+      m_input[i].r = input[2*i];
+      m_input[i].i = input[2*i+1];
+    }
   }
 
-  // transform channels
-  kiss_fftr(m_cfg, &linput[0], &loutput[0]);
-  kiss_fftr(m_cfg, &rinput[0], &routput[0]);
+  kiss_fft(m_cfg, m_input.data(), m_output.data());
 
-  auto&& filter = [&](kiss_fft_cpx& data)
-  {
-    return static_cast<double>(sqrt(data.r * data.r + data.i * data.i)) * 2.0 / m_size *
-           (m_windowed ? sqrt(8.0 / 3.0) : 1.0);
-  };
+  // the spectrum of a real signal is conjugate symmetric, so with Z = FFT(l + i*r):
+  // 2*L[k] = Z[k] + conj(Z[N-k]) and 2i*R[k] = Z[k] - conj(Z[N-k])
+  const float scale = static_cast<float>((m_windowed ? sqrt(8.0 / 3.0) : 1.0) / m_size);
 
   // interleave while taking magnitudes and normalizing
   for (size_t i=0;i<m_size/2;++i)
   {
-    output[2*i] = filter(loutput[i]);
-    output[2*i+1] = filter(routput[i]);
+    const kiss_fft_cpx& z = m_output[i];
+    const kiss_fft_cpx& zc = m_output[i ? m_size - i : 0];
+    const float lr = z.r + zc.r;
+    const float li = z.i - zc.i;
+    const float rr = z.i + zc.i;
+    const float ri = zc.r - z.r;
+    output[2*i] = sqrtf(lr * lr + li * li) * scale;
+    output[2*i+1] = sqrtf(rr * rr + ri * ri) * scale;
   }
 }
 
@@ -10,9 +10,11 @@
 
 #include <vector>
 
-#include <kissfft/kiss_fftr.h>
+#include <kissfft/kiss_fft.h>
 
 //! \brief Class performing a RFFT of interleaved stereo data.
+//! \details Both channels are transformed at once by a single complex FFT
+//!          with the left channel as real and the right channel as imaginary part.
 class RFFT
 {
 public:
@@ -25,6 +27,7 @@ public:
   ~RFFT();
 
   //! \brief Calculate FFTs
+  //! \details Not reentrant, the plan's buffers are reused for every call.
   //! \param input Input data of size 2*m_size
   //! \param output Output data of size m_size.
   void calc(const float* input, float* output);
@@ -35,5 +38,8 @@ protected:
 
   size_t m_size;       //!< Size for a single channel.
   bool m_windowed;     //!< Whether or not a Hann window is applied.
-  kiss_fftr_cfg m_cfg; //!< FFT plan
+  kiss_fft_cfg m_cfg;  //!< FFT plan
+  std::vector<kiss_fft_scalar> m_window; //!< Hann window, empty if not windowed.
+  std::vector<kiss_fft_cpx> m_input;     //!< Both channels packed into complex values.
+  std::vector<kiss_fft_cpx> m_output;    //!< Transform of the packed channels.
 };
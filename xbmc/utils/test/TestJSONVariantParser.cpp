@@ -9,6 +9,8 @@
 #include "utils/JSONVariantParser.h"
 #include "utils/Variant.h"
 
+#include <string>
+
 #include <gtest/gtest.h>
 
 TEST(TestJSONVariantParser, CannotParseNullptr)
@@ -187,3 +189,94 @@ TEST(TestJSONVariantParser, CanParseArray)
   ASSERT_TRUE(variant[0]["foo"].isString());
   ASSERT_STREQ("bar", variant[0]["foo"].asString().c_str());
 }
+
+namespace
+{
+std::string CreateRepositoryIndex(int addons)
+{
+  std::string json = "[";
+  for (int i = 0; i < addons; ++i)
+  {
+    if (i > 0)
+      json += ",";
+    const std::string id = "plugin.video.addon" + std::to_string(i);
+    json += "{\"addonid\": \"" + id + "\", \"name\": \"Add-on \\\"" + std::to_string(i) +
+            "\\\"\", \"version\": \"1.2." + std::to_string(i % 100) +
+            "\", \"broken\": false, \"rating\": " + std::to_string(i % 10) +
+            ".5, \"size\": " + std::to_string(4294967296LL + i) +
+            ", \"dependencies\": [{\"addonid\": \"xbmc.python\", \"version\": \"3.0.1\", "
+            "\"optional\": false}, {\"addonid\": \"script.module.requests\", \"optional\": "
+            "true}], \"description\": \"A long description\\nwith \\u00e4 unicode\\tand escapes "
+            "for add-on " +
+            id + "\", \"art\": {}, \"tags\": [], \"fanart\": null}";
+  }
+  json += "]";
+  return json;
+}
+} // unnamed namespace
+
+TEST(TestJSONVariantParser, Conformance)
+{
+  const std::string json =
+      "{\"jsonrpc\": \"2.0\", \"id\": 1, \"method\": \"VideoLibrary.GetMovies\", "
+      "\"params\": {\"properties\": [\"title\", \"year\"], \"limits\": {\"start\": 0, \"end\": "
+      "-1}, \"sort\": {}, \"filter\": null, \"nested\": [[], [[1, 2.5, true]], {\"a\": {\"b\": "
+      "[false]}}], \"escaped\": \"\\\"quoted\\\"\\n\\u00e4\"}}";
+
+  CVariant variant;
+  ASSERT_TRUE(CJSONVariantParser::Parse(json, variant));
+
+  EXPECT_EQ(variant["jsonrpc"].asString(), "2.0");
+  EXPECT_TRUE(variant["id"].isUnsignedInteger());
+  EXPECT_EQ(variant["method"].asString(), "VideoLibrary.GetMovies");
+
+  const CVariant& params = variant["params"];
+  ASSERT_TRUE(params.isObject());
+  EXPECT_EQ(params.size(), 6u);
+  ASSERT_TRUE(params["properties"].isArray());
+  EXPECT_EQ(params["properties"][1].asString(), "year");
+  EXPECT_TRUE(params["limits"]["start"].isUnsignedInteger());
+  EXPECT_TRUE(params["limits"]["end"].isInteger());
+  EXPECT_EQ(params["limits"]["end"].asInteger(), -1);
+  EXPECT_TRUE(params["sort"].isObject());
+  EXPECT_TRUE(params["sort"].empty());
+  EXPECT_TRUE(params["filter"].isNull());
+
+  const CVariant& nested = params["nested"];
+  ASSERT_EQ(nested.size(), 3u);
+  EXPECT_TRUE(nested[0].isArray());
+  EXPECT_TRUE(nested[0].empty());
+  ASSERT_EQ(nested[1][0].size(), 3u);
+  EXPECT_EQ(nested[1][0][0].asUnsignedInteger(), 1u);
+  EXPECT_DOUBLE_EQ(nested[1][0][1].asDouble(), 2.5);
+  EXPECT_TRUE(nested[1][0][2].asBoolean());
+  EXPECT_FALSE(nested[2]["a"]["b"][0].asBoolean());
+
+  EXPECT_EQ(params["escaped"].asString(), "\"quoted\"\n\xc3\xa4");
+}
+
+TEST(TestJSONVariantParser, InvalidJsonKeepsData)
+{
+  CVariant variant("unchanged");
+  ASSERT_FALSE(CJSONVariantParser::Parse("{\"a\": [1, 2", variant));
+  ASSERT_FALSE(CJSONVariantParser::Parse("[{\"a\": }]", variant));
+  EXPECT_EQ(variant.asString(), "unchanged");
+}
+
+TEST(TestJSONVariantParser, RepositoryIndex)
+{
+  constexpr int ADDONS = 200;
+  const std::string json = CreateRepositoryIndex(ADDONS);
+
+  CVariant variant;
+  ASSERT_TRUE(CJSONVariantParser::Parse(json, variant));
+  ASSERT_TRUE(variant.isArray());
+  ASSERT_EQ(variant.size(), static_cast<unsigned int>(ADDONS));
+
+  const CVariant& last = variant[ADDONS - 1];
+  EXPECT_EQ(last["addonid"].asString(), "plugin.video.addon" + std::to_string(ADDONS - 1));
+  EXPECT_EQ(last["size"].asUnsignedInteger(), 4294967296ULL + ADDONS - 1);
+  EXPECT_EQ(last["dependencies"].size(), 2u);
+  EXPECT_TRUE(last["dependencies"][1]["optional"].asBoolean());
+  EXPECT_TRUE(last["fanart"].isNull());
+}
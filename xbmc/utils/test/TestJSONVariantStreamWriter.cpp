@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JSONVariantStreamWriter.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+CVariant CreateMovie(int id)
+{
+  CVariant movie;
+  movie["movieid"] = id;
+  movie["label"] = "Movie \"" + std::to_string(id) + "\"\n";
+  movie["rating"] = 7.5 + id % 3;
+  movie["playcount"] = static_cast<uint64_t>(id % 2);
+  movie["watched"] = id % 2 == 0;
+  movie["genre"] = CVariant(CVariant::VariantTypeArray);
+  if (id % 2 == 0)
+  {
+    movie["genre"].push_back("Drama");
+    movie["genre"].push_back("Comedy");
+  }
+  movie["art"] = CVariant(CVariant::VariantTypeObject);
+  if (id % 3 == 0)
+    movie["art"]["poster"] = "image://poster" + std::to_string(id);
+  movie["resume"] = CVariant();
+  return movie;
+}
+
+CVariant CreateResponse(int movies)
+{
+  CVariant response;
+  response["jsonrpc"] = "2.0";
+  response["id"] = 1;
+  response["result"]["movies"] = CVariant(CVariant::VariantTypeArray);
+  for (int i = 0; i < movies; ++i)
+    response["result"]["movies"].push_back(CreateMovie(i));
+  response["result"]["limits"]["start"] = 0;
+  response["result"]["limits"]["end"] = movies;
+  response["result"]["limits"]["total"] = movies;
+  return response;
+}
+
+std::string ReadChunked(const CVariant& value, bool compact, size_t chunkSize)
+{
+  CJSONVariantStreamWriter writer(value, compact);
+  std::string result;
+  std::string buffer(chunkSize, '\0');
+  size_t length;
+  while ((length = writer.Read(&buffer[0], buffer.size())) > 0)
+    result.append(buffer, 0, length);
+
+  EXPECT_FALSE(writer.HasFailed());
+  EXPECT_TRUE(writer.IsDone());
+  return result;
+}
+} // unnamed namespace
+
+TEST(TestJSONVariantStreamWriter, Scalars)
+{
+  for (const CVariant& value :
+       {CVariant(), CVariant(true), CVariant(static_cast<int64_t>(-4294967296LL)),
+        CVariant(static_cast<uint64_t>(1)), CVariant(0.5), CVariant("abc")})
+  {
+    std::string expected;
+    ASSERT_TRUE(CJSONVariantWriter::Write(value, expected, true));
+    EXPECT_EQ(ReadChunked(value, true, 1), expected);
+  }
+}
+
+TEST(TestJSONVariantStreamWriter, EmptyContainers)
+{
+  CVariant value;
+  value["array"] = CVariant(CVariant::VariantTypeArray);
+  value["object"] = CVariant(CVariant::VariantTypeObject);
+
+  for (bool compact : {true, false})
+  {
+    std::string expected;
+    ASSERT_TRUE(CJSONVariantWriter::Write(value, expected, compact));
+    EXPECT_EQ(ReadChunked(value, compact, 1024), expected);
+  }
+}
+
+TEST(TestJSONVariantStreamWriter, SameAsWriter)
+{
+  const CVariant response = CreateResponse(20);
+
+  for (bool compact : {true, false})
+  {
+    std::string expected;
+    ASSERT_TRUE(CJSONVariantWriter::Write(response, expected, compact));
+
+    for (size_t chunkSize : {1, 7, 64, 4096})
+      EXPECT_EQ(ReadChunked(response, compact, chunkSize), expected);
+
+    std::string all;
+    CJSONVariantStreamWriter writer(response, compact);
+    ASSERT_TRUE(writer.ReadAll(all));
+    EXPECT_EQ(all, expected);
+  }
+}
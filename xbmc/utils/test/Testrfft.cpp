@@ -8,7 +8,11 @@
 
 #include "utils/rfft.h"
 
+#include <random>
+#include <vector>
+
 #include <gtest/gtest.h>
+#include <kissfft/kiss_fftr.h>
 
 #if defined(TARGET_WINDOWS) && !defined(_USE_MATH_DEFINES)
 #define _USE_MATH_DEFINES
@@ -16,6 +20,58 @@
 
 #include <math.h>
 
+namespace
+{
+std::vector<float> CreateNoise(size_t size)
+{
+  std::mt19937 mt(42);
+  std::uniform_real_distribution<float> sample(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (float& value : data)
+    value = sample(mt);
+  return data;
+}
+
+// one real FFT per channel, as RFFT did before packing both channels into one transform
+class CSeparateRFFT
+{
+public:
+  CSeparateRFFT(size_t size, bool windowed)
+    : m_size(size), m_windowed(windowed), m_cfg(kiss_fftr_alloc(size, 0, nullptr, nullptr))
+  {
+  }
+  ~CSeparateRFFT() { KISS_FFT_FREE(m_cfg); }
+
+  void calc(const float* input, float* output)
+  {
+    std::vector<kiss_fft_scalar> linput(m_size), rinput(m_size);
+    std::vector<kiss_fft_cpx> loutput(m_size), routput(m_size);
+    for (size_t i = 0; i < m_size; ++i)
+    {
+      const float window =
+          m_windowed ? 0.5f * (1.0f - cos(2.0f * static_cast<float>(M_PI) * i / (m_size - 1)))
+                     : 1.0f;
+      linput[i] = input[2 * i] * window;
+      rinput[i] = input[2 * i + 1] * window;
+    }
+
+    kiss_fftr(m_cfg, linput.data(), loutput.data());
+    kiss_fftr(m_cfg, rinput.data(), routput.data());
+
+    const double scale = 2.0 / m_size * (m_windowed ? sqrt(8.0 / 3.0) : 1.0);
+    for (size_t i = 0; i < m_size / 2; ++i)
+    {
+      output[2 * i] = sqrt(loutput[i].r * loutput[i].r + loutput[i].i * loutput[i].i) * scale;
+      output[2 * i + 1] = sqrt(routput[i].r * routput[i].r + routput[i].i * routput[i].i) * scale;
+    }
+  }
+
+private:
+  size_t m_size;
+  bool m_windowed;
+  kiss_fftr_cfg m_cfg;
+};
+} // unnamed namespace
 
 TEST(TestRFFT, SimpleSignal)
 {
@@ -39,3 +95,21 @@ TEST(TestRFFT, SimpleSignal)
     EXPECT_NEAR(output[2*i+1], ((i==freq2[0]||i==freq2[1])?1.0:0.0), 1e-7);
   }
 }
+
+TEST(TestRFFT, MatchesSeparateTransforms)
+{
+  const size_t size = 512;
+  const std::vector<float> input = CreateNoise(2 * size);
+  for (bool windowed : {false, true})
+  {
+    RFFT transform(size, windowed);
+    CSeparateRFFT reference(size, windowed);
+    std::vector<float> output(size), expected(size);
+
+    transform.calc(input.data(), output.data());
+    reference.calc(input.data(), expected.data());
+
+    for (size_t i = 0; i < size; ++i)
+      EXPECT_NEAR(expected[i], output[i], 1e-5) << "bin " << i / 2 << " windowed " << windowed;
+  }
+}
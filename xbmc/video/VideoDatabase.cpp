@@ -70,6 +70,27 @@ using namespace ADDON;
 using namespace KODI::MESSAGING;
 using namespace KODI::GUILIB;
 
+namespace
+{
+std::string VideoField(int field)
+{
+  return StringUtils::Format("c{:02}", field);
+}
+
+const CDatabase::FullTextIndex MOVIE_FULLTEXT_INDEX = {
+    "ftMovie",
+    "movie",
+    "idMovie",
+    {VideoField(VIDEODB_ID_TITLE), VideoField(VIDEODB_ID_ORIGINALTITLE)},
+    {}};
+const CDatabase::FullTextIndex TVSHOW_FULLTEXT_INDEX = {
+    "ftTvShow", "tvshow", "idShow", {VideoField(VIDEODB_ID_TV_TITLE)}, {}};
+const CDatabase::FullTextIndex EPISODE_FULLTEXT_INDEX = {
+    "ftEpisode", "episode", "idEpisode", {VideoField(VIDEODB_ID_EPISODE_TITLE)}, {}};
+const CDatabase::FullTextIndex MUSICVIDEO_FULLTEXT_INDEX = {
+    "ftMusicVideo", "musicvideo", "idMVideo", {VideoField(VIDEODB_ID_MUSICVIDEO_TITLE)}, {}};
+} // unnamed namespace
+
 //********************************************************************************************************************************
 CVideoDatabase::CVideoDatabase(void) = default;
 
@@ -349,6 +370,12 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
 
+  // full text indices used by search, falls back to LIKE when unavailable
+  CreateFullTextIndex(MOVIE_FULLTEXT_INDEX);
+  CreateFullTextIndex(TVSHOW_FULLTEXT_INDEX);
+  CreateFullTextIndex(EPISODE_FULLTEXT_INDEX);
+  CreateFullTextIndex(MUSICVIDEO_FULLTEXT_INDEX);
+
   CreateViews();
 }
 
@@ -5906,7 +5933,7 @@ void CVideoDatabase::UpdateTables(int iVersion)
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 121;
+  return 122;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -8986,18 +9013,21 @@ void CVideoDatabase::GetMoviesByName(const std::string& strSearch, CFileItemList
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    if (!AppendFullTextFilter(filter, MOVIE_FULLTEXT_INDEX, "movie.idMovie", {{strSearch}}))
+      filter.AppendWhere(PrepareSQL("movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%'",
+                                    VIDEODB_ID_TITLE, strSearch.c_str(),
+                                    VIDEODB_ID_ORIGINALTITLE, strSearch.c_str()));
+
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
       strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d, path.strPath, movie.idSet FROM movie "
                           "INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON "
-                          "path.idPath=files.idPath "
-                          "WHERE movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%'",
-                          VIDEODB_ID_TITLE, VIDEODB_ID_TITLE, strSearch.c_str(),
-                          VIDEODB_ID_ORIGINALTITLE, strSearch.c_str());
+                          "path.idPath=files.idPath",
+                          VIDEODB_ID_TITLE);
     else
-      strSQL = PrepareSQL("SELECT movie.idMovie,movie.c%02d, movie.idSet FROM movie WHERE "
-                          "movie.c%02d like '%%%s%%' OR movie.c%02d LIKE '%%%s%%'",
-                          VIDEODB_ID_TITLE, VIDEODB_ID_TITLE, strSearch.c_str(),
-                          VIDEODB_ID_ORIGINALTITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT movie.idMovie,movie.c%02d, movie.idSet FROM movie",
+                          VIDEODB_ID_TITLE);
+    BuildSQL(strSQL, filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -9041,10 +9071,16 @@ void CVideoDatabase::GetTvShowsByName(const std::string& strSearch, CFileItemLis
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    if (!AppendFullTextFilter(filter, TVSHOW_FULLTEXT_INDEX, "tvshow.idShow", {{strSearch}}))
+      filter.AppendWhere(
+          PrepareSQL("tvshow.c%02d LIKE '%%%s%%'", VIDEODB_ID_TV_TITLE, strSearch.c_str()));
+
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT tvshow.idShow, tvshow.c%02d, path.strPath FROM tvshow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE tvshow.c%02d LIKE '%%%s%%'", VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT tvshow.idShow, tvshow.c%02d, path.strPath FROM tvshow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath", VIDEODB_ID_TV_TITLE);
     else
-      strSQL = PrepareSQL("select tvshow.idShow,tvshow.c%02d from tvshow where tvshow.c%02d like '%%%s%%'",VIDEODB_ID_TV_TITLE,VIDEODB_ID_TV_TITLE,strSearch.c_str());
+      strSQL = PrepareSQL("select tvshow.idShow,tvshow.c%02d from tvshow",VIDEODB_ID_TV_TITLE);
+    BuildSQL(strSQL, filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -9085,10 +9121,16 @@ void CVideoDatabase::GetEpisodesByName(const std::string& strSearch, CFileItemLi
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    if (!AppendFullTextFilter(filter, EPISODE_FULLTEXT_INDEX, "episode.idEpisode", {{strSearch}}))
+      filter.AppendWhere(PrepareSQL("episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE,
+                                    strSearch.c_str()));
+
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE);
     else
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE episode.c%02d like '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE);
+    BuildSQL(strSQL, filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -9132,10 +9174,17 @@ void CVideoDatabase::GetMusicVideosByName(const std::string& strSearch, CFileIte
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    if (!AppendFullTextFilter(filter, MUSICVIDEO_FULLTEXT_INDEX, "musicvideo.idMVideo",
+                              {{strSearch}}))
+      filter.AppendWhere(PrepareSQL("musicvideo.c%02d LIKE '%%%s%%'",
+                                    VIDEODB_ID_MUSICVIDEO_TITLE, strSearch.c_str()));
+
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE musicvideo.c%02d LIKE '%%%s%%'", VIDEODB_ID_MUSICVIDEO_TITLE, VIDEODB_ID_MUSICVIDEO_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath", VIDEODB_ID_MUSICVIDEO_TITLE);
     else
-      strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d from musicvideo where musicvideo.c%02d like '%%%s%%'",VIDEODB_ID_MUSICVIDEO_TITLE,VIDEODB_ID_MUSICVIDEO_TITLE,strSearch.c_str());
+      strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d from musicvideo",VIDEODB_ID_MUSICVIDEO_TITLE);
+    BuildSQL(strSQL, filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
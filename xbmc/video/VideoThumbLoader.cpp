@@ -106,10 +106,11 @@ bool CThumbExtractor::DoWork()
     // construct the thumb cache file
     CTextureDetails details;
     details.file = CTextureCache::GetCacheFile(m_target) + ".jpg";
+    const uint64_t replacedSize = CTextureCache::GetCachedFileSize(details.file);
     result = CDVDFileInfo::ExtractThumb(m_item, details, m_fillStreamDetails ? &m_item.GetVideoInfoTag()->m_streamDetails : nullptr, m_pos);
     if (result)
     {
-      CServiceBroker::GetTextureCache()->AddCachedTexture(m_target, details);
+      CServiceBroker::GetTextureCache()->AddCachedTexture(m_target, details, replacedSize);
       m_item.SetProperty("HasAutoThumb", true);
       m_item.SetProperty("AutoThumbImage", m_target);
       m_item.SetArt("thumb", m_target);
@@ -177,8 +178,64 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
-CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+CThumbBatchExtractor::CThumbBatchExtractor(const CFileItem& item,
+                                           std::vector<Target> targets,
+                                           ThumbBatchExtractFunc extract /* = nullptr */)
+  : m_item(item), m_targets(std::move(targets)), m_extract(std::move(extract))
+{
+  if (!m_extract)
+    m_extract = [](const CFileItem& item, std::vector<CDVDFileInfo::ThumbRequest>& requests,
+                   const std::function<bool(size_t)>& progress) {
+      return CDVDFileInfo::ExtractThumbs(item, requests, nullptr, progress);
+    };
+}
+
+CThumbBatchExtractor::~CThumbBatchExtractor() = default;
+
+bool CThumbBatchExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CThumbBatchExtractor* jobExtract = dynamic_cast<const CThumbBatchExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath() &&
+        jobExtract->m_targets.size() == m_targets.size() &&
+        std::equal(m_targets.begin(), m_targets.end(), jobExtract->m_targets.begin(),
+                   [](const Target& a, const Target& b) { return a.url == b.url; }))
+      return true;
+  }
+  return false;
+}
+
+bool CThumbBatchExtractor::DoWork()
+{
+  std::vector<CTextureDetails> details(m_targets.size());
+  std::vector<uint64_t> replacedSizes(m_targets.size());
+  std::vector<CDVDFileInfo::ThumbRequest> requests;
+  requests.reserve(m_targets.size());
+  for (size_t i = 0; i < m_targets.size(); i++)
+  {
+    details[i].file = CTextureCache::GetCacheFile(m_targets[i].url) + ".jpg";
+    replacedSizes[i] = CTextureCache::GetCachedFileSize(details[i].file);
+    requests.push_back({m_targets[i].pos, &details[i]});
+  }
+
+  CLog::Log(LOGDEBUG, "{} - trying to extract {} thumbs from video file {}", __FUNCTION__,
+            m_targets.size(), CURL::GetRedacted(m_item.GetPath()));
+
+  return m_extract(m_item, requests, [&](size_t idx) {
+    if (requests[idx].extracted)
+    {
+      CServiceBroker::GetTextureCache()->AddCachedTexture(m_targets[idx].url, details[idx],
+                                                          replacedSizes[idx]);
+      m_targets[idx].extracted = true;
+    }
+    return !ShouldCancel(idx + 1, m_targets.size());
+  });
+}
+
+CVideoThumbLoader::CVideoThumbLoader()
+  : CThumbLoader(),
+    CJobQueue(true, CDVDFileInfo::GetMaxConcurrentExtractions(), CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
 }
@@ -368,12 +425,14 @@ bool CVideoThumbLoader::LoadItemCached(CFileItem* pItem)
     std::vector<std::string> artTypes = GetArtTypes(pItem->HasVideoInfoTag() ? pItem->GetVideoInfoTag()->m_type : "");
     if (find(artTypes.begin(), artTypes.end(), "thumb") == artTypes.end())
       artTypes.emplace_back("thumb"); // always look for "thumb" art for files
-    for (std::vector<std::string>::const_iterator i = artTypes.begin(); i != artTypes.end(); ++i)
+
+    // look up all types at once instead of one query per type
+    const std::map<std::string, std::string> cachedArt = GetCachedImages(*pItem);
+    for (const std::string& type : artTypes)
     {
-      std::string type = *i;
-      std::string art = GetCachedImage(*pItem, type);
-      if (!art.empty())
-        artwork.insert(std::make_pair(type, art));
+      const auto art = cachedArt.find(type);
+      if (art != cachedArt.end() && !art->second.empty())
+        artwork.insert(*art);
     }
     pItem->AppendArt(artwork);
   }
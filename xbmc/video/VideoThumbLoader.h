@@ -10,8 +10,10 @@
 
 #include "FileItem.h"
 #include "ThumbLoader.h"
+#include "cores/VideoPlayer/DVDFileInfo.h"
 #include "utils/JobManager.h"
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -56,6 +58,56 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
+/*!
+ \brief Extracts the stills of a batch from a video file, see CDVDFileInfo::ExtractThumbs
+ */
+using ThumbBatchExtractFunc =
+    std::function<bool(const CFileItem& item,
+                       std::vector<CDVDFileInfo::ThumbRequest>& requests,
+                       const std::function<bool(size_t)>& progress)>;
+
+/*!
+ \ingroup thumbs,jobs
+ \brief Extracts several stills from one video file, e.g. chapter thumbs
+
+ The file is opened and the decoder set up only once for all targets. Progress is reported
+ through IJobCallback::OnJobProgress after each target, progress - 1 being its index.
+
+ \sa CThumbExtractor and CJob
+ */
+class CThumbBatchExtractor : public CJob
+{
+public:
+  struct Target
+  {
+    std::string url; ///< thumbpath
+    int64_t pos; ///< position in ms to extract the thumb from
+    int chapter = 0; ///< chapter the thumb belongs to, if any
+    bool extracted = false;
+  };
+
+  /*!
+   \param extract extracts the stills, CDVDFileInfo::ExtractThumbs if not given
+   */
+  CThumbBatchExtractor(const CFileItem& item,
+                       std::vector<Target> targets,
+                       ThumbBatchExtractFunc extract = nullptr);
+  ~CThumbBatchExtractor() override;
+
+  bool DoWork() override;
+
+  const char* GetType() const override { return kJobTypeMediaFlags; }
+
+  bool operator==(const CJob* job) const override;
+
+  const std::vector<Target>& GetTargets() const { return m_targets; }
+
+private:
+  CFileItem m_item;
+  std::vector<Target> m_targets;
+  ThumbBatchExtractFunc m_extract;
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
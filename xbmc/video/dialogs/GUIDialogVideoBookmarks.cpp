@@ -266,7 +266,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
-  // add chapters if around
+  // add chapters if around, missing chapter thumbs are extracted in one go
+  std::vector<CThumbBatchExtractor::Target> chapterThumbs;
   const auto& components = CServiceBroker::GetAppComponents();
   const auto appPlayer = components.GetComponent<CApplicationPlayer>();
   for (int i = 1; i <= appPlayer->GetChapterCount(); ++i)
@@ -292,11 +293,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
-      m_jobsStarted++;
+      chapterThumbs.push_back({chapterPath, pos * 1000, i});
+      m_jobsStarted = i;
     }
 
     item->SetProperty("chapter", i);
@@ -305,6 +303,12 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  if (!chapterThumbs.empty())
+  {
+    CFileItem item(m_filePath, false);
+    AddJob(new CThumbBatchExtractor(item, std::move(chapterThumbs)));
+  }
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -479,7 +483,6 @@ void CGUIDialogVideoBookmarks::OnWindowLoaded()
   m_viewControl.SetParentWindow(GetID());
   m_viewControl.AddView(GetControl(CONTROL_THUMBS));
   m_jobsStarted = 0;
-  m_mapJobsChapter.clear();
   m_vecItems->Clear();
 }
 
@@ -487,7 +490,6 @@ void CGUIDialogVideoBookmarks::OnWindowUnload()
 {
   //stop running thumb extraction jobs
   CancelJobs();
-  m_mapJobsChapter.clear();
   m_vecItems->Clear();
   CGUIDialog::OnWindowUnload();
   m_viewControl.Reset();
@@ -572,19 +574,22 @@ bool CGUIDialogVideoBookmarks::OnAddEpisodeBookmark()
   return bReturn;
 }
 
-void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
-                                             bool success, CJob* job)
+void CGUIDialogVideoBookmarks::OnJobProgress(unsigned int jobID,
+                                             unsigned int progress,
+                                             unsigned int total,
+                                             const CJob* job)
 {
-  if (success && IsActive())
+  const CThumbBatchExtractor* extractor = dynamic_cast<const CThumbBatchExtractor*>(job);
+  if (!extractor || !IsActive())
+    return;
+
+  // refresh each chapter as soon as its thumb is ready instead of waiting for the whole batch.
+  // the targets are only written by the job itself, which is reporting this progress
+  const auto& targets = extractor->GetTargets();
+  const unsigned int idx = progress - 1;
+  if (idx < targets.size() && targets[idx].extracted)
   {
-    MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
-    if (iter != m_mapJobsChapter.end())
-    {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
-      CServiceBroker::GetAppMessenger()->SendGUIMessage(m);
-      m_mapJobsChapter.erase(iter);
-    }
+    CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, targets[idx].chapter);
+    CServiceBroker::GetAppMessenger()->SendGUIMessage(m);
   }
-  CJobQueue::OnJobComplete(jobID, success, job);
 }
@@ -13,12 +13,12 @@
 #include "video/VideoDatabase.h"
 #include "view/GUIViewControl.h"
 
+#include <vector>
+
 class CFileItemList;
 
 class CGUIDialogVideoBookmarks : public CGUIDialog, public CJobQueue
 {
-  typedef std::map<CJob*, unsigned int> MAPJOBSCHAPS;
-
 public:
   CGUIDialogVideoBookmarks(void);
   ~CGUIDialogVideoBookmarks(void) override;
@@ -60,7 +60,10 @@ protected:
   void OnPopupMenu(int item);
   CGUIControl *GetFirstFocusableControl(int id) override;
 
-  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+  void OnJobProgress(unsigned int jobID,
+                     unsigned int progress,
+                     unsigned int total,
+                     const CJob* job) override;
 
   CFileItemList* m_vecItems;
   CGUIViewControl m_viewControl;
@@ -72,5 +75,4 @@ private:
   int m_jobsStarted;
   std::string m_filePath;
   CCriticalSection m_refreshSection;
-  MAPJOBSCHAPS m_mapJobsChapter;
 };
@@ -10,7 +10,7 @@
 
 #include "FileItem.h"
 #include "ServiceBroker.h"
-#include "TextureDatabase.h"
+#include "TextureCache.h"
 #include "URL.h"
 #include "addons/Scraper.h"
 #include "dialogs/GUIDialogSelect.h"
@@ -32,7 +32,9 @@
 #include "video/tags/VideoInfoTagLoaderFactory.h"
 #include "video/tags/VideoTagLoaderPlugin.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace KODI::MESSAGING;
 using namespace VIDEO;
@@ -252,14 +254,10 @@ bool CVideoLibraryRefreshingJob::Work(CVideoDatabase &db)
     }
 
     // before we start downloading all the necessary information cleanup any existing artwork and hashes
-    CTextureDatabase textureDb;
-    if (textureDb.Open())
-    {
-      for (const auto& artwork : m_item->GetArt())
-        textureDb.InvalidateCachedTexture(artwork.second);
-
-      textureDb.Close();
-    }
+    std::vector<std::string> images;
+    for (const auto& artwork : m_item->GetArt())
+      images.push_back(artwork.second);
+    CServiceBroker::GetTextureCache()->InvalidateCachedImages(images);
     m_item->ClearArt();
 
     // put together the list of items to refresh
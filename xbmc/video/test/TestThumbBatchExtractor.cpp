@@ -0,0 +1,221 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "TextureCache.h"
+#include "test/MtTestUtils.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "video/VideoThumbLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+/*!
+ * \brief Extracts stills without decoding anything, keeping track of the extractions running at
+ * the same time. The first extractions wait for each other to prove that they run in parallel.
+ */
+class CTestExtraction
+{
+public:
+  bool Extract(const CFileItem& item,
+               std::vector<CDVDFileInfo::ThumbRequest>& requests,
+               const std::function<bool(size_t)>& progress)
+  {
+    const int running = ++m_running;
+    int peak = m_peak;
+    while (running > peak && !m_peak.compare_exchange_weak(peak, running))
+    {
+    }
+    ConditionPoll::poll(2000, [this]() { return m_peak >= m_overlap; });
+
+    bool result = false;
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+      m_processed++;
+      if (requests[i].pos != m_failPos)
+      {
+        requests[i].details->width = 320;
+        requests[i].details->height = 180;
+        requests[i].extracted = true;
+        result = true;
+      }
+      if (!progress(i))
+        break;
+    }
+
+    m_running--;
+    m_finished++;
+    return result;
+  }
+
+  ThumbBatchExtractFunc GetFunc()
+  {
+    return [this](const CFileItem& item, std::vector<CDVDFileInfo::ThumbRequest>& requests,
+                  const std::function<bool(size_t)>& progress) {
+      return Extract(item, requests, progress);
+    };
+  }
+
+  void Fail(int64_t pos) { m_failPos = pos; }
+  void Overlap(int extractions) { m_overlap = extractions; }
+
+  std::atomic<int> m_processed{0};
+  std::atomic<int> m_finished{0};
+  std::atomic<int> m_peak{0};
+
+private:
+  std::atomic<int> m_running{0};
+  int m_overlap = 1;
+  int64_t m_failPos = -1;
+};
+
+//! refreshes the chapters like the video bookmarks dialog does
+class CTestChapterQueue : public CJobQueue
+{
+public:
+  void OnJobProgress(unsigned int jobID,
+                     unsigned int progress,
+                     unsigned int total,
+                     const CJob* job) override
+  {
+    const auto& targets = static_cast<const CThumbBatchExtractor*>(job)->GetTargets();
+    EXPECT_EQ(targets.size(), total);
+
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_progress.push_back(progress);
+    if (targets[progress - 1].extracted)
+      m_refreshed.push_back(targets[progress - 1].chapter);
+
+    if (m_cancel)
+      CancelJobs();
+  }
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override
+  {
+    CJobQueue::OnJobComplete(jobID, success, job);
+    m_complete.Set();
+  }
+
+  std::vector<unsigned int> GetProgress()
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    return m_progress;
+  }
+
+  std::vector<int> GetRefreshed()
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    return m_refreshed;
+  }
+
+  bool m_cancel = false;
+  CEvent m_complete;
+
+private:
+  CCriticalSection m_critSection;
+  std::vector<unsigned int> m_progress;
+  std::vector<int> m_refreshed;
+};
+
+std::vector<CThumbBatchExtractor::Target> CreateChapters(const std::string& file, int count)
+{
+  std::vector<CThumbBatchExtractor::Target> targets;
+  for (int chapter = 1; chapter <= count; chapter++)
+    targets.push_back(
+        {"chapter://" + file + "/" + std::to_string(chapter), chapter * 60000, chapter});
+  return targets;
+}
+} // unnamed namespace
+
+class TestThumbBatchExtractor : public testing::Test
+{
+protected:
+  TestThumbBatchExtractor()
+  {
+    CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+    CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo());
+    // not initialized, the extracted stills are not stored
+    CServiceBroker::RegisterTextureCache(std::make_shared<CTextureCache>());
+  }
+
+  ~TestThumbBatchExtractor() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::UnregisterTextureCache();
+    CServiceBroker::UnregisterCPUInfo();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  CTestExtraction m_extraction;
+};
+
+TEST_F(TestThumbBatchExtractor, Chapters)
+{
+  CTestChapterQueue queue;
+  m_extraction.Fail(2 * 60000);
+  queue.AddJob(new CThumbBatchExtractor(CFileItem("/movie.mkv", false),
+                                        CreateChapters("/movie.mkv", 4), m_extraction.GetFunc()));
+  ASSERT_TRUE(queue.m_complete.Wait(5000ms));
+
+  // one file for all chapters, each of them refreshed as soon as its still is ready
+  EXPECT_EQ(1, m_extraction.m_finished);
+  EXPECT_EQ(std::vector<unsigned int>({1, 2, 3, 4}), queue.GetProgress());
+  EXPECT_EQ(std::vector<int>({1, 3, 4}), queue.GetRefreshed());
+}
+
+TEST_F(TestThumbBatchExtractor, Cancel)
+{
+  // e.g. the dialog is closed, the chapter being extracted is the last one
+  CTestChapterQueue queue;
+  queue.m_cancel = true;
+  queue.AddJob(new CThumbBatchExtractor(CFileItem("/movie.mkv", false),
+                                        CreateChapters("/movie.mkv", 10), m_extraction.GetFunc()));
+
+  ASSERT_TRUE(ConditionPoll::poll([this]() { return m_extraction.m_finished == 1; }));
+  EXPECT_EQ(std::vector<unsigned int>({1}), queue.GetProgress());
+  EXPECT_EQ(2, m_extraction.m_processed);
+}
+
+TEST_F(TestThumbBatchExtractor, Parallel)
+{
+  // configured like the thumb loader, the job manager runs two pausable jobs at most
+  const int jobsAtOnce = static_cast<int>(CDVDFileInfo::GetMaxConcurrentExtractions());
+  CJobQueue queue(true, jobsAtOnce, CJob::PRIORITY_LOW_PAUSABLE);
+  m_extraction.Overlap(std::min(jobsAtOnce, 2));
+
+  constexpr int FILES = 8;
+  for (int i = 0; i < FILES; i++)
+  {
+    const std::string file = "/movie" + std::to_string(i) + ".mkv";
+    queue.AddJob(new CThumbBatchExtractor(CFileItem(file, false), CreateChapters(file, 1),
+                                          m_extraction.GetFunc()));
+
+    // the job manager adds workers for jobs submitted while all of them are busy
+    if (i == 0)
+      ASSERT_TRUE(ConditionPoll::poll([this]() { return m_extraction.m_peak == 1; }));
+  }
+
+  ASSERT_TRUE(ConditionPoll::poll([this]() { return m_extraction.m_finished == FILES; }));
+  EXPECT_EQ(FILES, m_extraction.m_processed);
+  EXPECT_GE(m_extraction.m_peak, std::min(jobsAtOnce, 2));
+  EXPECT_LE(m_extraction.m_peak, jobsAtOnce);
+}
@@ -86,6 +86,10 @@ protected:
   bool Update(const std::string &strDirectory, bool updateFilterPath = true) override;
   bool GetDirectory(const std::string &strDirectory, CFileItemList &items) override;
   void OnItemLoaded(CFileItem* pItem) override {};
+  void OnViewportChanged(const std::vector<CFileItemPtr>& items) override
+  {
+    m_thumbLoader.SetPriorityItems(items);
+  }
   void GetGroupedItems(CFileItemList &items) override;
 
   bool CheckFilterAdvanced(CFileItemList &items) const override;
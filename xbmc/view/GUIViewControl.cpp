@@ -11,6 +11,7 @@
 #include "FileItem.h"
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
+#include "guilib/GUIBaseContainer.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "guilib/IGUIContainer.h"
@@ -247,6 +248,20 @@ int CGUIViewControl::GetCurrentControl() const
   return m_visibleViews[m_currentView]->GetID();
 }
 
+bool CGUIViewControl::GetViewport(int& first, int& count, int& direction) const
+{
+  if (m_currentView < 0 || m_currentView >= (int)m_visibleViews.size())
+    return false;
+
+  const CGUIBaseContainer* container =
+      dynamic_cast<const CGUIBaseContainer*>(m_visibleViews[m_currentView]);
+  if (!container)
+    return false;
+
+  container->GetViewport(first, count, direction);
+  return true;
+}
+
 // returns the number-th view's viewmode (type and id)
 int CGUIViewControl::GetViewModeNumber(int number) const
 {
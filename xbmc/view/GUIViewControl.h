@@ -46,6 +46,12 @@ public:
 
   int GetCurrentControl() const;
 
+  /*! \brief Get the items shown by the current view
+   \sa CGUIBaseContainer::GetViewport
+   \return false if there is no current view, true otherwise
+   */
+  bool GetViewport(int& first, int& count, int& direction) const;
+
   void Clear();
 
 protected:
@@ -61,6 +61,7 @@
 #include "utils/log.h"
 #include "view/GUIViewState.h"
 
+#include <algorithm>
 #include <inttypes.h>
 
 #define CONTROL_BTNVIEWASICONS       2
@@ -157,6 +158,50 @@ bool CGUIMediaWindow::Load(TiXmlElement *pRootElement)
   return true;
 }
 
+void CGUIMediaWindow::FrameMove()
+{
+  UpdateViewport();
+  CGUIWindow::FrameMove();
+}
+
+void CGUIMediaWindow::UpdateViewport()
+{
+  int first, count, direction;
+  if (!m_viewControl.GetViewport(first, count, direction) || count <= 0 ||
+      first >= m_vecItems->Size())
+    return;
+
+  // keep prefetching in the direction we last scrolled to
+  if (direction == 0)
+    direction = m_viewportDirection;
+
+  const CFileItem* item = m_vecItems->Get(first).get();
+  if (first == m_viewportFirst && count == m_viewportCount && direction == m_viewportDirection &&
+      item == m_viewportItem)
+    return;
+
+  m_viewportFirst = first;
+  m_viewportCount = count;
+  m_viewportDirection = direction;
+  m_viewportItem = item;
+
+  std::vector<CFileItemPtr> items;
+  items.reserve(2 * count);
+  for (int i = first; i < std::min(first + count, m_vecItems->Size()); i++)
+    items.push_back(m_vecItems->Get(i));
+
+  // the next page, starting with the items closest to the ones shown
+  for (int i = 1; i <= count; i++)
+  {
+    const int next = direction > 0 ? first + count - 1 + i : first - i;
+    if (next < 0 || next >= m_vecItems->Size())
+      break;
+    items.push_back(m_vecItems->Get(next));
+  }
+
+  OnViewportChanged(items);
+}
+
 void CGUIMediaWindow::OnWindowLoaded()
 {
   SendMessage(GUI_MSG_SET_TYPE, CONTROL_BTN_FILTER, CGUIEditControl::INPUT_TYPE_FILTER);
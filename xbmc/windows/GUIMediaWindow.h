@@ -16,6 +16,7 @@
 #include "view/GUIViewControl.h"
 
 #include <atomic>
+#include <vector>
 
 class CFileItemList;
 class CGUIViewState;
@@ -37,6 +38,7 @@ public:
   bool OnMessage(CGUIMessage& message) override;
 
   // specializations of CGUIWindow
+  void FrameMove() override;
   void OnWindowLoaded() override;
   void OnWindowUnload() override;
   void OnInitWindow() override;
@@ -177,6 +179,13 @@ protected:
 
   bool ProcessRenderLoop(bool renderOnly);
 
+  /*! \brief Called when different items are shown
+   Allows to load the items shown and the ones about to be shown before all others.
+   \param items the items shown, followed by the next page in scroll direction
+   \sa CBackgroundInfoLoader::SetPriorityItems
+   */
+  virtual void OnViewportChanged(const std::vector<CFileItemPtr>& items) {}
+
   XFILE::CVirtualDirectory m_rootDir;
   CGUIViewControl m_viewControl;
 
@@ -224,4 +233,13 @@ protected:
    */
   std::string m_strFilterPath;
   bool m_backgroundLoad = false;
+
+private:
+  void UpdateViewport();
+
+  // the view's state when OnViewportChanged was last called
+  int m_viewportFirst = -1;
+  int m_viewportCount = 0;
+  int m_viewportDirection = 1;
+  const CFileItem* m_viewportItem = nullptr;
 };
@@ -17,8 +17,10 @@
 #include "guilib/GUIControlFactory.h"
 #include "guilib/GUIControlProfiler.h"
 #include "guilib/GUIFontManager.h"
+#include "guilib/GUIFontTTF.h"
 #include "guilib/GUITextLayout.h"
 #include "guilib/GUIWindowManager.h"
+#include "guilib/TextureManager.h"
 #include "input/WindowTranslator.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -129,6 +131,19 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                    .GetFPS(),
                                strCores, ucAppName, dCPU, profiling);
 #endif
+
+    const CGUITextureManager::Statistics textures =
+        CServiceBroker::GetGUI()->GetTextureManager().GetStatistics();
+    info += StringUtils::Format("\nGUI: {} textures ({} images in {} atlases) {} KB - {} binds, "
+                                "{} texture switches",
+                                textures.textures, textures.atlasImages, textures.atlases,
+                                textures.memory / 1024, textures.binds, textures.switches);
+
+    const CGUIFontCacheBudget::Statistics fonts = CGUIFontCacheBudget::GetInstance().GetStatistics();
+    info += StringUtils::Format("\nFONTS: {} cached texts {}/{} KB - {} hits, {} misses, "
+                                "{} evictions",
+                                fonts.entries, fonts.size / 1024, fonts.budget / 1024, fonts.hits,
+                                fonts.misses, fonts.evictions);
   }
 
   // render the skin debug info